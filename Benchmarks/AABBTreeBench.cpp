@@ -0,0 +1,66 @@
+// Steps a scene of moving boxes through AABBTree (move every box, then find
+// all overlapping pairs) and compares that with testing every pair.
+//
+// Usage: SWAN-AABBTree-Bench [box count]
+
+#include "Bench.hpp"
+#include "Physics/AABBTree.hpp"
+
+#include <cmath>  // For std::cbrt()
+#include <random> // For std::mt19937
+#include <vector> // For std::vector<T>
+
+using namespace SWAN;
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 10000);
+
+	// Roughly 1 unit boxes in a volume that gives a couple of contacts per box.
+	std::mt19937 rng(1337);
+	float extent = std::cbrt((float) count) * 4;
+	std::uniform_real_distribution<float> pos(-extent, extent), size(0.5f, 1.5f), vel(-0.05f, 0.05f);
+
+	std::vector<AABB> boxes(count);
+	std::vector<vec3> velocities(count);
+	for(int i = 0; i < count; i++) {
+		vec3 p(pos(rng), pos(rng), pos(rng));
+		boxes[i] = AABB(p, p + vec3(size(rng), size(rng), size(rng)));
+		velocities[i] = vec3(vel(rng), vel(rng), vel(rng));
+	}
+
+	AABBTree tree;
+	std::vector<AABBTree::ProxyID> proxies(count);
+	double buildNs = Bench::Time(1, [&](int) {
+		for(int i = 0; i < count; i++)
+			proxies[i] = tree.insert(boxes[i], i);
+	});
+
+	const int steps = 60;
+	std::vector<AABBTree::Pair> pairs;
+	int reinserted = 0;
+	double stepNs = Bench::Time(steps, [&](int) {
+		for(int i = 0; i < count; i++) {
+			boxes[i].min += velocities[i];
+			boxes[i].max += velocities[i];
+			reinserted += tree.move(proxies[i], boxes[i], velocities[i]);
+		}
+		tree.queryPairs(pairs);
+	});
+
+	int bruteCount = 0;
+	double bruteNs = Bench::Time(1, [&](int) {
+		for(int i = 0; i < count; i++)
+			for(int j = i + 1; j < count; j++)
+				bruteCount += boxes[i].Overlaps(boxes[j]);
+	});
+
+	std::printf("%d boxes, tree height %d\n", count, tree.getHeight());
+	std::printf("  %-40s %10.3f ms\n", "build (insert every box)", buildNs / 1e6);
+	std::printf("  %-40s %10.3f ms\n", "step (move + queryPairs)", stepNs / 1e6);
+	std::printf("  %-40s %10.3f ms  (x%.1f)\n", "all pairs", bruteNs / 1e6, bruteNs / stepNs);
+	std::printf("  %.1f%% of the moves reinserted, %zu candidate pairs for %d overlapping ones\n",
+	            100.0 * reinserted / ((double) count * steps), pairs.size(), bruteCount);
+
+	return 0;
+}
@@ -0,0 +1,53 @@
+#ifndef SWAN_BENCHMARKS_BENCH_HPP
+#define SWAN_BENCHMARKS_BENCH_HPP
+
+#include <chrono>   // For std::chrono::steady_clock
+#include <cstdio>   // For std::printf()
+#include <cstdlib>  // For std::atoi()
+
+// Tiny helpers shared by the benchmark executables.
+// None of them need a window or an OpenGL context.
+
+namespace Bench
+{
+	using Clock = std::chrono::steady_clock;
+
+	/// Keeps the optimizer from throwing away a computed value.
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+		asm volatile(""
+		             :
+		             : "r,m"(value)
+		             : "memory");
+	}
+
+	/// Runs func() the given number of times and returns the average time per call in nanoseconds.
+	template <typename Func>
+	double Time(int iterations, Func func)
+	{
+		auto start = Clock::now();
+		for(int i = 0; i < iterations; i++)
+			func(i);
+		auto end = Clock::now();
+
+		return std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+	}
+
+	/// Prints a single result line.
+	inline void Report(const char* name, double nsPerOp, double baselineNs = 0)
+	{
+		if(baselineNs > 0)
+			std::printf("%-40s %10.2f ns/op  (x%.2f)\n", name, nsPerOp, baselineNs / nsPerOp);
+		else
+			std::printf("%-40s %10.2f ns/op\n", name, nsPerOp);
+	}
+
+	/// Reads the iteration count from argv[1], if given.
+	inline int Iterations(int argc, char** argv, int def)
+	{
+		return argc > 1 ? std::atoi(argv[1]) : def;
+	}
+} // namespace Bench
+
+#endif
@@ -0,0 +1,66 @@
+// Compares the SIMD overlap kernels of ColliderStore with calling
+// FindIntersection(AABB, AABB) on every pair, in pair tests per second.
+//
+// Usage: SWAN-ColliderStore-Bench [box count]
+
+#include "Bench.hpp"
+#include "Physics/ColliderStore.hpp"
+
+#include <random> // For std::mt19937
+
+using namespace SWAN;
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 2000);
+	const double tests = (double) count * count;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-100, 100);
+	std::uniform_real_distribution<float> size(0.5f, 4);
+
+	Vector<AABB> boxes(count);
+	ColliderStore store;
+	for(int i = 0; i < count; i++) {
+		vec3 c(dist(rng), dist(rng), dist(rng));
+		vec3 h(size(rng), size(rng), size(rng));
+		boxes[i] = AABB(c - h, c + h);
+		store.insert(boxes[i], i);
+	}
+
+	// ---------------------------- One against all ---------------------------- //
+	int refHits = 0;
+	double refNs = Bench::Time(3, [&](int) {
+		for(const AABB& a : boxes)
+			for(const AABB& b : boxes)
+				refHits += FindIntersection(a, b).happened;
+	});
+
+	int hits = 0;
+	Vector<ColliderStore::ProxyID> found;
+	double storeNs = Bench::Time(3, [&](int) {
+		for(const AABB& a : boxes) {
+			store.query(a, found);
+			hits += found.size();
+		}
+	});
+
+	std::printf("%d boxes, %d overlaps with FindIntersection(), %d with ColliderStore::query()\n", count, refHits / 3, hits / 3);
+	std::printf("%-40s %10.2f M tests/s\n", "FindIntersection(AABB, AABB)", tests / refNs * 1e3);
+	std::printf("%-40s %10.2f M tests/s\n", "ColliderStore::query()", tests / storeNs * 1e3);
+	Bench::Report("FindIntersection(AABB, AABB), per test", refNs / tests);
+	Bench::Report("ColliderStore::query(), per test", storeNs / tests, refNs / tests);
+
+	// ---------------------------- Every pair ---------------------------- //
+	Vector<ColliderStore::Pair> pairs;
+	store.queryPairs(pairs);
+	double pairsNs = Bench::Time(10, [&](int) {
+		store.queryPairs(pairs);
+		Bench::DoNotOptimize(pairs.size());
+	});
+
+	std::printf("%zu pairs\n", pairs.size());
+	Bench::Report("ColliderStore::queryPairs()", pairsNs, refNs / 2);
+
+	return 0;
+}
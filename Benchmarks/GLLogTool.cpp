@@ -0,0 +1,115 @@
+// Reads GL command logs saved by GL::CommandLog::save(), like the ones SWAN-RenderSubmit-Bench writes.
+//
+//     dump   Prints every call in the log, then the number of calls to each GL function.
+//     diff   Prints the first call in which two logs differ, with a few calls around it, and
+//            how the number of calls to each GL function changed. Exits with 1 if they differ.
+//
+// Usage: SWAN-GLLog dump <log>
+//        SWAN-GLLog diff <before> <after>
+
+#include "OpenGL/Recorder.hpp"
+
+#include <cstdio>  // For std::printf()
+#include <cstring> // For std::strcmp()
+#include <string>  // For std::string
+#include <vector>  // For std::vector<T>
+
+using namespace SWAN;
+
+namespace
+{
+	bool Load(GL::CommandLog& log, const char* path)
+	{
+		if(log.load(path))
+			return true;
+		std::printf("Couldn't read the GL log %s\n", path);
+		return false;
+	}
+
+	std::vector<std::string> Describe(const GL::CommandLog& log)
+	{
+		std::vector<std::string> lines;
+		log.replay([&](const GL::CommandLog::Entry& e) { lines.push_back(GL::CommandLog::Describe(e)); });
+		return lines;
+	}
+
+	void PrintTotals(const GL::CommandLog& log)
+	{
+		std::printf("%lu calls, %lu draw calls, %llu bytes of data\n",
+		            (unsigned long) log.size(), log.getDrawCalls(), log.getDataBytes());
+	}
+
+	int Dump(const char* path)
+	{
+		GL::CommandLog log;
+		if(!Load(log, path))
+			return 2;
+
+		std::vector<std::string> lines = Describe(log);
+		for(std::size_t i = 0; i < lines.size(); i++)
+			std::printf("%6zu  %s\n", i, lines[i].c_str());
+
+		std::printf("\n");
+		for(unsigned c = 0; c < (unsigned) GL::Command::Count; c++)
+			if(log.count((GL::Command) c))
+				std::printf("%-28s %8lu\n", GL::GetCommandName((GL::Command) c), log.count((GL::Command) c));
+		PrintTotals(log);
+		return 0;
+	}
+
+	int Diff(const char* pathA, const char* pathB)
+	{
+		GL::CommandLog a, b;
+		if(!Load(a, pathA) || !Load(b, pathB))
+			return 2;
+
+		long diff = GL::FindFirstDifference(a, b);
+		if(diff < 0) {
+			std::printf("The logs are the same.\n");
+			PrintTotals(a);
+			return 0;
+		}
+
+		const long context = 3;
+		std::vector<std::string> linesA = Describe(a), linesB = Describe(b);
+		std::printf("First difference at call %ld:\n", diff);
+		for(long i = diff > context ? diff - context : 0; i <= diff + context; i++) {
+			bool inA = i < (long) linesA.size(), inB = i < (long) linesB.size();
+			if(!inA && !inB)
+				break;
+			if(inA && inB && linesA[i] == linesB[i])
+				std::printf("  %6ld  %s\n", i, linesA[i].c_str());
+			else {
+				if(inA)
+					std::printf("- %6ld  %s\n", i, linesA[i].c_str());
+				if(inB)
+					std::printf("+ %6ld  %s\n", i, linesB[i].c_str());
+			}
+		}
+
+		std::printf("\n%-28s %8s %8s %8s\n", "function", "before", "after", "change");
+		for(unsigned c = 0; c < (unsigned) GL::Command::Count; c++) {
+			unsigned long before = a.count((GL::Command) c), after = b.count((GL::Command) c);
+			if(before != after)
+				std::printf("%-28s %8lu %8lu %+8ld\n", GL::GetCommandName((GL::Command) c), before, after, (long) after - (long) before);
+		}
+
+		std::printf("\nbefore: ");
+		PrintTotals(a);
+		std::printf("after:  ");
+		PrintTotals(b);
+		return 1;
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	if(argc == 3 && std::strcmp(argv[1], "dump") == 0)
+		return Dump(argv[2]);
+	if(argc == 4 && std::strcmp(argv[1], "diff") == 0)
+		return Diff(argv[2], argv[3]);
+
+	std::printf("Usage: SWAN-GLLog dump <log>\n"
+	            "       SWAN-GLLog diff <before> <after>\n");
+	return 2;
+}
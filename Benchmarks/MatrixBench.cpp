@@ -0,0 +1,145 @@
+// Compares the SIMD mat4 kernels in Maths/Matrix.hpp against the
+// constexpr/scalar versions and checks that they agree. Also times the
+// affine3x4 equivalents from Maths/Affine.hpp.
+//
+// Usage: SWAN-Matrix-Bench [iterations]
+
+#include "Bench.hpp"
+#include "Maths/Affine.hpp"
+#include "Maths/Matrix.hpp"
+
+#include <cmath>  // For std::fabs(), std::nextafter()
+#include <limits> // For std::numeric_limits<T>
+#include <random> // For std::mt19937
+#include <vector> // For std::vector<T>
+
+using namespace SWAN;
+
+static constexpr int MatCount = 1024;
+
+static mat4 ReferenceTranspose(const mat4& m)
+{
+	mat4 res;
+	for(int y = 0; y < 4; y++)
+		for(int x = 0; x < 4; x++)
+			res(x, y) = m(y, x);
+	return res;
+}
+
+// The distance between f and the next float away from zero.
+static double Ulp(float f)
+{
+	f = std::fabs(f);
+	return (double) std::nextafter(f, std::numeric_limits<float>::infinity()) - f;
+}
+
+int main(int argc, char** argv)
+{
+	int iterations = Bench::Iterations(argc, argv, 1 << 22);
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-10, 10);
+
+	std::vector<mat4> general(MatCount), affine(MatCount);
+	std::vector<affine3x4> affine34(MatCount);
+	for(int i = 0; i < MatCount; i++) {
+		for(int j = 0; j < 16; j++)
+			general[i].data[j] = dist(rng);
+
+		affine[i] = Translate(vec3(dist(rng), dist(rng), dist(rng)))
+		            * Rotate(dist(rng), vec3(dist(rng), dist(rng), dist(rng)))
+		            * Scale(vec3(1 + std::fabs(dist(rng)), 1 + std::fabs(dist(rng)), 1 + std::fabs(dist(rng))));
+		affine34[i] = affine3x4(affine[i]);
+	}
+
+	// ---------------------------- Accuracy ---------------------------- //
+	// The products of an element can cancel out, so its error is measured in ULPs of the sum of
+	// their magnitudes, where it's bounded, rather than in ULPs of the element itself.
+	double maxUlp = 0;
+	double maxInvError = 0, maxAffineError = 0;
+	for(int i = 0; i < MatCount; i++) {
+		const mat4& a = general[i];
+		const mat4& b = general[(i + 1) % MatCount];
+		mat4 fast = a * b, ref = _DoMult<mat4, 4>(a, b);
+
+		for(int y = 0; y < 4; y++) {
+			for(int x = 0; x < 4; x++) {
+				double absSum = 0;
+				for(int k = 0; k < 4; k++)
+					absSum += std::fabs((double) a(k, y) * b(x, k));
+
+				maxUlp = std::max(maxUlp, std::fabs((double) fast(x, y) - ref(x, y)) / Ulp((float) absSum));
+			}
+		}
+
+		mat4 inv = Inverse(affine[i]), invRef = _InverseByMinors(affine[i]), invAff = InverseAffine(affine[i]);
+		for(int j = 0; j < 16; j++) {
+			double scale = std::max(1.0, (double) std::fabs(invRef.data[j]));
+			maxInvError = std::max(maxInvError, std::fabs(inv.data[j] - invRef.data[j]) / scale);
+			maxAffineError = std::max(maxAffineError, std::fabs(invAff.data[j] - invRef.data[j]) / scale);
+		}
+	}
+
+#if defined(SWAN_SIMD_AVX)
+	std::printf("Instruction set: AVX\n");
+#elif defined(SWAN_SIMD_SSE)
+	std::printf("Instruction set: SSE2\n");
+#else
+	std::printf("Instruction set: scalar\n");
+#endif
+	bool withinBound = maxUlp < 5;
+	std::printf("mat4 * mat4:   max %.2f ULP of sum(|products|) from _DoMult(), bound of 5 ULP %s\n", maxUlp,
+	            withinBound ? "holds" : "VIOLATED");
+	std::printf("Inverse:       max relative error %g\n", maxInvError);
+	std::printf("InverseAffine: max relative error %g\n\n", maxAffineError);
+
+	// ---------------------------- Timing ---------------------------- //
+	const int mask = MatCount - 1;
+	double ns;
+
+	ns = Bench::Time(iterations, [&](int i) {
+		Bench::DoNotOptimize(_DoMult<mat4, 4>(general[i & mask], general[(i + 1) & mask]));
+	});
+	Bench::Report("mat4 * mat4 (_DoMult)", ns);
+	Bench::Report("mat4 * mat4", Bench::Time(iterations, [&](int i) {
+		              Bench::DoNotOptimize(general[i & mask] * general[(i + 1) & mask]);
+	              }),
+	              ns);
+
+	ns = Bench::Time(iterations / 8, [&](int i) {
+		Bench::DoNotOptimize(_InverseByMinors(affine[i & mask]));
+	});
+	Bench::Report("Inverse (_InverseByMinors)", ns);
+	Bench::Report("Inverse", Bench::Time(iterations, [&](int i) {
+		              Bench::DoNotOptimize(Inverse(affine[i & mask]));
+	              }),
+	              ns);
+	Bench::Report("InverseAffine", Bench::Time(iterations, [&](int i) {
+		              Bench::DoNotOptimize(InverseAffine(affine[i & mask]));
+	              }),
+	              ns);
+	Bench::Report("Inverse(affine3x4)", Bench::Time(iterations, [&](int i) {
+		              Bench::DoNotOptimize(Inverse(affine34[i & mask]));
+	              }),
+	              ns);
+
+	ns = Bench::Time(iterations, [&](int i) {
+		Bench::DoNotOptimize(affine[i & mask] * affine[(i + 1) & mask]);
+	});
+	Bench::Report("affine mat4 * mat4", ns);
+	Bench::Report("affine3x4 * affine3x4", Bench::Time(iterations, [&](int i) {
+		              Bench::DoNotOptimize(affine34[i & mask] * affine34[(i + 1) & mask]);
+	              }),
+	              ns);
+
+	ns = Bench::Time(iterations, [&](int i) {
+		Bench::DoNotOptimize(ReferenceTranspose(general[i & mask]));
+	});
+	Bench::Report("Transpose (scalar)", ns);
+	Bench::Report("Transpose", Bench::Time(iterations, [&](int i) {
+		              Bench::DoNotOptimize(Transpose(general[i & mask]));
+	              }),
+	              ns);
+
+	return withinBound ? 0 : 1;
+}
@@ -0,0 +1,97 @@
+// Compares raycasts against a TriangleMesh through its MeshBVH with testing every
+// triangle, and times building the hierarchy and mesh-vs-mesh tests.
+//
+// Usage: SWAN-MeshBVH-Bench [triangle count]
+
+#include "Bench.hpp"
+#include "Physics/TriangleMesh.hpp"
+
+#include <algorithm> // For std::min()
+#include <cmath>     // For std::abs()
+#include <random>    // For std::mt19937
+
+using namespace SWAN;
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 50000);
+	const int rayCount = 1024;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-50, 50);
+	std::uniform_real_distribution<float> size(-1, 1);
+
+	// A triangle soup on the surface of a sphere, roughly like a scanned mesh.
+	Vector<Triangle> triangles(count);
+	for(Triangle& t : triangles) {
+		vec3 c = Normalized(vec3(dist(rng), dist(rng), dist(rng))) * 40;
+		t = Triangle(c + vec3(size(rng), size(rng), size(rng)), c + vec3(size(rng), size(rng), size(rng)), c + vec3(size(rng), size(rng), size(rng)));
+	}
+
+	Vector<Ray> rays(rayCount);
+	for(Ray& r : rays)
+		r = Ray(vec3(dist(rng), dist(rng), dist(rng)), vec3(dist(rng), dist(rng), dist(rng)));
+
+	TriangleMesh mesh;
+	double buildNs = Bench::Time(3, [&](int) {
+		mesh.Triangles = triangles;
+		mesh.Build();
+	});
+	std::printf("%d triangles, %zu nodes, built in %.2f ms\n", count, mesh.GetBVH().getNodes().size(), buildNs / 1e6);
+
+	// ---------------------------- Raycasts ---------------------------- //
+	int mismatches = 0;
+	double refNs = Bench::Time(1, [&](int) {
+		for(const Ray& r : rays) {
+			double best = 1e30;
+			for(const Triangle& t : mesh.Triangles) {
+				Intersection hit = FindIntersection(t, r);
+				if(hit)
+					best = std::min(best, Dot(hit.point - r.start, r.dir));
+			}
+
+			double t = 1e30;
+			mesh.Raycast(r, 1e30, &t);
+			mismatches += std::abs(t - best) > 1e-3;
+		}
+	});
+
+	double bvhNs = Bench::Time(10, [&](int) {
+		for(const Ray& r : rays) {
+			double t;
+			Bench::DoNotOptimize(mesh.Raycast(r, 1e30, &t));
+		}
+	});
+
+	double packetNs = Bench::Time(10, [&](int) {
+		for(int i = 0; i < rayCount; i += RayPacket::Width) {
+			RayPacket p;
+			for(int j = 0; j < RayPacket::Width; j++)
+				p.set(j, rays[i + j]);
+			mesh.Raycast(p);
+			Bench::DoNotOptimize(p.hit[0]);
+		}
+	});
+
+	std::printf("%d rays, %d mismatches\n", rayCount, mismatches);
+	Bench::Report("Every triangle, per ray", refNs / rayCount);
+	Bench::Report("TriangleMesh::Raycast, per ray", bvhNs / rayCount, refNs / rayCount);
+	Bench::Report("TriangleMesh::Raycast(RayPacket), per ray", packetNs / rayCount, refNs / rayCount);
+
+	// ---------------------------- Mesh vs mesh ---------------------------- //
+	// A smaller copy of the mesh that touches it on one side.
+	Vector<Triangle> moved = triangles;
+	for(Triangle& t : moved)
+		for(vec3& p : t.points)
+			p = p * 0.5 + vec3(25, 0, 0);
+	TriangleMesh other(moved);
+
+	int hits = 0;
+	double meshNs = Bench::Time(10, [&](int) {
+		hits += FindIntersection(mesh, other).happened;
+	});
+	std::printf("Meshes intersect: %s\n", hits ? "yes" : "no");
+	Bench::Report("FindIntersection(TriangleMesh, TriangleMesh)", meshNs);
+
+	return 0;
+}
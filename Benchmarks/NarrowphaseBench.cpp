@@ -0,0 +1,92 @@
+// Compares the contact tests of the narrowphase: the AABB path (FindContact(AABB, AABB)),
+// the separating axis test for OBBs, and GJK/EPA on convex hulls, in ns per pair.
+// Every test sees the same boxes, rotated for the OBB and hull tests.
+//
+// Usage: SWAN-Narrowphase-Bench [pair count]
+
+#include "Bench.hpp"
+#include "Physics/ConvexHull.hpp"
+#include "Physics/OBB.hpp"
+
+#include <random> // For std::mt19937
+
+using namespace SWAN;
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 20000);
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-1, 1);
+	std::uniform_real_distribution<float> size(0.25f, 1);
+
+	auto randomAxes = [&](vec3* axes) {
+		axes[0] = Normalized(vec3(dist(rng), dist(rng), dist(rng)));
+		axes[1] = Normalized(Cross(axes[0], vec3(dist(rng), dist(rng), dist(rng))));
+		axes[2] = Cross(axes[0], axes[1]);
+	};
+	auto hullOf = [](const OBB& box) {
+		Vector<vec3> corners(8);
+		for(unsigned i = 0; i < 8; i++)
+			corners[i] = box.Corner(i);
+		return ConvexHull(corners);
+	};
+
+	Vector<AABB> boxes(count * 2);
+	Vector<OBB> obbs(count * 2);
+	Vector<ConvexHull> hulls(count * 2);
+	for(int i = 0; i < count * 2; i++) {
+		vec3 c(dist(rng), dist(rng), dist(rng));
+		vec3 h(size(rng), size(rng), size(rng));
+		boxes[i] = AABB(c - h, c + h);
+
+		vec3 axes[3];
+		randomAxes(axes);
+		obbs[i] = OBB(c, h, axes[0], axes[1], axes[2]);
+		hulls[i] = hullOf(obbs[i]);
+	}
+
+	// Hulls with more points, to see how Support() scales.
+	Vector<ConvexHull> spheres(count * 2);
+	for(int i = 0; i < count * 2; i++) {
+		vec3 c(dist(rng), dist(rng), dist(rng));
+		for(int j = 0; j < 64; j++)
+			spheres[i].Points.push_back(c + Normalized(vec3(dist(rng), dist(rng), dist(rng))) * 0.6);
+	}
+
+	auto run = [&](const char* name, double baselineNs, auto test) {
+		int hits = 0;
+		double ns = Bench::Time(5, [&](int) {
+			ContactManifold m;
+			for(int i = 0; i < count; i++)
+				hits += test(i * 2, i * 2 + 1, m);
+		});
+		std::printf("%-40s %d/%d pairs touch\n", name, hits / 5, count);
+		Bench::Report(name, ns / count, baselineNs);
+		return ns / count;
+	};
+
+	double aabbNs = run("FindContact(AABB, AABB)", 0, [&](int a, int b, ContactManifold& m) {
+		return FindContact(boxes[a], boxes[b], m);
+	});
+	run("FindContact(OBB, OBB), not rotated", aabbNs, [&](int a, int b, ContactManifold& m) {
+		return FindContact(OBB(boxes[a]), OBB(boxes[b]), m);
+	});
+	run("FindContact(OBB, OBB)", aabbNs, [&](int a, int b, ContactManifold& m) {
+		return FindContact(obbs[a], obbs[b], m);
+	});
+	run("FindIntersection(OBB, OBB)", aabbNs, [&](int a, int b, ContactManifold&) {
+		return FindIntersection(obbs[a], obbs[b]).happened;
+	});
+	run("FindContact(ConvexHull, ConvexHull), 8", aabbNs, [&](int a, int b, ContactManifold& m) {
+		return FindContact(hulls[a], hulls[b], m);
+	});
+	run("FindIntersection(ConvexHull, ...), 8", aabbNs, [&](int a, int b, ContactManifold&) {
+		return FindIntersection(hulls[a], hulls[b]).happened;
+	});
+	run("FindContact(ConvexHull, ConvexHull), 64", aabbNs, [&](int a, int b, ContactManifold& m) {
+		return FindContact(spheres[a], spheres[b], m);
+	});
+
+	return 0;
+}
@@ -0,0 +1,221 @@
+// Steps procedural physics scenes headless for a number of frames, and reports steps per second
+// and the work done by every stage. Results can also be written as JSON, to track regressions
+// across commits:
+//
+//     SWAN-Physics-Bench 300 results-$(git rev-parse --short HEAD).json
+//
+// Scenes:
+//     box-pile      Boxes of random sizes dropped on a plane from a column above it.
+//     stacks        Towers of boxes standing on a plane.
+//     large-plane   Boxes spread far apart over one big plane, so nearly every pair is a plane pair.
+//     sphere-cloud  Spheres of random sizes falling onto a plane.
+//     projectiles   Fast small spheres with continuous collision, fired at thin walls.
+//
+// The scenes don't depend on the standard library's random distributions, so they're the same
+// with every compiler. The checksum of the final positions changes whenever the simulation does.
+//
+// Usage: SWAN-Physics-Bench [frames] [results.json] [threads]
+
+#include "Bench.hpp"
+#include "FPS/Physics.hpp"
+
+#include <cstdint> // For std::uint32_t, std::uint64_t
+#include <cstring> // For std::memcpy()
+#include <random>  // For std::mt19937
+
+using namespace SWAN;
+
+namespace
+{
+	struct Scene {
+		const char* name;
+		void (*build)(PhysicsWorld& world);
+	};
+
+	struct Result {
+		const char* name;
+		std::size_t objects, awake;
+		double seconds, maxStepMs;
+		double broadphasePairs, narrowphaseTests, contacts, islands;
+		std::uint64_t checksum;
+	};
+
+	float Random(std::mt19937& rng, float min, float max)
+	{
+		return min + (max - min) * (float) (rng() / 4294967296.0);
+	}
+
+	PhysicsObject Box(vec3 center, vec3 halfExtents)
+	{
+		PhysicsObject box(AABB(-halfExtents, halfExtents));
+		box.Transform.pos = center;
+		return box;
+	}
+
+	void BuildBoxPile(PhysicsWorld& world)
+	{
+		std::mt19937 rng(1);
+		world.AddPhysicsObject(PhysicsObject(Plane(vec3(0, 1, 0), 0.0)));
+		for(int i = 0; i < 2000; i++) {
+			vec3 pos(Random(rng, -10, 10), Random(rng, 1, 60), Random(rng, -10, 10));
+			vec3 half(Random(rng, 0.2f, 0.6f), Random(rng, 0.2f, 0.6f), Random(rng, 0.2f, 0.6f));
+			world.AddPhysicsObject(Box(pos, half));
+		}
+	}
+
+	void BuildStacks(PhysicsWorld& world)
+	{
+		world.AddPhysicsObject(PhysicsObject(Plane(vec3(0, 1, 0), 0.0)));
+		for(int x = 0; x < 16; x++)
+			for(int z = 0; z < 16; z++)
+				for(int level = 0; level < 8; level++)
+					world.AddPhysicsObject(Box(vec3(x * 3.0, 0.5 + level * 1.0, z * 3.0), vec3(0.5)));
+	}
+
+	void BuildLargePlane(PhysicsWorld& world)
+	{
+		std::mt19937 rng(2);
+		world.AddPhysicsObject(PhysicsObject(Plane(vec3(0, 1, 0), 0.0)));
+		for(int i = 0; i < 4000; i++) {
+			vec3 pos(Random(rng, -500, 500), Random(rng, 0.5f, 3), Random(rng, -500, 500));
+			world.AddPhysicsObject(Box(pos, vec3(0.5)));
+		}
+	}
+
+	void BuildSphereCloud(PhysicsWorld& world)
+	{
+		std::mt19937 rng(3);
+		world.AddPhysicsObject(PhysicsObject(Plane(vec3(0, 1, 0), 0.0)));
+		for(int i = 0; i < 2000; i++) {
+			PhysicsObject sphere(Sphere{ vec3(0), Random(rng, 0.2f, 0.7f) });
+			sphere.Transform.pos = vec3(Random(rng, -15, 15), Random(rng, 1, 40), Random(rng, -15, 15));
+			world.AddPhysicsObject(sphere);
+		}
+	}
+
+	void BuildProjectiles(PhysicsWorld& world)
+	{
+		std::mt19937 rng(4);
+		world.AddPhysicsObject(PhysicsObject(Plane(vec3(0, 1, 0), 0.0)));
+		for(int i = 0; i < 20; i++) {
+			PhysicsObject wall = Box(vec3(20, 2, i * 5.0), vec3(0.05f, 2, 2));
+			wall.Static = true;
+			world.AddPhysicsObject(wall);
+		}
+		for(int i = 0; i < 1000; i++) {
+			PhysicsObject bullet(Sphere{ vec3(0), 0.05f });
+			bullet.Transform.pos = vec3(Random(rng, -20, 0), Random(rng, 0.5f, 3.5f), Random(rng, -2, 97));
+			bullet.Velocity = vec3(Random(rng, 200, 400), 0, 0);
+			bullet.ContinuousCollision = true;
+			world.AddPhysicsObject(bullet);
+		}
+	}
+
+	/// FNV-1a over the bits of every position.
+	std::uint64_t Checksum(const PhysicsWorld& world)
+	{
+		std::uint64_t hash = 14695981039346656037ull;
+		for(const PhysicsObject& po : world.PhysicsObjects) {
+			const float p[3] = { (float) po.Transform.pos.x, (float) po.Transform.pos.y, (float) po.Transform.pos.z };
+			for(float f : p) {
+				std::uint32_t bits;
+				std::memcpy(&bits, &f, sizeof(bits));
+				for(int i = 0; i < 4; i++)
+					hash = (hash ^ ((bits >> (i * 8)) & 0xFF)) * 1099511628211ull;
+			}
+		}
+		return hash;
+	}
+
+	Result Run(const Scene& scene, int frames, ThreadPool* pool)
+	{
+		PhysicsWorld world;
+		world.Pool = pool;
+		scene.build(world);
+
+		Result r = {};
+		r.name = scene.name;
+		r.objects = world.PhysicsObjects.size();
+
+		const FloatSeconds dt(1 / 60.0f);
+		for(int frame = 0; frame < frames; frame++) {
+			auto start = Bench::Clock::now();
+			world.Update(dt);
+			double seconds = std::chrono::duration<double>(Bench::Clock::now() - start).count();
+
+			r.seconds += seconds;
+			r.maxStepMs = std::max(r.maxStepMs, seconds * 1e3);
+			r.broadphasePairs += world.GetBroadphasePairCount();
+			r.narrowphaseTests += world.GetNarrowphaseTestCount();
+			r.contacts += world.GetContacts().size();
+			r.islands += world.GetIslandCount();
+		}
+
+		r.broadphasePairs /= frames;
+		r.narrowphaseTests /= frames;
+		r.contacts /= frames;
+		r.islands /= frames;
+		r.awake = world.GetAwakeCount();
+		r.checksum = Checksum(world);
+		return r;
+	}
+
+	void WriteJSON(const char* path, const Vector<Result>& results, int frames, unsigned threads)
+	{
+		std::FILE* f = std::fopen(path, "w");
+		if(!f) {
+			std::fprintf(stderr, "Couldn't open %s for writing\n", path);
+			return;
+		}
+
+		std::fprintf(f, "{\n  \"frames\": %d,\n  \"threads\": %u,\n  \"scenes\": [\n", frames, threads);
+		for(std::size_t i = 0; i < results.size(); i++) {
+			const Result& r = results[i];
+			std::fprintf(f,
+			             "    {\"name\": \"%s\", \"objects\": %zu, \"steps_per_second\": %.2f, \"mean_step_ms\": %.4f, "
+			             "\"max_step_ms\": %.4f, \"broadphase_pairs\": %.1f, \"narrowphase_tests\": %.1f, "
+			             "\"contacts\": %.1f, \"islands\": %.1f, \"awake_at_end\": %zu, \"checksum\": \"%016llx\"}%s\n",
+			             r.name, r.objects, frames / r.seconds, r.seconds * 1e3 / frames, r.maxStepMs, r.broadphasePairs,
+			             r.narrowphaseTests, r.contacts, r.islands, r.awake, (unsigned long long) r.checksum,
+			             i + 1 < results.size() ? "," : "");
+		}
+		std::fprintf(f, "  ]\n}\n");
+		std::fclose(f);
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	int frames = Bench::Iterations(argc, argv, 300);
+	const char* json = argc > 2 ? argv[2] : nullptr;
+	unsigned threads = argc > 3 ? std::atoi(argv[3]) : 1;
+	if(frames <= 0) {
+		// Every result is an average over the frames.
+		std::fprintf(stderr, "Usage: SWAN-Physics-Bench [frames] [results.json] [threads]\n"
+		                     "frames has to be a positive number.\n");
+		return 1;
+	}
+
+	const Scene scenes[] = {
+		{ "box-pile", BuildBoxPile },
+		{ "stacks", BuildStacks },
+		{ "large-plane", BuildLargePlane },
+		{ "sphere-cloud", BuildSphereCloud },
+		{ "projectiles", BuildProjectiles },
+	};
+
+	ThreadPool pool(threads);
+	Vector<Result> results;
+	std::printf("%-14s %8s %10s %10s %10s %12s %10s %8s\n", "scene", "objects", "steps/s", "max ms", "bp pairs", "np tests",
+	            "contacts", "awake");
+	for(const Scene& scene : scenes) {
+		Result r = Run(scene, frames, threads > 1 ? &pool : nullptr);
+		std::printf("%-14s %8zu %10.1f %10.3f %10.1f %12.1f %10.1f %8zu\n", r.name, r.objects, frames / r.seconds,
+		            r.maxStepMs, r.broadphasePairs, r.narrowphaseTests, r.contacts, r.awake);
+		results.push_back(r);
+	}
+
+	if(json)
+		WriteJSON(json, results, frames, threads);
+	return 0;
+}
@@ -0,0 +1,87 @@
+// Steps a headless stress scene (towers of boxes falling onto a ground plane) with
+// 1, 2, 4 and 8 threads, and checks that every thread count gives the same result.
+// Then compares stepping the settled scene with and without sleeping.
+//
+// Usage: SWAN-PhysicsStep-Bench [tower count]
+
+#include "Bench.hpp"
+#include "FPS/Physics.hpp"
+
+#include <cstring> // For std::memcmp()
+
+using namespace SWAN;
+
+static void BuildScene(PhysicsWorld& world, int towers)
+{
+	world.AddPhysicsObject(PhysicsObject(Plane(vec3(0, 1, 0), 0.0)));
+
+	// Towers of slightly overlapping boxes, so every tower is an island.
+	int side = 1;
+	while(side * side < towers)
+		side++;
+	for(int i = 0; i < towers; i++) {
+		for(int level = 0; level < 4; level++) {
+			PhysicsObject box(AABB(vec3(-0.5), vec3(0.5)));
+			box.Transform.pos = vec3((i % side) * 3.0, 1 + level * 0.95, (i / side) * 3.0);
+			world.AddPhysicsObject(box);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	int towers = Bench::Iterations(argc, argv, 4000);
+	const int steps = 60;
+	const FloatSeconds dt(1 / 60.0f);
+
+	Vector<vec3> reference;
+	double baselineNs = 0;
+	for(unsigned threads : { 1, 2, 4, 8 }) {
+		ThreadPool pool(threads);
+		PhysicsWorld world;
+		world.Pool = &pool;
+		BuildScene(world, towers);
+
+		std::size_t contacts = 0;
+		double ns = Bench::Time(steps, [&](int) {
+			world.Update(dt);
+			contacts += world.GetContacts().size();
+		});
+
+		Vector<vec3> positions;
+		for(const PhysicsObject& po : world.PhysicsObjects)
+			positions.push_back(po.Transform.pos);
+		if(reference.empty())
+			reference = positions;
+		bool same = std::memcmp(positions.data(), reference.data(), positions.size() * sizeof(vec3)) == 0;
+
+		std::printf("%u threads: %zu objects, %zu islands, %zu contacts per step, %s\n", threads, world.PhysicsObjects.size(),
+		            world.GetIslandCount(), contacts / steps, same ? "same result" : "DIFFERENT RESULT");
+
+		char name[64];
+		std::snprintf(name, sizeof(name), "PhysicsWorld::Update(), %u threads", threads);
+		if(threads == 1)
+			baselineNs = ns;
+		Bench::Report(name, ns, threads == 1 ? 0 : baselineNs);
+	}
+
+	// The same scene once it has come to rest, with and without sleeping.
+	double awakeNs = 0;
+	for(bool sleeping : { false, true }) {
+		PhysicsWorld world;
+		if(!sleeping)
+			world.SleepSteps = ~0u;
+		BuildScene(world, towers);
+		for(int i = 0; i < 300; i++)
+			world.Update(dt);
+
+		double ns = Bench::Time(steps, [&](int) { world.Update(dt); });
+		std::printf("After settling, %s sleeping: %zu of %zu objects awake\n", sleeping ? "with" : "without",
+		            world.GetAwakeCount(), world.PhysicsObjects.size() - 1);
+		if(!sleeping)
+			awakeNs = ns;
+		Bench::Report(sleeping ? "Settled, sleeping" : "Settled, never sleeping", ns, sleeping ? awakeNs : 0);
+	}
+
+	return 0;
+}
@@ -0,0 +1,105 @@
+// Compares the batched PointStream kernels in Maths/PointStream.hpp
+// against transforming one vec3 at a time through vec4 * mat4.
+//
+// Usage: SWAN-PointStream-Bench [point count]
+
+#include "Bench.hpp"
+#include "Maths/PointStream.hpp"
+
+#include <algorithm> // For std::min(), std::max()
+#include <cmath>     // For std::fabs()
+#include <random>    // For std::mt19937
+#include <vector>    // For std::vector<T>
+
+using namespace SWAN;
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 100000);
+	const int rounds = 50;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-100, 100);
+
+	std::vector<vec3> points(count), mins(count), maxs(count);
+	for(int i = 0; i < count; i++) {
+		points[i] = vec3(dist(rng), dist(rng), dist(rng));
+		mins[i] = points[i];
+		maxs[i] = points[i] + vec3(std::fabs(dist(rng)), std::fabs(dist(rng)), std::fabs(dist(rng))) * 0.1;
+	}
+
+	mat4 m = Translate(vec3(1, 2, 3)) * Rotate(0.7, vec3(1, 1, 0)) * Scale(vec3(2, 1, 0.5));
+	mat4 mT = Transpose(m);
+
+	// ---------------------------- Points ---------------------------- //
+	std::vector<vec3> refPoints(count);
+	double refNs = Bench::Time(rounds, [&](int) {
+		for(int i = 0; i < count; i++)
+			refPoints[i] = vec4(points[i], 1) * mT;
+		Bench::DoNotOptimize(refPoints[0]);
+	});
+
+	PointStream in(points), out;
+	double ns = Bench::Time(rounds, [&](int) {
+		TransformPoints(m, in, out);
+		Bench::DoNotOptimize(out.x[0]);
+	});
+
+	double maxError = 0;
+	for(int i = 0; i < count; i++)
+		maxError = std::max(maxError, Length(refPoints[i] - out.get(i)));
+
+	std::printf("%d points, max difference %g\n", count, maxError);
+	Bench::Report("vec4(p, 1) * mat4, per point", refNs / count);
+	Bench::Report("TransformPoints, per point", ns / count, refNs / count);
+
+	// ---------------------------- Directions ---------------------------- //
+	refNs = Bench::Time(rounds, [&](int) {
+		for(int i = 0; i < count; i++)
+			refPoints[i] = vec4(points[i], 0) * mT;
+		Bench::DoNotOptimize(refPoints[0]);
+	});
+	ns = Bench::Time(rounds, [&](int) {
+		TransformDirections(m, in, out);
+		Bench::DoNotOptimize(out.x[0]);
+	});
+	Bench::Report("vec4(d, 0) * mat4, per direction", refNs / count);
+	Bench::Report("TransformDirections, per direction", ns / count, refNs / count);
+
+	// ---------------------------- AABBs ---------------------------- //
+	std::vector<vec3> refMins(count), refMaxs(count);
+	refNs = Bench::Time(rounds, [&](int) {
+		for(int i = 0; i < count; i++) {
+			vec3 lo(1e30), hi(-1e30);
+			for(int c = 0; c < 8; c++) {
+				vec3 corner((c & 1) ? maxs[i].x : mins[i].x,
+				            (c & 2) ? maxs[i].y : mins[i].y,
+				            (c & 4) ? maxs[i].z : mins[i].z);
+				vec3 p = vec4(corner, 1) * mT;
+				lo = vec3(std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z));
+				hi = vec3(std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z));
+			}
+			refMins[i] = lo;
+			refMaxs[i] = hi;
+		}
+		Bench::DoNotOptimize(refMins[0]);
+	});
+
+	PointStream inMins(mins), inMaxs(maxs), outMins, outMaxs;
+	ns = Bench::Time(rounds, [&](int) {
+		TransformAABBs(m, inMins, inMaxs, outMins, outMaxs);
+		Bench::DoNotOptimize(outMins.x[0]);
+	});
+
+	maxError = 0;
+	for(int i = 0; i < count; i++) {
+		maxError = std::max(maxError, Length(refMins[i] - outMins.get(i)));
+		maxError = std::max(maxError, Length(refMaxs[i] - outMaxs.get(i)));
+	}
+
+	std::printf("%d boxes, max difference %g\n", count, maxError);
+	Bench::Report("8 corners * mat4, per box", refNs / count);
+	Bench::Report("TransformAABBs, per box", ns / count, refNs / count);
+
+	return 0;
+}
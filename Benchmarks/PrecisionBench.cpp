@@ -0,0 +1,74 @@
+// Shows the memory footprint and throughput difference between float and
+// double vectors (see SWAN::Real in Maths/Vector.hpp) on typical
+// physics-style passes over large arrays.
+//
+// Usage: SWAN-Precision-Bench [body count]
+
+#include "Bench.hpp"
+#include "Maths/Vector.hpp"
+
+#include <random> // For std::mt19937
+#include <vector> // For std::vector<T>
+
+using namespace SWAN;
+
+template <typename T>
+static void RunPrecision(const char* name, int count)
+{
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<T> dist(-100, 100);
+
+	std::vector<tvec3<T>> pos(count), vel(count), mins(count), maxs(count);
+	for(int i = 0; i < count; i++) {
+		pos[i] = tvec3<T>(dist(rng), dist(rng), dist(rng));
+		vel[i] = tvec3<T>(dist(rng), dist(rng), dist(rng));
+	}
+
+	const int rounds = 20;
+	const T dt = T(1) / 60;
+	const tvec3<T> halfSize(T(0.5));
+
+	// Integrate positions and rebuild bounding boxes, like one physics step does.
+	double ns = Bench::Time(rounds, [&](int) {
+		for(int i = 0; i < count; i++) {
+			pos[i] += vel[i] * dt;
+			mins[i] = pos[i] - halfSize;
+			maxs[i] = pos[i] + halfSize;
+		}
+		Bench::DoNotOptimize(maxs[0]);
+	});
+
+	// Count boxes overlapping a fixed query box.
+	const tvec3<T> qMin(-10), qMax(10);
+	int hits = 0;
+	double queryNs = Bench::Time(rounds, [&](int) {
+		int h = 0;
+		for(int i = 0; i < count; i++)
+			h += mins[i].x <= qMax.x && maxs[i].x >= qMin.x
+			     && mins[i].y <= qMax.y && maxs[i].y >= qMin.y
+			     && mins[i].z <= qMax.z && maxs[i].z >= qMin.z;
+		hits = h;
+		Bench::DoNotOptimize(hits);
+	});
+
+	double megabytes = 4.0 * count * sizeof(tvec3<T>) / (1024 * 1024);
+	std::printf("%s: %zu bytes per vec3, %.1f MiB working set\n", name, sizeof(tvec3<T>), megabytes);
+	std::printf("  %-32s %8.3f ms\n", "integrate + rebuild AABBs", ns / 1e6);
+	std::printf("  %-32s %8.3f ms (%d hits)\n", "AABB query", queryNs / 1e6, hits);
+}
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 1 << 21);
+
+#if defined(SWAN_DOUBLE_PRECISION)
+	std::printf("This build uses double precision vectors (SWAN::Real = double)\n\n");
+#else
+	std::printf("This build uses single precision vectors (SWAN::Real = float)\n\n");
+#endif
+
+	RunPrecision<float>("float", count);
+	RunPrecision<double>("double", count);
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+// Compares the ray packet kernels in Physics/RayPacket.hpp against casting
+// one ray at a time through FindIntersection(AABB, Ray) and FindIntersection(Triangle, Ray).
+//
+// Usage: SWAN-RayPacket-Bench [box/triangle count]
+
+#include "Bench.hpp"
+#include "Physics/RayPacket.hpp"
+
+#include <random> // For std::mt19937
+#include <vector> // For std::vector<T>
+
+using namespace SWAN;
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 2000);
+	const int rayCount = 512;
+
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-50, 50);
+	std::uniform_real_distribution<float> size(0.1f, 2);
+
+	std::vector<AABB> boxes(count);
+	std::vector<Triangle> triangles(count);
+	PointStream mins, maxs;
+	for(int i = 0; i < count; i++) {
+		vec3 c(dist(rng), dist(rng), dist(rng));
+		vec3 h(size(rng), size(rng), size(rng));
+		boxes[i] = AABB(c - h, c + h);
+		mins.push_back(c - h);
+		maxs.push_back(c + h);
+		triangles[i] = Triangle(c + vec3(size(rng), 0, 0), c + vec3(0, size(rng), 0), c + vec3(0, 0, size(rng)));
+	}
+
+	std::vector<Ray> rays(rayCount);
+	for(Ray& r : rays)
+		r = Ray(vec3(dist(rng), dist(rng), dist(rng)), vec3(dist(rng), dist(rng), dist(rng)));
+	const float maxDistance = 200;
+
+	// Closest hit of one ray, the way picking code would do it.
+	auto closestBox = [&](const Ray& r) {
+		double best = maxDistance;
+		int index = -1;
+		for(int i = 0; i < count; i++) {
+			Intersection hit = FindIntersection(boxes[i], r);
+			if(hit && Length(hit.point - r.start) < best) {
+				best = Length(hit.point - r.start);
+				index = i;
+			}
+		}
+		return index;
+	};
+	auto closestTriangle = [&](const Ray& r) {
+		double best = maxDistance;
+		int index = -1;
+		for(int i = 0; i < count; i++) {
+			Intersection hit = FindIntersection(triangles[i], r);
+			if(hit && Length(hit.point - r.start) < best) {
+				best = Length(hit.point - r.start);
+				index = i;
+			}
+		}
+		return index;
+	};
+
+	auto packet = [&](int first) {
+		RayPacket p;
+		for(int i = 0; i < RayPacket::Width; i++)
+			p.set(i, rays[first + i], maxDistance);
+		return p;
+	};
+
+	// ---------------------------- Boxes ---------------------------- //
+	int mismatches = 0;
+	for(int r = 0; r < rayCount; r += RayPacket::Width) {
+		RayPacket p = packet(r);
+		IntersectAABBs(p, mins, maxs);
+		for(int i = 0; i < RayPacket::Width; i++)
+			mismatches += (int) p.hit[i] != closestBox(rays[r + i]);
+	}
+	std::printf("%d rays, %d boxes, %d mismatches\n", rayCount, count, mismatches);
+
+	double refNs = Bench::Time(1, [&](int) {
+		for(const Ray& r : rays)
+			Bench::DoNotOptimize(closestBox(r));
+	});
+	double singleNs = Bench::Time(1, [&](int) {
+		for(const Ray& r : rays)
+			Bench::DoNotOptimize(RaycastAABBs(r, mins, maxs, maxDistance));
+	});
+	double packetNs = Bench::Time(1, [&](int) {
+		for(int r = 0; r < rayCount; r += RayPacket::Width) {
+			RayPacket p = packet(r);
+			IntersectAABBs(p, mins, maxs);
+			Bench::DoNotOptimize(p.hit[0]);
+		}
+	});
+	Bench::Report("FindIntersection(AABB, Ray), per ray", refNs / rayCount);
+	Bench::Report("RaycastAABBs, per ray", singleNs / rayCount, refNs / rayCount);
+	Bench::Report("IntersectAABBs, per ray", packetNs / rayCount, refNs / rayCount);
+
+	// ---------------------------- Triangles ---------------------------- //
+	mismatches = 0;
+	for(int r = 0; r < rayCount; r += RayPacket::Width) {
+		RayPacket p = packet(r);
+		IntersectTriangles(p, triangles.data(), count);
+		for(int i = 0; i < RayPacket::Width; i++)
+			mismatches += (int) p.hit[i] != closestTriangle(rays[r + i]);
+	}
+	std::printf("%d rays, %d triangles, %d mismatches\n", rayCount, count, mismatches);
+
+	refNs = Bench::Time(1, [&](int) {
+		for(const Ray& r : rays)
+			Bench::DoNotOptimize(closestTriangle(r));
+	});
+	packetNs = Bench::Time(1, [&](int) {
+		for(int r = 0; r < rayCount; r += RayPacket::Width) {
+			RayPacket p = packet(r);
+			IntersectTriangles(p, triangles.data(), count);
+			Bench::DoNotOptimize(p.hit[0]);
+		}
+	});
+	Bench::Report("FindIntersection(Triangle, Ray), per ray", refNs / rayCount);
+	Bench::Report("IntersectTriangles, per ray", packetNs / rayCount, refNs / rayCount);
+
+	return 0;
+}
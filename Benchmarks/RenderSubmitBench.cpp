@@ -0,0 +1,188 @@
+// Renders with SWAN's renderers against the recording GL backend (OpenGL/Recorder.hpp), so no
+// window or driver is needed. For every scenario it reports the CPU time per frame, and the GL
+// calls, draw calls and bytes of data SWAN submitted per frame.
+//
+// Scenarios:
+//     cubes-single     Cubes rendered one by one.
+//     cubes-batched    The same cubes rendered as one vector.
+//     lines            Lines rendered as one vector.
+//     spheres          Spheres rendered as one vector.
+//     text             Text changed and rendered every frame.
+//     gui-rects        Rectangles rendered by a GUIManager, one by one and batched.
+//     gui-text         Text rendered by a GUIManager.
+//     texture          A texture created from an image.
+//     framebuffer      A framebuffer created, bound and unbound.
+//     shader-uniforms  Uniforms set on a shader, half of them to the values they already have.
+//
+// With a log prefix, the calls of the last frame of every scenario are saved as
+// <prefix><scenario>.gllog, to be compared across commits with SWAN-GLLog:
+//
+//     SWAN-RenderSubmit-Bench 100 before-
+//     SWAN-GLLog diff before-text.gllog after-text.gllog
+//
+// Usage: SWAN-RenderSubmit-Bench [frames] [log prefix]
+
+#include "Bench.hpp"
+#include "GUI/GUIManager.hpp"
+#include "OpenGL/Framebuffer.hpp"
+#include "OpenGL/Recorder.hpp"
+#include "Rendering/DebugRender.hpp"
+#include "Rendering/FrameUniforms.hpp"
+#include "Rendering/Text.hpp"
+
+#include <functional> // For std::function<Sig>
+#include <random>     // For std::mt19937
+#include <string>     // For std::string, std::to_string()
+#include <vector>     // For std::vector<T>
+
+using namespace SWAN;
+
+namespace
+{
+	const char* const vertSrc = "#version 140\n"
+	                            "in vec3 pos;\n"
+	                            "uniform mat4 model;\n"
+	                            "uniform vec4 color;\n"
+	                            "void main() { gl_Position = model * vec4(pos, 1.0); }\n";
+	const char* const fragSrc = "#version 140\n"
+	                            "uniform vec4 color;\n"
+	                            "out vec4 fragColor;\n"
+	                            "void main() { fragColor = color; }\n";
+
+	struct Scenario {
+		const char* name;
+		std::function<void(int frame)> frame;
+	};
+
+	float Random(std::mt19937& rng, float min, float max)
+	{
+		return min + (max - min) * (float) (rng() / 4294967296.0);
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	int frames = Bench::Iterations(argc, argv, 100);
+	std::string logPrefix = argc > 2 ? argv[2] : "";
+	if(frames <= 0) {
+		// Every column is an average over the frames.
+		std::fprintf(stderr, "Usage: SWAN-RenderSubmit-Bench [frames] [log prefix]\n"
+		                     "frames has to be a positive number.\n");
+		// SWAN's static VAOs and buffers are deleted after main() returns, with no context to delete them from.
+		GL::UseRecordingBackend(nullptr);
+		return 1;
+	}
+
+	// There's no display, but the screen projections of text and GUI are made from its size.
+	Display::detail::width = 1280;
+	Display::detail::height = 720;
+
+	GL::CommandLog log;
+	GL::UseRecordingBackend(&log);
+
+	Camera cam(16.0f / 9, vec3(0, 5, -30));
+	SetFrameUniforms(cam, 0);
+
+	std::mt19937 rng(1337);
+
+	std::vector<Cube> cubes(1000);
+	for(Cube& c : cubes) {
+		c.transform.pos = vec3(Random(rng, -20, 20), Random(rng, -20, 20), Random(rng, -20, 20));
+		c.transform.scale = vec3(Random(rng, 0.2f, 2), Random(rng, 0.2f, 2), Random(rng, 0.2f, 2));
+		c.color = vec4(Random(rng, 0, 1), Random(rng, 0, 1), Random(rng, 0, 1), 1);
+	}
+
+	std::vector<DrawnLine> lines(1000);
+	for(DrawnLine& l : lines)
+		l = DrawnLine(vec3(Random(rng, -20, 20), 0, Random(rng, -20, 20)), vec3(Random(rng, -20, 20), 10, Random(rng, -20, 20)),
+		              vec4(Random(rng, 0, 1), Random(rng, 0, 1), Random(rng, 0, 1), 1));
+
+	std::vector<DrawnSphere> spheres(200);
+	for(DrawnSphere& s : spheres) {
+		s.center = vec3(Random(rng, -20, 20), Random(rng, -20, 20), Random(rng, -20, 20));
+		s.radius = Random(rng, 0.2f, 3);
+	}
+
+	BitmapFont font(8, 8, new Image(128, 128));
+	Text text("", &font);
+
+	GUIManager gui;
+	Vector<Rect2D> rects;
+	for(int i = 0; i < 200; i++)
+		rects.push_back(Rect2D(i % 20 * 60, i / 20 * 60, 50, 50, vec4(Random(rng, 0, 1), Random(rng, 0, 1), 1, 1)));
+
+	Image image(256, 256);
+
+	Shader shader;
+	shader.compileShadersFromSrc(vertSrc, fragSrc);
+	shader.addAttrib("pos");
+	shader.linkShaders();
+	Shader::Uniform modelUniform = shader.addUniform("model");
+	Shader::Uniform colorUniform = shader.addUniform("color");
+
+	std::vector<Scenario> scenarios = {
+		{ "cubes-single", [&](int) {
+			 for(const Cube& c : cubes)
+				 Render(cam, c);
+		 } },
+		{ "cubes-batched", [&](int) { Render(cam, cubes); } },
+		{ "lines", [&](int) { Render(cam, lines); } },
+		{ "spheres", [&](int) { Render(cam, spheres); } },
+		{ "text", [&](int frame) {
+			 for(int i = 0; i < 20; i++) {
+				 text = "Frame " + std::to_string(frame) + ", line " + std::to_string(i);
+				 text.render(10, 10 + i * 10);
+			 }
+		 } },
+		{ "gui-rects", [&](int) {
+			 for(int i = 0; i < 50; i++)
+				 gui.RenderRect2D(rects[i]);
+			 gui.BatchRenderRect2D(rects);
+		 } },
+		{ "gui-text", [&](int frame) {
+			 for(int i = 0; i < 20; i++)
+				 gui.RenderText(10, 10 + i * 10, &font, "Frame " + std::to_string(frame) + ", line " + std::to_string(i));
+		 } },
+		{ "texture", [&](int) {
+			 Texture tex(image, true);
+			 tex.bind();
+		 } },
+		{ "framebuffer", [&](int) {
+			 GL::Framebuffer fb(512, 512);
+			 fb.Bind();
+			 fb.Unbind();
+		 } },
+		{ "shader-uniforms", [&](int frame) {
+			 shader.use();
+			 for(int i = 0; i < 100; i++) {
+				 shader.SetMat4(modelUniform, Translate(vec3(i % 2 ? frame : 0, i, 0)));
+				 shader.SetVec4(colorUniform, vec4(1, 1, 1, 1));
+			 }
+			 shader.unuse();
+		 } },
+	};
+
+	std::printf("%-16s %12s %12s %10s %14s %12s\n", "scenario", "ns/frame", "calls/frame", "draws", "data B/frame", "log B/frame");
+	for(const Scenario& s : scenarios) {
+		// The first frame sets up static VAOs and shaders, so it isn't counted.
+		s.frame(0);
+		log.clear();
+
+		double ns = Bench::Time(frames, [&](int i) { s.frame(i + 1); });
+		std::printf("%-16s %12.0f %12.1f %10.1f %14.0f %12.0f\n", s.name, ns,
+		            (double) log.size() / frames, (double) log.getDrawCalls() / frames,
+		            (double) log.getDataBytes() / frames, (double) log.getLogBytes() / frames);
+
+		if(!logPrefix.empty()) {
+			log.clear();
+			s.frame(frames + 1);
+			std::string path = logPrefix + s.name + ".gllog";
+			if(!log.save(path))
+				std::printf("Couldn't write %s\n", path.c_str());
+		}
+	}
+
+	// Static VAOs and buffers are deleted after main() returns, which mustn't go to the log.
+	GL::UseRecordingBackend(nullptr);
+	return 0;
+}
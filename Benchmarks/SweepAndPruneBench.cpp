@@ -0,0 +1,143 @@
+// Steps scenes of slowly moving boxes through SweepAndPrune, AABBTree and
+// SpatialHashGrid, and compares them with the all-pairs FindIntersection(AABB, AABB) loop
+// that PhysicsWorld used to run.
+//
+// Usage: SWAN-SweepAndPrune-Bench [steps]
+
+#include "Bench.hpp"
+#include "Physics/AABBTree.hpp"
+#include "Physics/SpatialHashGrid.hpp"
+#include "Physics/SweepAndPrune.hpp"
+
+#include <cmath>  // For std::cbrt()
+#include <random> // For std::mt19937
+#include <vector> // For std::vector<T>
+
+using namespace SWAN;
+
+struct Scene {
+	std::vector<AABB> boxes;
+	std::vector<vec3> velocities;
+
+	void step()
+	{
+		for(std::size_t i = 0; i < boxes.size(); i++) {
+			boxes[i].min += velocities[i];
+			boxes[i].max += velocities[i];
+		}
+	}
+};
+
+static Scene MakeScene(int count)
+{
+	std::mt19937 rng(1337);
+	float extent = std::cbrt((float) count) * 3;
+	std::uniform_real_distribution<float> pos(-extent, extent), size(0.5f, 1.5f), vel(-0.02f, 0.02f);
+
+	Scene scene;
+	scene.boxes.resize(count);
+	scene.velocities.resize(count);
+	for(int i = 0; i < count; i++) {
+		vec3 p(pos(rng), pos(rng), pos(rng));
+		scene.boxes[i] = AABB(p, p + vec3(size(rng), size(rng), size(rng)));
+		scene.velocities[i] = vec3(vel(rng), vel(rng), vel(rng));
+	}
+	return scene;
+}
+
+/// Inserts every box, then times steps of moving every box and updating the pairs.
+template <typename Broadphase>
+static double TimeBroadphase(int count, int steps, std::size_t& pairCount)
+{
+	Scene scene = MakeScene(count);
+	Broadphase broadphase;
+	std::vector<typename Broadphase::ProxyID> proxies(count);
+	std::vector<typename Broadphase::Pair> pairs;
+	for(int i = 0; i < count; i++)
+		proxies[i] = broadphase.insert(scene.boxes[i], i);
+	broadphase.queryPairs(pairs);
+
+	double ns = Bench::Time(steps, [&](int) {
+		scene.step();
+		for(int i = 0; i < count; i++)
+			broadphase.move(proxies[i], scene.boxes[i], scene.velocities[i]);
+		broadphase.queryPairs(pairs);
+	});
+
+	pairCount = pairs.size();
+	return ns;
+}
+
+/// SweepAndPrune without building the full pair list, i.e. only consuming the added/removed pairs.
+static double TimeSAPEvents(int count, int steps, std::size_t& changes)
+{
+	Scene scene = MakeScene(count);
+	SweepAndPrune sap;
+	std::vector<SweepAndPrune::ProxyID> proxies(count);
+	for(int i = 0; i < count; i++)
+		proxies[i] = sap.insert(scene.boxes[i], i);
+	sap.update();
+
+	changes = 0;
+	return Bench::Time(steps, [&](int) {
+		scene.step();
+		for(int i = 0; i < count; i++)
+			sap.move(proxies[i], scene.boxes[i]);
+		sap.update();
+		changes += sap.getAddedPairs().size() + sap.getRemovedPairs().size();
+	});
+}
+
+/// Max number of pair tests the all-pairs loop actually runs, the rest is extrapolated.
+static constexpr double MaxAllPairsTests = 1e8;
+
+/// One step of the all-pairs loop, on the scene as it is after the other broadphases' steps.
+/// @p pairCount is only exact when the whole loop was run, see MaxAllPairsTests.
+static double TimeAllPairs(int count, int steps, std::size_t& pairCount, bool& estimated)
+{
+	Scene scene = MakeScene(count);
+	for(int i = 0; i < steps; i++)
+		scene.step();
+
+	double total = (double) count * (count - 1) / 2, tested = 0;
+	pairCount = 0;
+	double ns = Bench::Time(1, [&](int) {
+		for(int i = 0; i < count && tested < MaxAllPairsTests; i++) {
+			for(int j = i + 1; j < count; j++)
+				pairCount += FindIntersection(scene.boxes[i], scene.boxes[j]).happened;
+			tested += count - 1 - i;
+		}
+	});
+
+	estimated = tested < total;
+	return ns * total / tested;
+}
+
+int main(int argc, char** argv)
+{
+	int steps = Bench::Iterations(argc, argv, 30);
+
+	for(int count : { 1000, 10000, 50000 }) {
+		std::size_t sapPairs, treePairs, gridPairs, bruteP, changes;
+		bool estimated;
+		double sap = TimeBroadphase<SweepAndPrune>(count, steps, sapPairs);
+		double events = TimeSAPEvents(count, steps, changes);
+		double tree = TimeBroadphase<AABBTree>(count, steps, treePairs);
+		double grid = TimeBroadphase<SpatialHashGrid>(count, steps, gridPairs);
+		double brute = TimeAllPairs(count, steps, bruteP, estimated);
+
+		std::printf("%d boxes (%zu overlapping pairs)\n", count, sapPairs);
+		std::printf("  %-40s %10.3f ms/step%s\n", "all pairs", brute / 1e6, estimated ? "  (extrapolated)" : "");
+		std::printf("  %-40s %10.3f ms/step  (x%.1f)\n", "SweepAndPrune, full pair list", sap / 1e6, brute / sap);
+		std::printf("  %-40s %10.3f ms/step  (x%.1f, %.1f pair changes/step)\n", "SweepAndPrune, added/removed only",
+		            events / 1e6, brute / events, (double) changes / steps);
+		std::printf("  %-40s %10.3f ms/step  (x%.1f, %zu candidate pairs)\n", "AABBTree", tree / 1e6, brute / tree, treePairs);
+		std::printf("  %-40s %10.3f ms/step  (x%.1f)\n", "SpatialHashGrid", grid / 1e6, brute / grid);
+		if(!estimated && sapPairs != bruteP)
+			std::printf("  SweepAndPrune found %zu pairs, expected %zu!\n", sapPairs, bruteP);
+		if(gridPairs != sapPairs)
+			std::printf("  SpatialHashGrid found %zu pairs, SweepAndPrune %zu!\n", gridPairs, sapPairs);
+	}
+
+	return 0;
+}
@@ -0,0 +1,82 @@
+// Compares TransformHierarchy::update() against calling Transform::getModel()
+// (which recurses through every parent) for every node.
+//
+// Usage: SWAN-TransformHierarchy-Bench [node count]
+
+#include "Bench.hpp"
+#include "Physics/Transform.hpp"
+#include "Physics/TransformHierarchy.hpp"
+
+#include <algorithm> // For std::max()
+#include <cmath>     // For std::fabs()
+#include <random>    // For std::mt19937
+#include <vector>    // For std::vector<T>
+
+using namespace SWAN;
+using NodeID = TransformHierarchy::NodeID;
+
+static void RunScene(const char* name, int count, int depth)
+{
+	std::mt19937 rng(1337);
+	std::uniform_real_distribution<float> dist(-1, 1);
+
+	// Chains of the given depth, i.e. node i's parent is node i - 1 unless it starts a new chain.
+	std::vector<Transform> transforms(count);
+	TransformHierarchy hierarchy;
+	std::vector<NodeID> ids(count);
+	for(int i = 0; i < count; i++) {
+		vec3 pos(dist(rng), dist(rng), dist(rng));
+		vec3 rot(dist(rng), dist(rng), dist(rng));
+
+		bool root = i % depth == 0;
+		transforms[i] = Transform(pos, rot, vec3(1), root ? NULL : &transforms[i - 1]);
+		ids[i] = hierarchy.add(pos, quat::FromEuler(rot), vec3(1), root ? TransformHierarchy::None : ids[i - 1]);
+	}
+	hierarchy.update();
+
+	double maxError = 0;
+	for(int i = 0; i < count; i += 97) {
+		mat4 a = transforms[i].getModel(), b = hierarchy.getWorld(ids[i]);
+		for(int j = 0; j < 16; j++)
+			maxError = std::max(maxError, (double) std::fabs(a.data[j] - b.data[j]));
+	}
+
+	const int rounds = 5;
+	double recursiveNs = Bench::Time(rounds, [&](int) {
+		for(int i = 0; i < count; i++)
+			Bench::DoNotOptimize(transforms[i].getModel());
+	});
+
+	double fullNs = Bench::Time(rounds, [&](int r) {
+		for(int i = 0; i < count; i += depth)
+			hierarchy.setPos(ids[i], vec3(r, 0, 0));
+		hierarchy.update();
+	});
+
+	double sparseNs = Bench::Time(rounds, [&](int r) {
+		for(int i = 0; i < count; i += 100)
+			hierarchy.setPos(ids[i], vec3(r, 1, 0));
+		hierarchy.update();
+	});
+	unsigned sparseUpdated = hierarchy.getLastUpdateCount();
+
+	double idleNs = Bench::Time(rounds, [&](int) { hierarchy.update(); });
+
+	std::printf("%s: %d nodes, depth %d, max difference %g\n", name, count, depth, maxError);
+	std::printf("  (times below in ms per frame)\n");
+	std::printf("  %-40s %10.3f\n", "getModel() for every node", recursiveNs / 1e6);
+	std::printf("  %-40s %10.3f  (x%.1f)\n", "update(), every root moved", fullNs / 1e6, recursiveNs / fullNs);
+	std::printf("  %-40s %10.3f  (x%.1f, %u nodes updated)\n", "update(), 1% of nodes moved", sparseNs / 1e6, recursiveNs / sparseNs, sparseUpdated);
+	std::printf("  %-40s %10.3f\n", "update(), nothing moved", idleNs / 1e6);
+}
+
+int main(int argc, char** argv)
+{
+	int count = Bench::Iterations(argc, argv, 100000);
+
+	RunScene("Shallow", count, 4);
+	RunScene("Deep chains", count, 64);
+	RunScene("Very deep chains", count, 1000);
+
+	return 0;
+}
@@ -27,6 +27,7 @@
 #include "SWAN/GUI/VisualDebugger.hpp"
 
 #include "SWAN/OpenGL/OnGLInit.hpp" // For SWAN::GL::OnGLInit
+#include "SWAN/OpenGL/StreamBuffer.hpp" // For SWAN::GL::detail::lastFrameStreamStats
 
 #include "SWAN/OpenAL/SoundSystem.hpp" // For SWAN::SoundSystem
 
@@ -450,6 +451,9 @@ int main()
 	SWAN::Log("Number of OpenGL VAO deletions: " + std::to_string(SWAN::GL::detail::numDeletions));
 	SWAN::Log("Number of OpenGL VAO bind calls: " + std::to_string(SWAN::GL::detail::numBinds));
 	SWAN::Log("Number of OpenGL VAO draw calls: " + std::to_string(SWAN::GL::detail::numDrawCalls));
+	SWAN::Log("Uniform uploads in the last frame: " + std::to_string(SWAN::GL::detail::lastFrameUniformStats.uploads) +
+	          " (" + std::to_string(SWAN::GL::detail::lastFrameUniformStats.skipped) + " skipped)");
+	SWAN::Log("Vertex data streamed in the last frame: " + std::to_string(SWAN::GL::detail::lastFrameStreamStats.bytes) + " bytes");
 
 	SWAN::Display::Close();
 
@@ -19,8 +19,9 @@
 #include "SWAN/OpenAL/SoundSystem.hpp" // For SWAN::SoundSystem
 
 // ----- Rendering stuff ----- //
-#include "SWAN/Rendering/Camera.hpp"      // For SWAN::Camera
-#include "SWAN/Rendering/DebugRender.hpp" // For SWAN::Render()
+#include "SWAN/Rendering/Camera.hpp"        // For SWAN::Camera
+#include "SWAN/Rendering/DebugRender.hpp"   // For SWAN::Render()
+#include "SWAN/Rendering/FrameUniforms.hpp" // For SWAN::SetFrameUniforms()
 
 // ----- GUI ----- //
 #include "SWAN/GUI/GUIManager.hpp"
@@ -141,17 +142,14 @@ class VoxelLevelEditor : public SWAN::InputFrame
 
 	void Render()
 	{
-		for(const auto& cube : Voxels) {
-			SWAN::Render(*cam, cube);
-		}
+		SWAN::Render(*cam, Voxels);
 		if(wire) {
-			SWAN::Cube wireCube;
-			for(const auto& cube : Voxels) {
-				wireCube = cube;
-				wireCube.transform.scale = { 0.501, 0.501, 0.501 };
-				wireCube.color = { 0, 0, 0, 1 };
-				SWAN::Render(*cam, wireCube, SWAN::DefaultFramebuffer, true);
+			std::vector<SWAN::Cube> wireCubes = Voxels;
+			for(auto& cube : wireCubes) {
+				cube.transform.scale = { 0.501, 0.501, 0.501 };
+				cube.color = { 0, 0, 0, 1 };
 			}
+			SWAN::Render(*cam, wireCubes, SWAN::DefaultFramebuffer, true);
 		}
 		glClear(GL_DEPTH_BUFFER_BIT);
 		SWAN::Render(*cam, SWAN::Cube(SWAN::Transform(CursorPos, {}, { 0.6, 0.6, 0.6 }), { 0.3, 0.3, 1.0, 0.4 }));
@@ -352,6 +350,7 @@ int main()
 	SWAN::GUIManager gui;
 
 	auto prevTime = std::chrono::steady_clock::now();
+	const auto startTime = prevTime;
 	GameRunning = true;
 
 	while(GameRunning) {
@@ -359,6 +358,7 @@ int main()
 		SWAN::UpdateInputEvents();
 
 		if(now - prevTime >= std::chrono::milliseconds{ 16 }) {
+			SWAN::SetFrameUniforms(cam, std::chrono::duration<double>(now - startTime).count());
 			vle.Render();
 			gui.RenderText(0, 0, SWAN::Res::GetBitmapFont("font"),
 			               SWAN::Format("FPS: {}\n{}", fms(now - prevTime).count(),
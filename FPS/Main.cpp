@@ -485,9 +485,7 @@ class VoxelLevelEditor : public SWAN::InputFrame
 
 	void Render()
 	{
-		for(const auto& cube : Voxels) {
-			SWAN::Render(*cam, cube, SWAN::DefaultFramebuffer, wire);
-		}
+		SWAN::Render(*cam, Voxels, SWAN::DefaultFramebuffer, wire);
 		glClear(GL_DEPTH_BUFFER_BIT);
 		SWAN::Render(*cam, SWAN::Cube(SWAN::Transform(CursorPos, {}, { 0.6, 0.6, 0.6 }), { 0.3, 0.3, 1.0, 0.4 }));
 	}
@@ -3,14 +3,24 @@
 
 // ----- Collision detection / Physics ----- //
 #include "SWAN/Core/Defs.hpp"
+#include "SWAN/Physics/AABBTree.hpp"
 #include "SWAN/Physics/Basic.hpp"
+#include "SWAN/Physics/ColliderStore.hpp"
+#include "SWAN/Physics/ContactManifold.hpp"
+#include "SWAN/Physics/ContactSolver.hpp"
+#include "SWAN/Physics/SweepAndPrune.hpp"
+#include "SWAN/Physics/TimeOfImpact.hpp"
+#include "SWAN/Utility/ThreadPool.hpp"
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 
-using FloatSeconds = std::chrono::duration<float, std::chrono::seconds::rep>;
+using FloatSeconds = std::chrono::duration<float>;
 
 enum class ColliderType {
 	Plane,
 	AABB,
+	Sphere,
 };
 
 struct Collider {
@@ -21,11 +31,37 @@ struct Collider {
 	Collider(SWAN::AABB aabb)
 	    : Type(ColliderType::AABB),
 	      AABB(aabb) {}
+	Collider(SWAN::Sphere sphere)
+	    : Type(ColliderType::Sphere),
+	      Sphere(sphere) {}
 
 	ColliderType Type;
 
 	SWAN::Plane Plane;
 	SWAN::AABB AABB;
+	SWAN::Sphere Sphere;
+
+	/// The collider moved by a transform. Planes don't move.
+	Collider ApplyTransform(const SWAN::Transform& t) const
+	{
+		switch(Type) {
+			case ColliderType::AABB: return Collider(AABB.ApplyTransform(t));
+			case ColliderType::Sphere: {
+				SWAN::Sphere s = Sphere;
+				s.ApplyTransform(t);
+				return Collider(s);
+			}
+			default: return *this;
+		}
+	}
+
+	/// The box around the collider, for the broadphase. Planes don't have one.
+	SWAN::AABB GetAABB() const
+	{
+		if(Type == ColliderType::Sphere)
+			return SWAN::AABB(Sphere.center - SWAN::vec3(Sphere.radius), Sphere.center + SWAN::vec3(Sphere.radius));
+		return AABB;
+	}
 };
 
 SWAN::Intersection FindIntersection(const Collider& a, const Collider& b)
@@ -35,15 +71,66 @@ SWAN::Intersection FindIntersection(const Collider& a, const Collider& b)
 			switch(b.Type) {
 				case ColliderType::Plane: return SWAN::FindIntersection(a.Plane, b.Plane);
 				case ColliderType::AABB: return SWAN::FindIntersection(a.Plane, b.AABB);
+				case ColliderType::Sphere: break;
 			}
 			break;
 		case ColliderType::AABB:
 			switch(b.Type) {
 				case ColliderType::Plane: return SWAN::FindIntersection(a.AABB, b.Plane);
 				case ColliderType::AABB: return SWAN::FindIntersection(a.AABB, b.AABB);
+				case ColliderType::Sphere: return SWAN::FindIntersection(a.AABB, b.Sphere);
+			}
+			break;
+		case ColliderType::Sphere:
+			switch(b.Type) {
+				case ColliderType::Plane: break;
+				case ColliderType::AABB: return SWAN::FindIntersection(a.Sphere, b.AABB);
+				case ColliderType::Sphere: return SWAN::FindIntersection(a.Sphere, b.Sphere);
 			}
 			break;
 	}
+	return SWAN::Intersection();
+}
+
+/// Finds the contact between two colliders, with the normal pointing from a to b.
+inline bool FindContact(const Collider& a, const Collider& b, SWAN::ContactManifold& out)
+{
+	// Plane contacts are only found with the plane second.
+	if(a.Type == ColliderType::Plane) {
+		if(b.Type == ColliderType::Plane || !FindContact(b, a, out))
+			return false;
+		out.Flip();
+		return true;
+	}
+
+	switch(b.Type) {
+		case ColliderType::Plane:
+			return a.Type == ColliderType::AABB ? SWAN::FindContact(a.AABB, b.Plane, out) : SWAN::FindContact(a.Sphere, b.Plane, out);
+		case ColliderType::AABB:
+			return a.Type == ColliderType::AABB ? SWAN::FindContact(a.AABB, b.AABB, out) : SWAN::FindContact(a.Sphere, b.AABB, out);
+		case ColliderType::Sphere:
+			return a.Type == ColliderType::AABB ? SWAN::FindContact(a.AABB, b.Sphere, out) : SWAN::FindContact(a.Sphere, b.Sphere, out);
+	}
+	return false;
+}
+
+/// When a box or sphere moving by @p motion first hits another collider, which stays still.
+inline SWAN::TimeOfImpact FindTimeOfImpact(const Collider& moving, SWAN::vec3 motion, const Collider& target)
+{
+	if(moving.Type == ColliderType::AABB) {
+		switch(target.Type) {
+			case ColliderType::Plane: return SWAN::FindTimeOfImpact(moving.AABB, motion, target.Plane);
+			case ColliderType::AABB: return SWAN::FindTimeOfImpact(moving.AABB, motion, target.AABB);
+			case ColliderType::Sphere: return SWAN::FindTimeOfImpact(moving.AABB, motion, target.Sphere);
+		}
+	} else if(moving.Type == ColliderType::Sphere) {
+		switch(target.Type) {
+			case ColliderType::Plane: return SWAN::FindTimeOfImpact(moving.Sphere, motion, target.Plane);
+			case ColliderType::AABB: return SWAN::FindTimeOfImpact(moving.Sphere, motion, target.AABB);
+			case ColliderType::Sphere: return SWAN::FindTimeOfImpact(moving.Sphere, motion, target.Sphere);
+		}
+	}
+	return SWAN::TimeOfImpact();
 }
 
 struct PhysicsObject {
@@ -59,31 +146,67 @@ struct PhysicsObject {
 		Collider.Type = ColliderType::Plane;
 	}
 
+	PhysicsObject(SWAN::Sphere sphere)
+	{
+		Collider.Sphere = sphere;
+		Collider.Type = ColliderType::Sphere;
+	}
+
 	struct Collider Collider;
 	SWAN::Transform Transform;
 	SWAN::vec3 Velocity = { 0, 0, 0 };
 	double Weight = 1;
 
-	inline bool IsImmovable() const { return Collider.Type == ColliderType::Plane; }
+	/// Never moves, like a plane. For level geometry.
+	bool Static = false;
+
+	/// Not simulated until something touches it or BasicPhysicsWorld::Wake() is called.
+	bool Sleeping = false;
+	/// Steps in a row that the object has been slower than BasicPhysicsWorld::SleepVelocity.
+	unsigned StillSteps = 0;
+
+	/// Stops the object at the first immovable or sleeping object in its way, instead of letting it pass
+	/// through when it moves further than its own size in one step. For fast objects like projectiles.
+	bool ContinuousCollision = false;
+
+	inline bool IsImmovable() const { return Static || Collider.Type == ColliderType::Plane; }
 };
 
 SWAN::Intersection FindIntersection(const PhysicsObject& a, const PhysicsObject& b)
 {
-	Collider aCol, bCol;
-	if(a.Collider.Type == ColliderType::AABB)
-		aCol = Collider(a.Collider.AABB.ApplyTransform(a.Transform));
-	else
-		aCol = a.Collider;
-
-	if(b.Collider.Type == ColliderType::AABB)
-		bCol = Collider(b.Collider.AABB.ApplyTransform(b.Transform));
-	else
-		bCol = b.Collider;
-
-	return FindIntersection(aCol, bCol);
+	return FindIntersection(a.Collider.ApplyTransform(a.Transform), b.Collider.ApplyTransform(b.Transform));
 }
 
-struct PhysicsWorld {
+/// A pair of objects whose colliders touch, a < b.
+using Contact = SWAN::ContactCache::Contact;
+
+/**
+ * Steps PhysicsObjects. The broadphase can be SWAN::AABBTree, SWAN::SweepAndPrune or SWAN::ColliderStore.
+ *
+ * Advance() steps with FixedStep and interpolates for rendering, Update() takes a single step.
+ *
+ * Update() runs in stages: integrate, broadphase, narrowphase and resolve. The narrowphase
+ * finds a contact manifold for every touching pair, and the resolve stage runs a sequential
+ * impulse solver that's warm started with the impulses of the same contact points in the
+ * last step (see SWAN::ContactCache), so stacks settle in a few iterations. With a Pool
+ * the narrowphase is split across its threads, and so is the resolve stage, one island
+ * (group of objects touching each other) at a time. Islands share no movable objects and
+ * contacts are resolved in the same order within each one, so the result is the same for
+ * any number of threads.
+ *
+ * Objects with ContinuousCollision are swept: their broadphase box covers their whole motion
+ * in the step, and they're stopped at their time of impact with planes, Static objects and
+ * sleeping ones (found by conservative advancement, see SWAN::FindTimeOfImpact()). Everything
+ * else still takes one discrete step, so only the fast objects pay for it.
+ *
+ * An island whose objects have all been slower than SleepVelocity for SleepSteps steps is
+ * put to sleep as a whole: its objects get no gravity, aren't moved in the broadphase and
+ * pairs of sleeping objects aren't tested. It wakes up as a whole when an awake object
+ * touches one of them, or on Wake() and ApplyImpulse(). Most stages only loop over the
+ * awake objects, so resting debris costs next to nothing.
+ */
+template <typename BroadphaseT>
+struct BasicPhysicsWorld {
 	void AddPhysicsObject(PhysicsObject object)
 	{
 		PhysicsObjects.push_back(object);
@@ -91,39 +214,493 @@ struct PhysicsWorld {
 
 	SWAN::Vector<PhysicsObject> PhysicsObjects;
 
+	/// Threads for the narrowphase and resolve stages. Everything runs on the calling thread if null.
+	SWAN::ThreadPool* Pool = nullptr;
+
+	/// Iterations, friction and penetration correction of the contact solver.
+	SWAN::SolverSettings Solver;
+
+	/// Speed under which an object counts as still.
+	float SleepVelocity = 0.2f;
+
+	/// Steps an island has to stay still before it's put to sleep.
+	unsigned SleepSteps = 30;
+
+	/// Length of one step taken by Advance().
+	FloatSeconds FixedStep{ 1 / 60.0f };
+
+	/// Most steps Advance() takes per call. Time beyond that is dropped, so a slow
+	/// frame can't make the next one slower by leaving even more steps behind.
+	unsigned MaxSubsteps = 5;
+
+	/// Steps the simulation by exactly @p dt.
 	void Update(FloatSeconds dt)
 	{
-		for(auto it = PhysicsObjects.begin(); it != PhysicsObjects.end(); it++) {
-			PhysicsObject& po = *it;
-
-			if(!po.IsImmovable())
-				po.Velocity += SWAN::vec3(0, -9.8, 0) * po.Weight * dt.count();
-
-			for(auto jt = it + 1; jt != PhysicsObjects.end(); jt++) {
-				PhysicsObject& other = *jt;
-				SWAN::Intersection intersection = FindIntersection(po, other);
-
-				if(intersection) {
-					if(po.IsImmovable() && !other.IsImmovable()) {
-						double dot = SWAN::Dot(other.Velocity, po.Collider.Plane.normal);
-						other.Velocity -= po.Collider.Plane.normal * dot;
-					} else if(!po.IsImmovable() && other.IsImmovable()) {
-						double dot = SWAN::Dot(po.Velocity, other.Collider.Plane.normal);
-						po.Velocity -= other.Collider.Plane.normal * dot;
-					} else if(!po.IsImmovable() && !other.IsImmovable()) {
-						SWAN::vec3 vel1 = po.Velocity;
-						SWAN::vec3 vel2 = other.Velocity;
-
-						po.Velocity = other.Velocity = (vel1 * po.Weight + vel2 * other.Weight) / 2.0;
-						// SWAN::Log("Cubes collide");
+		AddNewObjects();
+		Integrate(dt);
+		SyncBroadphase(dt);
+		FindPairs();
+		Narrowphase();
+		BuildIslands();
+		Resolve(dt);
+		UpdateSleep();
+	}
+
+	/**
+	 * Takes as many steps of FixedStep as fit in the time passed since the last call
+	 * (up to MaxSubsteps) and keeps the rest for the next call. Returns the number of steps.
+	 * Use GetInterpolatedTransform() to render objects between the last two steps.
+	 */
+	unsigned Advance(FloatSeconds frameTime)
+	{
+		Accumulator += frameTime;
+
+		unsigned steps = 0;
+		for(; Accumulator >= FixedStep && steps < MaxSubsteps; steps++) {
+			// Sleeping objects don't move, their previous position is set when they fall asleep.
+			for(std::size_t i = PreviousPositions.size(); i < PhysicsObjects.size(); i++)
+				PreviousPositions.push_back(PhysicsObjects[i].Transform.pos);
+			for(std::size_t i : Awake)
+				PreviousPositions[i] = PhysicsObjects[i].Transform.pos;
+
+			Update(FixedStep);
+			Accumulator -= FixedStep;
+		}
+
+		if(Accumulator >= FixedStep)
+			Accumulator = FloatSeconds(std::fmod(Accumulator.count(), FixedStep.count()));
+		return steps;
+	}
+
+	/// How far the time passed is between the last two steps, from 0 to 1.
+	inline float GetInterpolationAlpha() const { return Accumulator / FixedStep; }
+
+	/// The transform of an object between the last two steps taken by Advance(), for rendering.
+	SWAN::Transform GetInterpolatedTransform(std::size_t i) const
+	{
+		SWAN::Transform t = PhysicsObjects[i].Transform;
+		if(i < PreviousPositions.size())
+			t.pos = PreviousPositions[i] + (t.pos - PreviousPositions[i]) * GetInterpolationAlpha();
+		return t;
+	}
+
+	/// Contacts found by the last Update().
+	inline const SWAN::Vector<Contact>& GetContacts() const { return Cache.getContacts(); }
+
+	/// Number of islands in the last Update().
+	inline std::size_t GetIslandCount() const { return IslandStarts.empty() ? 0 : IslandStarts.size() - 1; }
+
+	/// Number of movable objects that aren't sleeping, as of the last Update().
+	inline std::size_t GetAwakeCount() const { return Awake.size(); }
+
+	/// Number of overlapping boxes the broadphase found in the last Update(), including pairs of resting objects.
+	inline std::size_t GetBroadphasePairCount() const { return BroadphasePairs.size(); }
+
+	/// Number of pairs tested by the narrowphase in the last Update().
+	inline std::size_t GetNarrowphaseTestCount() const { return Pairs.size(); }
+
+	/// Wakes up a sleeping object together with the island it fell asleep with.
+	void Wake(std::size_t i)
+	{
+		if(!PhysicsObjects[i].Sleeping)
+			return;
+
+		// Not set up yet, the next Update() adds it as awake.
+		if(i >= Known) {
+			PhysicsObjects[i].Sleeping = false;
+			return;
+		}
+
+		std::size_t j = i;
+		do {
+			std::size_t next = SleepNext[j];
+			PhysicsObjects[j].Sleeping = false;
+			PhysicsObjects[j].StillSteps = 0;
+			SleepNext[j] = j;
+			Awake.push_back(j);
+			j = next;
+		} while(j != i);
+	}
+
+	/// Changes the velocity of an object by @p impulse / Weight and wakes it up.
+	void ApplyImpulse(std::size_t i, SWAN::vec3 impulse)
+	{
+		Wake(i);
+		PhysicsObjects[i].Velocity += impulse / PhysicsObjects[i].Weight;
+		PhysicsObjects[i].StillSteps = 0;
+	}
+
+  private:
+	template <typename Func>
+	void ParallelFor(std::size_t count, std::size_t grainSize, Func func)
+	{
+		if(Pool)
+			Pool->parallelFor(count, grainSize, func);
+		else
+			func(0, count);
+	}
+
+	/// Sets up the objects added since the last step: transforms their colliders and puts everything but planes in the broadphase.
+	void AddNewObjects()
+	{
+		std::size_t n = PhysicsObjects.size();
+		WorldColliders.resize(n);
+		Proxies.resize(n, BroadphaseT::None);
+		SleepNext.resize(n);
+		ObjectIslands.resize(n);
+		Parents.resize(n);
+
+		for(std::size_t i = Known; i < n; i++) {
+			const PhysicsObject& po = PhysicsObjects[i];
+			SleepNext[i] = i;
+			WorldColliders[i] = po.Collider.ApplyTransform(po.Transform);
+			if(po.Collider.Type == ColliderType::Plane) {
+				Planes.push_back(i);
+				continue;
+			}
+
+			Proxies[i] = Broadphase.insert(WorldColliders[i].GetAABB(), i);
+			if(!po.IsImmovable() && !po.Sleeping)
+				Awake.push_back(i);
+		}
+		Known = n;
+	}
+
+	/// Applies gravity to every awake object.
+	void Integrate(FloatSeconds dt)
+	{
+		for(std::size_t i : Awake) {
+			PhysicsObject& po = PhysicsObjects[i];
+			po.Velocity += SWAN::vec3(0, -9.8, 0) * dt.count();
+		}
+	}
+
+	/// Transforms the colliders of awake objects and moves their boxes in the broadphase tree.
+	/// Objects that need continuous collision get the box of their whole motion instead.
+	void SyncBroadphase(FloatSeconds dt)
+	{
+		Sweeping.clear();
+		for(std::size_t i : Awake) {
+			const PhysicsObject& po = PhysicsObjects[i];
+			WorldColliders[i] = po.Collider.ApplyTransform(po.Transform);
+
+			SWAN::vec3 motion = po.Velocity * dt.count();
+			SWAN::AABB box = WorldColliders[i].GetAABB();
+			if(po.ContinuousCollision && IsFast(box, motion)) {
+				Sweeping.push_back(i);
+				box = SWAN::SweptAABB(box, motion);
+			}
+			Broadphase.move(Proxies[i], box, motion);
+		}
+	}
+
+	/// Whether an object can get more than halfway through something in one step. Slower ones are
+	/// always caught overlapping, so the narrowphase is enough.
+	static bool IsFast(const SWAN::AABB& box, SWAN::vec3 motion)
+	{
+		double size = std::min(box.XLen(), std::min(box.YLen(), box.ZLen()));
+		return SWAN::Dot(motion, motion) > size * size / 4;
+	}
+
+	/// Whether the object is immovable or sleeping, pairs of those don't have to be tested.
+	inline bool IsResting(std::size_t i) const { return PhysicsObjects[i].Sleeping || PhysicsObjects[i].IsImmovable(); }
+
+	/// Fills Pairs with the candidate pairs for the narrowphase, sorted and with first < second.
+	void FindPairs()
+	{
+		Broadphase.queryPairs(BroadphasePairs);
+
+		Pairs.clear();
+		for(const auto& p : BroadphasePairs) {
+			std::size_t a = Broadphase.getUserData(p.a), b = Broadphase.getUserData(p.b);
+			if(!IsResting(a) || !IsResting(b))
+				Pairs.emplace_back(std::min(a, b), std::max(a, b));
+		}
+
+		// Planes are unbounded, so they aren't in the tree and are paired with every awake object instead.
+		for(std::size_t i : Planes)
+			for(std::size_t j : Awake)
+				Pairs.emplace_back(std::min(i, j), std::max(i, j));
+
+		std::sort(Pairs.begin(), Pairs.end());
+	}
+
+	/// Finds the manifold of every candidate pair and adds the touching ones to the cache, in the order of Pairs.
+	void Narrowphase()
+	{
+		// Each pair writes its own slot, the contacts are gathered in order afterwards.
+		Hits.resize(Pairs.size());
+		Manifolds.resize(Pairs.size());
+		ParallelFor(Pairs.size(), 256, [this](std::size_t begin, std::size_t end) {
+			for(std::size_t i = begin; i < end; i++)
+				Hits[i] = FindContact(WorldColliders[Pairs[i].first], WorldColliders[Pairs[i].second], Manifolds[i]);
+		});
+
+		Cache.beginStep();
+		for(std::size_t i = 0; i < Pairs.size(); i++)
+			if(Hits[i])
+				Cache.add(Pairs[i].first, Pairs[i].second, Manifolds[i]);
+	}
+
+	std::size_t FindRoot(std::size_t i)
+	{
+		while(Parents[i] != i)
+			i = Parents[i] = Parents[Parents[i]];
+		return i;
+	}
+
+	/// Wakes up sleeping objects touched by awake ones, then groups Contacts by island
+	/// into IslandContacts, keeping their order within each island.
+	void BuildIslands()
+	{
+		const SWAN::Vector<Contact>& contacts = Cache.getContacts();
+
+		// Every contact has an awake object, so the other one is woken up if it's asleep.
+		for(const Contact& c : contacts) {
+			Wake(c.a);
+			Wake(c.b);
+		}
+
+		// Union-find over the contacts between movable objects. Immovable objects are only
+		// read while resolving, so they don't join islands together. Only awake objects
+		// can be in a contact, so only those are reset.
+		for(std::size_t i : Awake) {
+			Parents[i] = i;
+			ObjectIslands[i] = None;
+		}
+		for(const Contact& c : contacts) {
+			if(PhysicsObjects[c.a].IsImmovable() || PhysicsObjects[c.b].IsImmovable())
+				continue;
+			std::size_t a = FindRoot(c.a), b = FindRoot(c.b);
+			if(a != b)
+				Parents[std::max(a, b)] = std::min(a, b);
+		}
+
+		// Islands are numbered in the order of their first contact, then the contacts are bucketed.
+		// The island of the root is kept in the root's entry of ObjectIslands.
+		ContactIslands.resize(contacts.size());
+		IslandStarts.clear();
+		for(std::size_t i = 0; i < contacts.size(); i++) {
+			const Contact& c = contacts[i];
+			std::size_t object = PhysicsObjects[c.a].IsImmovable() ? c.b : c.a;
+			if(PhysicsObjects[object].IsImmovable()) {
+				ContactIslands[i] = None;
+				continue;
+			}
+
+			std::size_t& island = ObjectIslands[FindRoot(object)];
+			if(island == None) {
+				island = IslandStarts.size();
+				IslandStarts.push_back(0);
+			}
+			IslandStarts[island]++;
+			ContactIslands[i] = island;
+		}
+
+		for(const Contact& c : contacts) {
+			if(!PhysicsObjects[c.a].IsImmovable())
+				ObjectIslands[c.a] = ObjectIslands[FindRoot(c.a)];
+			if(!PhysicsObjects[c.b].IsImmovable())
+				ObjectIslands[c.b] = ObjectIslands[FindRoot(c.b)];
+		}
+
+		std::size_t offset = 0;
+		for(std::size_t& start : IslandStarts) {
+			std::size_t size = start;
+			start = offset;
+			offset += size;
+		}
+		IslandStarts.push_back(offset);
+
+		IslandContacts.resize(offset);
+		IslandFill.assign(IslandStarts.begin(), IslandStarts.end() - 1);
+		for(std::size_t i = 0; i < contacts.size(); i++)
+			if(ContactIslands[i] != None)
+				IslandContacts[IslandFill[ContactIslands[i]]++] = i;
+	}
+
+	/// Solves the contacts one island per task, then moves every awake object.
+	void Resolve(FloatSeconds dt)
+	{
+		// Only awake objects and immovable ones can be in a contact. Static objects keep the
+		// body they're given here, their velocity is never written.
+		Bodies.resize(PhysicsObjects.size());
+		for(std::size_t i : Awake) {
+			Bodies[i].velocity = PhysicsObjects[i].Velocity;
+			Bodies[i].inverseMass = 1 / PhysicsObjects[i].Weight;
+		}
+		for(std::size_t i : Planes)
+			Bodies[i] = SWAN::SolverBody();
+
+		SWAN::Vector<Contact>& contacts = Cache.getContacts();
+		ParallelFor(GetIslandCount(), 16, [&](std::size_t begin, std::size_t end) {
+			for(std::size_t island = begin; island < end; island++) {
+				for(std::size_t i = IslandStarts[island]; i < IslandStarts[island + 1]; i++) {
+					Contact& c = contacts[IslandContacts[i]];
+					SWAN::PrepareContact(c.manifold, Bodies[c.a], Bodies[c.b], dt.count(), Solver);
+				}
+
+				for(unsigned iteration = 0; iteration < Solver.iterations; iteration++) {
+					for(std::size_t i = IslandStarts[island]; i < IslandStarts[island + 1]; i++) {
+						Contact& c = contacts[IslandContacts[i]];
+						SWAN::SolveContact(c.manifold, Bodies[c.a], Bodies[c.b], Solver);
 					}
 				}
-				// SWAN::Log(SWAN::Format("Final velocity: {}", other.Velocity * dt.count()));
 			}
+		});
+
+		for(std::size_t i : Awake)
+			PhysicsObjects[i].Velocity = Bodies[i].velocity;
+
+		SweepFastObjects(dt);
+
+		ParallelFor(Awake.size(), 1024, [this, dt](std::size_t begin, std::size_t end) {
+			for(std::size_t i = begin; i < end; i++) {
+				PhysicsObject& po = PhysicsObjects[Awake[i]];
+				po.Transform.pos += po.Velocity * (dt.count() * StepFractions[Awake[i]]);
+			}
+		});
 
-			po.Transform.pos += po.Velocity;
+		// Swept objects stopped at an impact lose their velocity towards what they hit, like in a contact without bounce.
+		for(std::size_t i : Sweeping) {
+			SWAN::vec3& v = PhysicsObjects[i].Velocity;
+			double into = SWAN::Dot(v, ImpactNormals[i]);
+			if(into > 0)
+				v -= ImpactNormals[i] * into;
+			StepFractions[i] = 1;
+			IsSweeping[i] = 0;
 		}
 	}
+
+	/// Finds how much of its motion every swept object can take before it hits an immovable or sleeping
+	/// object. The candidates are the swept object's pairs, the broadphase already used its swept box.
+	void SweepFastObjects(FloatSeconds dt)
+	{
+		std::size_t n = PhysicsObjects.size();
+		StepFractions.resize(n, 1);
+		ImpactNormals.resize(n);
+		IsSweeping.resize(n, 0);
+		if(Sweeping.empty())
+			return;
+
+		for(std::size_t i : Sweeping) {
+			IsSweeping[i] = 1;
+			ImpactNormals[i] = SWAN::vec3(0);
+		}
+
+		auto sweep = [&](std::size_t moving, std::size_t target) {
+			if(!IsSweeping[moving] || !IsResting(target))
+				return;
+
+			SWAN::vec3 motion = PhysicsObjects[moving].Velocity * dt.count();
+			SWAN::TimeOfImpact toi = FindTimeOfImpact(WorldColliders[moving], motion, WorldColliders[target]);
+			if(toi && toi.time < StepFractions[moving]) {
+				StepFractions[moving] = toi.time;
+				ImpactNormals[moving] = toi.normal;
+			}
+		};
+		for(const auto& pair : Pairs) {
+			sweep(pair.first, pair.second);
+			sweep(pair.second, pair.first);
+		}
+	}
+
+	/// Counts how long every awake object has been still, and puts islands that have been still
+	/// long enough to sleep. Objects in the same island are linked through SleepNext so they wake up together.
+	void UpdateSleep()
+	{
+		float limit = SleepVelocity * SleepVelocity;
+		for(std::size_t i : Awake) {
+			PhysicsObject& po = PhysicsObjects[i];
+			if(SWAN::Dot(po.Velocity, po.Velocity) < limit)
+				po.StillSteps++;
+			else
+				po.StillSteps = 0;
+		}
+
+		// An island can only sleep if all of its objects can.
+		IslandStill.assign(GetIslandCount(), 1);
+		for(std::size_t i : Awake)
+			if(ObjectIslands[i] != None && PhysicsObjects[i].StillSteps < SleepSteps)
+				IslandStill[ObjectIslands[i]] = 0;
+
+		IslandSleepers.assign(GetIslandCount(), None);
+		std::size_t kept = 0;
+		for(std::size_t i : Awake) {
+			PhysicsObject& po = PhysicsObjects[i];
+			std::size_t island = ObjectIslands[i];
+			bool sleep = island == None ? po.StillSteps >= SleepSteps : IslandStill[island] != 0;
+			if(!sleep) {
+				Awake[kept++] = i;
+				continue;
+			}
+
+			po.Sleeping = true;
+			po.Velocity = SWAN::vec3(0);
+			if(i < PreviousPositions.size())
+				PreviousPositions[i] = po.Transform.pos;
+
+			// Insert into the island's ring.
+			if(island != None) {
+				std::size_t& first = IslandSleepers[island];
+				if(first == None)
+					first = i;
+				else {
+					SleepNext[i] = SleepNext[first];
+					SleepNext[first] = i;
+				}
+			}
+		}
+		Awake.resize(kept);
+	}
+
+	BroadphaseT Broadphase;
+	SWAN::Vector<typename BroadphaseT::ProxyID> Proxies;
+	SWAN::Vector<Collider> WorldColliders;
+	SWAN::Vector<typename BroadphaseT::Pair> BroadphasePairs;
+	SWAN::Vector<std::pair<std::size_t, std::size_t>> Pairs;
+	SWAN::Vector<unsigned char> Hits;
+	SWAN::Vector<SWAN::ContactManifold> Manifolds;
+	SWAN::ContactCache Cache;
+	SWAN::Vector<SWAN::SolverBody> Bodies;
+
+	/// Awake objects with ContinuousCollision that move far enough this step to need it.
+	SWAN::Vector<std::size_t> Sweeping;
+	/// How much of its motion every object takes this step, 1 unless it's swept and hits something.
+	SWAN::Vector<double> StepFractions;
+	SWAN::Vector<SWAN::vec3> ImpactNormals;
+	SWAN::Vector<unsigned char> IsSweeping;
+
+	static constexpr std::size_t None = ~std::size_t(0);
+
+	/// Number of objects set up by AddNewObjects().
+	std::size_t Known = 0;
+	/// Movable objects that aren't sleeping, and every plane.
+	SWAN::Vector<std::size_t> Awake, Planes;
+	/// Next object in the ring of objects that fell asleep together, or the object itself.
+	SWAN::Vector<std::size_t> SleepNext;
+
+	SWAN::Vector<std::size_t> Parents;
+	/// Island of every awake object in a contact (None if it touches nothing), and of every contact.
+	SWAN::Vector<std::size_t> ObjectIslands, ContactIslands;
+	/// Indices into Contacts grouped by island, island i is [IslandStarts[i], IslandStarts[i + 1]).
+	SWAN::Vector<std::size_t> IslandContacts, IslandStarts, IslandFill;
+	SWAN::Vector<unsigned char> IslandStill;
+	SWAN::Vector<std::size_t> IslandSleepers;
+
+	/// Time passed that hasn't been stepped yet.
+	FloatSeconds Accumulator{ 0 };
+	/// Positions before the last step taken by Advance().
+	SWAN::Vector<SWAN::vec3> PreviousPositions;
 };
 
+template <typename BroadphaseT>
+constexpr std::size_t BasicPhysicsWorld<BroadphaseT>::None;
+
+using PhysicsWorld = BasicPhysicsWorld<SWAN::AABBTree>;
+/// Better suited to scenes where most objects barely move between steps.
+using SAPPhysicsWorld = BasicPhysicsWorld<SWAN::SweepAndPrune>;
+/// Brute force over packed boxes with SIMD tests, fastest for small scenes.
+using SoAPhysicsWorld = BasicPhysicsWorld<SWAN::ColliderStore>;
+
 #endif
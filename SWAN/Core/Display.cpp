@@ -7,6 +7,8 @@
 #include <glad/glad.h>
 
 #include "OpenGL/OnGLInit.hpp"
+#include "OpenGL/StreamBuffer.hpp"
+#include "Rendering/Shader.hpp"
 
 namespace SWAN
 {
@@ -124,6 +126,8 @@ namespace SWAN
 		{
 			SDL_GL_SwapWindow(detail::window);
 			glClear(GL_COLOR_BUFFER_BIT);
+			GL::detail::EndUniformFrame();
+			GL::detail::EndStreamFrame();
 		}
 
 		void Close()
@@ -5,26 +5,29 @@
 #include "Core/Logging.hpp"
 #include "Maths/Vector.hpp"
 #include "OpenGL/OnGLInit.hpp"
+#include "OpenGL/StreamBuffer.hpp"
+#include "Rendering/FrameUniforms.hpp"
 #include "Rendering/Shader.hpp"
 
 static const char* GUIVertSrc = R"ddd(
-#version 130
-
+#version 140
+)ddd" SWAN_FRAME_BLOCK_GLSL R"ddd(
 in vec2 pos;
 in vec4 color;
 
 out vec4 col;
 
-uniform mat4 viewProj;
+// Where the GUI camera is moved to, the GUI is drawn that much the other way.
+uniform vec2 cameraPos;
 
 void main() {
-    gl_Position = viewProj * vec4(pos.x, pos.y, 0, 1);
+    gl_Position = screen * vec4(pos - cameraPos, 0, 1);
     col = color;
 }
 )ddd";
 
 static const char* GUIFragSrc = R"ddd(
-#version 130
+#version 140
 
 in vec4 col;
 out vec4 fCol;
@@ -41,9 +44,10 @@ static SWAN::OnGLInit _ = {
 	    GUIShader.addAttrib("pos");
 	    GUIShader.addAttrib("color");
 	    GUIShader.linkShaders();
+	    GUIShader.bindUniformBlock("Frame", SWAN::UniformBlockBinding::Frame);
 
 	    GUIShader.use();
-	    GUIShader.addUniform("viewProj");
+	    GUIShader.addUniform("cameraPos");
 	}
 };
 
@@ -192,7 +196,9 @@ namespace SWAN
 	                            vec4 color)
 	{
 		this->text.font = font;
-		this->text = text;
+		this->text.streamed = true;
+		this->text.text = text;
+		this->text.updateVAO();
 		this->text.render(x, y, color);
 	}
 
@@ -201,7 +207,8 @@ namespace SWAN
 	                                   Rect2D clip, vec4 color)
 	{
 		this->text.font = font;
-		this->text = text;
+		this->text.streamed = true;
+		this->text.text = text;
 		this->text.RenderClipped(x, y, clip, color);
 	}
 
@@ -267,14 +274,21 @@ namespace SWAN
 			                                j * 4 + 2, j * 4 + 1, j * 4 + 3 });
 			i++;
 		}
+		if(indices.empty())
+			return;
+
+		std::size_t pointBytes = points.size() * sizeof(fvec2), colorBytes = colors.size() * sizeof(fvec4),
+		            indexBytes = indices.size() * sizeof(unsigned);
+		GL::GetVertexStream().reserve({ pointBytes, colorBytes, indexBytes });
 
 		vao.bind();
-		vao.storeAttribData(0, 2, (float*) points.data(), points.size() * sizeof(fvec2));
-		vao.storeAttribData(1, 4, (float*) colors.data(), colors.size() * sizeof(fvec4));
-		vao.storeIndices(indices.data(), indices.size() * sizeof(unsigned));
+		vao.streamAttribData(0, 2, (float*) points.data(), pointBytes);
+		vao.streamAttribData(1, 4, (float*) colors.data(), colorBytes);
+		vao.streamIndices(indices.data(), indexBytes);
 
 		GUIShader.use();
-		GUIShader.SetMat4("viewProj", cam.getPerspective() * cam.getView());
-		vao.draw(rects.size() * 6, GL_TRIANGLES);
+		detail::UseFrameScreen();
+		GUIShader.SetVec2("cameraPos", vec2(cam.pos().x, cam.pos().y));
+		vao.draw(indices.size(), GL_TRIANGLES);
 	}
 } // namespace SWAN
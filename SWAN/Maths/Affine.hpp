@@ -0,0 +1,165 @@
+#ifndef SWAN_AFFINE_HPP
+#define SWAN_AFFINE_HPP
+
+#include "../Utility/CxArray.hpp" // For SWAN::Util::CxArray<T, N>
+
+#include "Matrix.hpp" // For SWAN::mat4
+#include "SIMD.hpp"   // For SWAN_SIMD_SSE
+#include "Vector.hpp" // For SWAN::vec3
+
+namespace SWAN
+{
+	/**
+	 * @brief An affine transformation: a mat4 whose last row is always (0, 0, 0, 1).
+	 *
+	 * Only the first three rows are stored, with the same layout as mat4
+	 * (row-major, translation in column 3), so converting either way is a copy.
+	 * Products and inverses skip the work involving the implicit last row.
+	 */
+	struct alignas(16) affine3x4 {
+		constexpr affine3x4() : data({ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0 }) {}
+		constexpr affine3x4(float a, float b, float c, float d,
+		                    float e, float f, float g, float h,
+		                    float i, float j, float k, float l)
+		    : data({ a, b, c, d, e, f, g, h, i, j, k, l }) {}
+
+		/// Drops the last row of @p m, which must be (0, 0, 0, 1).
+		explicit constexpr affine3x4(const mat4& m)
+		    : data({ m(0, 0), m(1, 0), m(2, 0), m(3, 0),
+		             m(0, 1), m(1, 1), m(2, 1), m(3, 1),
+		             m(0, 2), m(1, 2), m(2, 2), m(3, 2) }) {}
+
+		Util::CxArray<float, 12> data;
+		constexpr float& operator()(int x, int y) { return data[x + y * 4]; }
+		constexpr float operator()(int x, int y) const { return data[x + y * 4]; }
+
+		constexpr float& get(int x, int y) { return data[x + y * 4]; }
+		constexpr float get(int x, int y) const { return data[x + y * 4]; }
+
+		/// Where the i-th axis points to (i < 3), or the translation (i == 3).
+		constexpr vec3 column(int i) const { return vec3(get(i, 0), get(i, 1), get(i, 2)); }
+	};
+
+	/// Appends the implicit (0, 0, 0, 1) row.
+	constexpr mat4 ToMat4(const affine3x4& a)
+	{
+		return mat4(a(0, 0), a(1, 0), a(2, 0), a(3, 0),
+		            a(0, 1), a(1, 1), a(2, 1), a(3, 1),
+		            a(0, 2), a(1, 2), a(2, 2), a(3, 2),
+		            0, 0, 0, 1);
+	}
+
+	/// Translate(pos) * rot * Scale(scale), without the two matrix products. Only the 3x3 part of @p rot is used.
+	template <typename T>
+	constexpr affine3x4 ComposeAffine(const tvec3<T>& pos, const mat4& rot, const tvec3<T>& scale)
+	{
+		return affine3x4(rot(0, 0) * scale.x, rot(1, 0) * scale.y, rot(2, 0) * scale.z, pos.x,
+		                 rot(0, 1) * scale.x, rot(1, 1) * scale.y, rot(2, 1) * scale.z, pos.y,
+		                 rot(0, 2) * scale.x, rot(1, 2) * scale.y, rot(2, 2) * scale.z, pos.z);
+	}
+
+	/**
+	 * @brief Composes two affine transformations, b is applied first.
+	 *
+	 * 27 multiply-adds for the 3x3 part and 9 for the translation, instead of the 64 of a mat4 product.
+	 */
+	inline affine3x4 operator*(const affine3x4& a, const affine3x4& b)
+	{
+		affine3x4 res;
+#if defined(SWAN_SIMD_SSE)
+		const float* bd = b.data.data();
+		__m128 b0 = _mm_load_ps(bd + 0), b1 = _mm_load_ps(bd + 4), b2 = _mm_load_ps(bd + 8);
+		// The implicit last row of b only adds a's own translation.
+		const __m128 wMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+		for(int y = 0; y < 3; y++) {
+			__m128 row = _mm_load_ps(a.data.data() + y * 4);
+			__m128 r = _mm_and_ps(row, wMask);
+			r = _mm_add_ps(r, _mm_mul_ps(SWAN_SPLAT(row, 0), b0));
+			r = _mm_add_ps(r, _mm_mul_ps(SWAN_SPLAT(row, 1), b1));
+			r = _mm_add_ps(r, _mm_mul_ps(SWAN_SPLAT(row, 2), b2));
+			_mm_store_ps(res.data.data() + y * 4, r);
+		}
+#else
+		for(int y = 0; y < 3; y++) {
+			for(int x = 0; x < 4; x++)
+				res(x, y) = a(0, y) * b(x, 0) + a(1, y) * b(x, 1) + a(2, y) * b(x, 2);
+			res(3, y) += a(3, y);
+		}
+#endif
+		return res;
+	}
+
+	/// Transforms a point, i.e. applies the translation.
+	template <typename T>
+	constexpr tvec3<T> TransformPoint(const affine3x4& a, const tvec3<T>& p)
+	{
+		return tvec3<T>(a(0, 0) * p.x + a(1, 0) * p.y + a(2, 0) * p.z + a(3, 0),
+		                a(0, 1) * p.x + a(1, 1) * p.y + a(2, 1) * p.z + a(3, 1),
+		                a(0, 2) * p.x + a(1, 2) * p.y + a(2, 2) * p.z + a(3, 2));
+	}
+
+	/// Transforms a direction, i.e. ignores the translation.
+	template <typename T>
+	constexpr tvec3<T> TransformDirection(const affine3x4& a, const tvec3<T>& d)
+	{
+		return tvec3<T>(a(0, 0) * d.x + a(1, 0) * d.y + a(2, 0) * d.z,
+		                a(0, 1) * d.x + a(1, 1) * d.y + a(2, 1) * d.z,
+		                a(0, 2) * d.x + a(1, 2) * d.y + a(2, 2) * d.z);
+	}
+
+	/**
+	 * @brief Inverts a rotation + translation: transposes the rotation and rotates the translation back.
+	 *
+	 * @note The 3x3 part must be orthonormal (no scale or shear), use Inverse() otherwise.
+	 */
+	constexpr affine3x4 InverseRigid(const affine3x4& a)
+	{
+		return affine3x4(a(0, 0), a(0, 1), a(0, 2), -(a(0, 0) * a(3, 0) + a(0, 1) * a(3, 1) + a(0, 2) * a(3, 2)),
+		                 a(1, 0), a(1, 1), a(1, 2), -(a(1, 0) * a(3, 0) + a(1, 1) * a(3, 1) + a(1, 2) * a(3, 2)),
+		                 a(2, 0), a(2, 1), a(2, 2), -(a(2, 0) * a(3, 0) + a(2, 1) * a(3, 1) + a(2, 2) * a(3, 2)));
+	}
+
+	/// Inverts any affine transformation, including scale and shear. Returns the identity if it isn't invertible.
+	inline affine3x4 Inverse(const affine3x4& a)
+	{
+#if defined(SWAN_SIMD_SSE)
+		// Same layout as the first three rows of a mat4.
+		affine3x4 res;
+		if(!detail::InverseAffineRowsSSE(a.data.data(), res.data.data()))
+			return {};
+		return res;
+#else
+		// The rows of the inverted 3x3 part are cross products of its columns, divided by the determinant.
+		vec3 c0 = a.column(0), c1 = a.column(1), c2 = a.column(2);
+		vec3 r0 = Cross(c1, c2), r1 = Cross(c2, c0), r2 = Cross(c0, c1);
+		double det = Dot(c0, r0);
+		if(det == 0)
+			return {};
+
+		double inv = 1.0 / det;
+		r0 *= inv;
+		r1 *= inv;
+		r2 *= inv;
+		vec3 t = a.column(3);
+
+		return affine3x4(r0.x, r0.y, r0.z, -Dot(r0, t),
+		                 r1.x, r1.y, r1.z, -Dot(r1, t),
+		                 r2.x, r2.y, r2.z, -Dot(r2, t));
+#endif
+	}
+
+	/// Same as LookAt(), without the implicit last row.
+	inline affine3x4 LookAtAffine(vec3 eye, vec3 center, vec3 up)
+	{
+		const vec3 f(Normalized(center - eye));
+		const vec3 s(Normalized(Cross(up, f)));
+		const vec3 u(Cross(f, s));
+
+		return affine3x4(s.x, s.y, s.z, -Dot(s, eye),
+		                 u.x, u.y, u.z, -Dot(u, eye),
+		                 -f.x, -f.y, -f.z, Dot(f, eye));
+	}
+} // namespace SWAN
+
+#endif
@@ -6,6 +6,7 @@
 #include <algorithm> // For std::swap(a, b)
 #include <array>     // For std::array<T, N>
 
+#include "SIMD.hpp"   // For SWAN_SIMD_SSE, SWAN_SIMD_AVX
 #include "Vector.hpp" // For SWAN::vec{2,3,4}
 
 namespace SWAN {
@@ -42,7 +43,8 @@ namespace SWAN {
 
 	constexpr operator mat2() { return mat2(get(0, 0), get(1, 0), get(0, 1), get(1, 1)); }
     };
-    struct mat4 {
+    /// Row-major 4x4 matrix. Aligned so that each row can be loaded into one SSE register.
+    struct alignas(16) mat4 {
 	constexpr mat4() : data({ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 }) {}
 	explicit constexpr mat4(float v) : data({ v, 0, 0, 0, 0, v, 0, 0, 0, 0, v, 0, 0, 0, 0, v }) {}
 	constexpr mat4(float a, float b, float c, float d,
@@ -85,11 +87,12 @@ namespace SWAN {
 
     constexpr mat2 operator*(const mat2& a, const mat2& b);
     constexpr mat3 operator*(const mat3& a, const mat3& b);
-    constexpr mat4 operator*(const mat4& a, const mat4& b);
+    inline mat4 operator*(const mat4& a, const mat4& b);
 
     constexpr mat2 Inverse(const mat2& m);
     constexpr mat3 Inverse(const mat3& m);
-    constexpr mat4 Inverse(const mat4& m);
+    inline mat4 Inverse(const mat4& m);
+    inline mat4 InverseAffine(const mat4& m);
 
     constexpr ivec2 operator*(ivec2 v, const mat2& m);
     constexpr ivec3 operator*(ivec3 v, const mat3& m);
@@ -101,7 +104,7 @@ namespace SWAN {
 
     constexpr mat2 Transpose(const mat2& m);
     constexpr mat3 Transpose(const mat3& m);
-    constexpr mat4 Transpose(const mat4& m);
+    inline mat4 Transpose(const mat4& m);
 
     constexpr double Determinant(const mat2& m);
     constexpr double Determinant(const mat3& m);
@@ -243,7 +246,21 @@ namespace SWAN {
 	return res;
     }
 
-    constexpr mat4 Transpose(const mat4& m) {
+    inline mat4 Transpose(const mat4& m) {
+#if defined(SWAN_SIMD_SSE)
+	__m128 r0 = _mm_loadu_ps(m.data.data() + 0);
+	__m128 r1 = _mm_loadu_ps(m.data.data() + 4);
+	__m128 r2 = _mm_loadu_ps(m.data.data() + 8);
+	__m128 r3 = _mm_loadu_ps(m.data.data() + 12);
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+
+	mat4 res;
+	_mm_storeu_ps(res.data.data() + 0, r0);
+	_mm_storeu_ps(res.data.data() + 4, r1);
+	_mm_storeu_ps(res.data.data() + 8, r2);
+	_mm_storeu_ps(res.data.data() + 12, r3);
+	return res;
+#else
 	mat4 res = m;
 	Swap(res(1, 0), res(0, 1));
 	Swap(res(2, 0), res(0, 2));
@@ -252,6 +269,7 @@ namespace SWAN {
 	Swap(res(3, 1), res(1, 3));
 	Swap(res(3, 2), res(2, 3));
 	return res;
+#endif
     }
 
     constexpr double Determinant(const mat2& m) { return m(0, 0) * m(1, 1) - m(1, 0) * m(0, 1); }
@@ -342,8 +360,86 @@ namespace SWAN {
     constexpr mat3 operator*(const mat3& a, const mat3& b) {
 	return _DoMult<mat3, 3>(a, b);
     }
-    constexpr mat4 operator*(const mat4& a, const mat4& b) {
-	return _DoMult<mat4, 4>(a, b);
+
+    namespace detail {
+	/// Scalar mat4 product. Accumulates in double, same as _DoMult().
+	inline mat4 Mul4x4Scalar(const mat4& a, const mat4& b) {
+	    mat4 res;
+	    for(int y = 0; y < 4; y++) {
+		for(int x = 0; x < 4; x++) {
+		    double sum = 0;
+		    for(int i = 0; i < 4; i++)
+			sum += (double) a(i, y) * b(x, i);
+		    res(x, y) = sum;
+		}
+	    }
+	    return res;
+	}
+
+#if defined(SWAN_SIMD_SSE)
+	/// Row y of a*b is the sum of b's rows, weighted by the elements of a's row y.
+	inline __m128 MulRow(const float* aRow, __m128 b0, __m128 b1, __m128 b2, __m128 b3) {
+	    __m128 r = _mm_mul_ps(_mm_set1_ps(aRow[0]), b0);
+	    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(aRow[1]), b1));
+	    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(aRow[2]), b2));
+	    r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(aRow[3]), b3));
+	    return r;
+	}
+#endif
+
+#if defined(SWAN_SIMD_AVX)
+	/// Same as MulRow(), but computes two rows of a*b at once.
+	inline __m256 MulTwoRows(const float* aRows, __m256 b0, __m256 b1, __m256 b2, __m256 b3) {
+	    __m256 a = _mm256_loadu_ps(aRows);
+	    __m256 r = _mm256_mul_ps(_mm256_shuffle_ps(a, a, SWAN_SHUFFLE_MASK(0, 0, 0, 0)), b0);
+	    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, SWAN_SHUFFLE_MASK(1, 1, 1, 1)), b1));
+	    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, SWAN_SHUFFLE_MASK(2, 2, 2, 2)), b2));
+	    r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_shuffle_ps(a, a, SWAN_SHUFFLE_MASK(3, 3, 3, 3)), b3));
+	    return r;
+	}
+#endif
+
+	/// mat4 product using the widest instruction set available.
+	inline mat4 Mul4x4(const mat4& a, const mat4& b) {
+#if defined(SWAN_SIMD_AVX)
+	    const float* bd = b.data.data();
+	    __m256 b0 = _mm256_broadcast_ps((const __m128*) (bd + 0));
+	    __m256 b1 = _mm256_broadcast_ps((const __m128*) (bd + 4));
+	    __m256 b2 = _mm256_broadcast_ps((const __m128*) (bd + 8));
+	    __m256 b3 = _mm256_broadcast_ps((const __m128*) (bd + 12));
+
+	    mat4 res;
+	    _mm256_storeu_ps(res.data.data() + 0, MulTwoRows(a.data.data() + 0, b0, b1, b2, b3));
+	    _mm256_storeu_ps(res.data.data() + 8, MulTwoRows(a.data.data() + 8, b0, b1, b2, b3));
+	    return res;
+#elif defined(SWAN_SIMD_SSE)
+	    const float* bd = b.data.data();
+	    __m128 b0 = _mm_loadu_ps(bd + 0);
+	    __m128 b1 = _mm_loadu_ps(bd + 4);
+	    __m128 b2 = _mm_loadu_ps(bd + 8);
+	    __m128 b3 = _mm_loadu_ps(bd + 12);
+
+	    mat4 res;
+	    for(int y = 0; y < 4; y++)
+		_mm_storeu_ps(res.data.data() + y * 4, MulRow(a.data.data() + y * 4, b0, b1, b2, b3));
+	    return res;
+#else
+	    return Mul4x4Scalar(a, b);
+#endif
+	}
+    } // namespace detail
+
+    /**
+     * @brief Multiplies two 4x4 matrices.
+     *
+     * @note The SIMD paths accumulate in float instead of double. Every element of the
+     *       result differs from the scalar path by less than 5 ULPs of sum(|a(i, y) * b(x, i)|).
+     *       The error can't be bounded in ULPs of the element itself, since the products
+     *       can cancel out to an arbitrarily small result.
+     *       _DoMult<mat4, 4>() is still available where a constexpr product is needed.
+     */
+    inline mat4 operator*(const mat4& a, const mat4& b) {
+	return detail::Mul4x4(a, b);
     }
 
     constexpr mat2 Inverse(const mat2& m) {
@@ -376,10 +472,11 @@ namespace SWAN {
 	mat3 tmp;
 	for(int y = 0; y < 4; y++) {
 	    for(int x = 0; x < 4; x++) {
-		int xNext = 0, yNext = 0;
+		int yNext = 0;
 		for(int yy = 0; yy < 4; yy++) {
 		    if(yy == y)
 			continue;
+		    int xNext = 0;
 		    for(int xx = 0; xx < 4; xx++) {
 			if(xx == x)
 			    continue;
@@ -394,24 +491,257 @@ namespace SWAN {
 
 	return res;
     }
-    constexpr mat4 Inverse(const mat4& m) {
+    /// Minors-based inverse. Slow, kept as a constexpr reference for Inverse(const mat4&).
+    constexpr mat4 _InverseByMinors(const mat4& m) {
 	if(Determinant(m) == 0)
 	    return {};
 
-	mat4 res = _GetMinor(m);
+	mat4 minors = _GetMinor(m);
 
+	// Adjugate: transposed matrix of cofactors.
+	mat4 res;
 	for(int y = 0; y < 4; y++) {
 	    for(int x = 0; x < 4; x++) {
-		if(x + y % 2)
-		    res(x, y) = -res(x, y);
+		res(y, x) = (x + y) % 2 ? -minors(x, y) : minors(x, y);
 	    }
 	}
 
-	res = Transpose(res);
-
 	return res * (1.0 / Determinant(m));
     }
 
+    namespace detail {
+	/// Cofactor expansion that shares the 2x2 sub-determinants between all 16 cofactors.
+	inline mat4 InverseScalar(const mat4& m) {
+	    const float* a = m.data.data();
+
+	    double s0 = (double) a[0] * a[5] - (double) a[4] * a[1];
+	    double s1 = (double) a[0] * a[6] - (double) a[4] * a[2];
+	    double s2 = (double) a[0] * a[7] - (double) a[4] * a[3];
+	    double s3 = (double) a[1] * a[6] - (double) a[5] * a[2];
+	    double s4 = (double) a[1] * a[7] - (double) a[5] * a[3];
+	    double s5 = (double) a[2] * a[7] - (double) a[6] * a[3];
+
+	    double c5 = (double) a[10] * a[15] - (double) a[14] * a[11];
+	    double c4 = (double) a[9] * a[15] - (double) a[13] * a[11];
+	    double c3 = (double) a[9] * a[14] - (double) a[13] * a[10];
+	    double c2 = (double) a[8] * a[15] - (double) a[12] * a[11];
+	    double c1 = (double) a[8] * a[14] - (double) a[12] * a[10];
+	    double c0 = (double) a[8] * a[13] - (double) a[12] * a[9];
+
+	    double det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	    if(det == 0)
+		return {};
+
+	    double inv = 1.0 / det;
+
+	    mat4 res;
+	    float* r = res.data.data();
+	    r[0] = (a[5] * c5 - a[6] * c4 + a[7] * c3) * inv;
+	    r[1] = (-a[1] * c5 + a[2] * c4 - a[3] * c3) * inv;
+	    r[2] = (a[13] * s5 - a[14] * s4 + a[15] * s3) * inv;
+	    r[3] = (-a[9] * s5 + a[10] * s4 - a[11] * s3) * inv;
+
+	    r[4] = (-a[4] * c5 + a[6] * c2 - a[7] * c1) * inv;
+	    r[5] = (a[0] * c5 - a[2] * c2 + a[3] * c1) * inv;
+	    r[6] = (-a[12] * s5 + a[14] * s2 - a[15] * s1) * inv;
+	    r[7] = (a[8] * s5 - a[10] * s2 + a[11] * s1) * inv;
+
+	    r[8] = (a[4] * c4 - a[5] * c2 + a[7] * c0) * inv;
+	    r[9] = (-a[0] * c4 + a[1] * c2 - a[3] * c0) * inv;
+	    r[10] = (a[12] * s4 - a[13] * s2 + a[15] * s0) * inv;
+	    r[11] = (-a[8] * s4 + a[9] * s2 - a[11] * s0) * inv;
+
+	    r[12] = (-a[4] * c3 + a[5] * c1 - a[6] * c0) * inv;
+	    r[13] = (a[0] * c3 - a[1] * c1 + a[2] * c0) * inv;
+	    r[14] = (-a[12] * s3 + a[13] * s1 - a[14] * s0) * inv;
+	    r[15] = (a[8] * s3 - a[9] * s1 + a[10] * s0) * inv;
+
+	    return res;
+	}
+
+	/// Inverse of a matrix whose last row is (0, 0, 0, 1): the 3x3 part is inverted
+	/// with cross products and the translation is rotated back by it.
+	inline mat4 InverseAffineScalar(const mat4& m) {
+	    vec3 r0(m(0, 0), m(1, 0), m(2, 0));
+	    vec3 r1(m(0, 1), m(1, 1), m(2, 1));
+	    vec3 r2(m(0, 2), m(1, 2), m(2, 2));
+	    vec3 t(m(3, 0), m(3, 1), m(3, 2));
+
+	    vec3 c0 = Cross(r1, r2), c1 = Cross(r2, r0), c2 = Cross(r0, r1);
+	    double det = Dot(r0, c0);
+	    if(det == 0)
+		return {};
+
+	    double inv = 1.0 / det;
+	    c0 *= inv;
+	    c1 *= inv;
+	    c2 *= inv;
+	    vec3 it = -(c0 * t.x + c1 * t.y + c2 * t.z);
+
+	    return mat4(c0.x, c1.x, c2.x, it.x,
+			c0.y, c1.y, c2.y, it.y,
+			c0.z, c1.z, c2.z, it.z,
+			0, 0, 0, 1);
+	}
+
+#if defined(SWAN_SIMD_SSE)
+	// 2x2 helpers for the block-wise inverse below. A 2x2 matrix is
+	// stored row-major in one register: (m00, m01, m10, m11).
+
+	/// a * b
+	inline __m128 Mat2Mul(__m128 a, __m128 b) {
+	    return _mm_add_ps(_mm_mul_ps(a, SWAN_SWIZZLE(b, 0, 3, 0, 3)),
+			      _mm_mul_ps(SWAN_SWIZZLE(a, 1, 0, 3, 2), SWAN_SWIZZLE(b, 2, 1, 2, 1)));
+	}
+	/// adj(a) * b
+	inline __m128 Mat2AdjMul(__m128 a, __m128 b) {
+	    return _mm_sub_ps(_mm_mul_ps(SWAN_SWIZZLE(a, 3, 3, 0, 0), b),
+			      _mm_mul_ps(SWAN_SWIZZLE(a, 1, 1, 2, 2), SWAN_SWIZZLE(b, 2, 3, 0, 1)));
+	}
+	/// a * adj(b)
+	inline __m128 Mat2MulAdj(__m128 a, __m128 b) {
+	    return _mm_sub_ps(_mm_mul_ps(a, SWAN_SWIZZLE(b, 3, 0, 3, 0)),
+			      _mm_mul_ps(SWAN_SWIZZLE(a, 1, 0, 3, 2), SWAN_SWIZZLE(b, 2, 1, 2, 1)));
+	}
+
+	/// Block-wise inverse: the matrix is split into four 2x2 blocks,
+	/// so that every cofactor comes out of 2x2 products.
+	inline mat4 InverseSSE(const mat4& m) {
+	    const float* d = m.data.data();
+	    __m128 r0 = _mm_loadu_ps(d + 0), r1 = _mm_loadu_ps(d + 4),
+		   r2 = _mm_loadu_ps(d + 8), r3 = _mm_loadu_ps(d + 12);
+
+	    __m128 A = _mm_movelh_ps(r0, r1);
+	    __m128 B = _mm_movehl_ps(r1, r0);
+	    __m128 C = _mm_movelh_ps(r2, r3);
+	    __m128 D = _mm_movehl_ps(r3, r2);
+
+	    // (|A|, |B|, |C|, |D|)
+	    __m128 detSub = _mm_sub_ps(
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, SWAN_SHUFFLE_MASK(0, 2, 0, 2)),
+			   _mm_shuffle_ps(r1, r3, SWAN_SHUFFLE_MASK(1, 3, 1, 3))),
+		_mm_mul_ps(_mm_shuffle_ps(r0, r2, SWAN_SHUFFLE_MASK(1, 3, 1, 3)),
+			   _mm_shuffle_ps(r1, r3, SWAN_SHUFFLE_MASK(0, 2, 0, 2))));
+	    __m128 detA = SWAN_SPLAT(detSub, 0);
+	    __m128 detB = SWAN_SPLAT(detSub, 1);
+	    __m128 detC = SWAN_SPLAT(detSub, 2);
+	    __m128 detD = SWAN_SPLAT(detSub, 3);
+
+	    __m128 DC = Mat2AdjMul(D, C);
+	    __m128 AB = Mat2AdjMul(A, B);
+
+	    __m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, DC));
+	    __m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, AB));
+	    __m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, AB));
+	    __m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, DC));
+
+	    // |M| = |A||D| + |B||C| - tr(adj(A)B * adj(D)C)
+	    __m128 tr = _mm_mul_ps(AB, SWAN_SWIZZLE(DC, 0, 2, 1, 3));
+	    tr = _mm_add_ps(tr, SWAN_SWIZZLE(tr, 1, 0, 3, 2));
+	    tr = _mm_add_ps(tr, SWAN_SWIZZLE(tr, 2, 3, 0, 1));
+	    __m128 detM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(detA, detD), _mm_mul_ps(detB, detC)), tr);
+
+	    if(_mm_cvtss_f32(detM) == 0)
+		return {};
+
+	    __m128 rDetM = _mm_div_ps(_mm_setr_ps(1, -1, -1, 1), detM);
+	    X = _mm_mul_ps(X, rDetM);
+	    Y = _mm_mul_ps(Y, rDetM);
+	    Z = _mm_mul_ps(Z, rDetM);
+	    W = _mm_mul_ps(W, rDetM);
+
+	    mat4 res;
+	    float* r = res.data.data();
+	    _mm_storeu_ps(r + 0, _mm_shuffle_ps(X, Y, SWAN_SHUFFLE_MASK(3, 1, 3, 1)));
+	    _mm_storeu_ps(r + 4, _mm_shuffle_ps(X, Y, SWAN_SHUFFLE_MASK(2, 0, 2, 0)));
+	    _mm_storeu_ps(r + 8, _mm_shuffle_ps(Z, W, SWAN_SHUFFLE_MASK(3, 1, 3, 1)));
+	    _mm_storeu_ps(r + 12, _mm_shuffle_ps(Z, W, SWAN_SHUFFLE_MASK(2, 0, 2, 0)));
+	    return res;
+	}
+
+	/// Cross product of the xyz lanes of two registers, w comes out as 0.
+	inline __m128 Cross3(__m128 a, __m128 b) {
+	    __m128 c = _mm_sub_ps(_mm_mul_ps(a, SWAN_SWIZZLE(b, 1, 2, 0, 3)),
+				  _mm_mul_ps(SWAN_SWIZZLE(a, 1, 2, 0, 3), b));
+	    return SWAN_SWIZZLE(c, 1, 2, 0, 3);
+	}
+
+	/// SSE version of InverseAffineScalar(), working on the first three rows only.
+	/// Writes the three rows of the result to @p r, returns false if @p d isn't invertible.
+	inline bool InverseAffineRowsSSE(const float* d, float* r) {
+	    const __m128 xyzMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+
+	    __m128 r0 = _mm_loadu_ps(d + 0), r1 = _mm_loadu_ps(d + 4), r2 = _mm_loadu_ps(d + 8);
+	    __m128 t = _mm_setr_ps(d[3], d[7], d[11], 0);
+	    r0 = _mm_and_ps(r0, xyzMask);
+	    r1 = _mm_and_ps(r1, xyzMask);
+	    r2 = _mm_and_ps(r2, xyzMask);
+
+	    __m128 c0 = Cross3(r1, r2), c1 = Cross3(r2, r0), c2 = Cross3(r0, r1);
+
+	    __m128 det = _mm_mul_ps(r0, c0);
+	    det = _mm_add_ps(det, SWAN_SWIZZLE(det, 1, 0, 3, 2));
+	    det = _mm_add_ps(det, SWAN_SWIZZLE(det, 2, 3, 0, 1));
+	    if(_mm_cvtss_f32(det) == 0)
+		return false;
+
+	    __m128 inv = _mm_div_ps(_mm_set1_ps(1), det);
+	    c0 = _mm_mul_ps(c0, inv);
+	    c1 = _mm_mul_ps(c1, inv);
+	    c2 = _mm_mul_ps(c2, inv);
+
+	    __m128 it = _mm_mul_ps(c0, SWAN_SPLAT(t, 0));
+	    it = _mm_add_ps(it, _mm_mul_ps(c1, SWAN_SPLAT(t, 1)));
+	    it = _mm_add_ps(it, _mm_mul_ps(c2, SWAN_SPLAT(t, 2)));
+	    it = _mm_sub_ps(_mm_setr_ps(0, 0, 0, 1), it);
+
+	    // c0, c1, c2 are the columns of the inverted 3x3 part.
+	    _MM_TRANSPOSE4_PS(c0, c1, c2, it);
+
+	    _mm_storeu_ps(r + 0, c0);
+	    _mm_storeu_ps(r + 4, c1);
+	    _mm_storeu_ps(r + 8, c2);
+	    return true;
+	}
+
+	/// SSE version of InverseAffineScalar().
+	inline mat4 InverseAffineSSE(const mat4& m) {
+	    mat4 res;
+	    if(!InverseAffineRowsSSE(m.data.data(), res.data.data()))
+		return {};
+	    return res;
+	}
+#endif
+    } // namespace detail
+
+    /**
+     * @brief Inverts a 4x4 matrix. Returns the identity matrix if it isn't invertible.
+     *
+     * @note The SSE path works in float and stays within 1e-5 relative error of the scalar one
+     *       for well conditioned matrices (such as any combination of Translate(), Rotate() and Scale()).
+     */
+    inline mat4 Inverse(const mat4& m) {
+#if defined(SWAN_SIMD_SSE)
+	return detail::InverseSSE(m);
+#else
+	return detail::InverseScalar(m);
+#endif
+    }
+
+    /**
+     * @brief Inverts an affine matrix (last row must be (0, 0, 0, 1)), e.g. Translate() * Rotate() * Scale().
+     *
+     * Much cheaper than Inverse(), since only the 3x3 part needs to be inverted.
+     * Returns the identity matrix if it isn't invertible.
+     */
+    inline mat4 InverseAffine(const mat4& m) {
+#if defined(SWAN_SIMD_SSE)
+	return detail::InverseAffineSSE(m);
+#else
+	return detail::InverseAffineScalar(m);
+#endif
+    }
+
     template<typename T>
     constexpr tvec2<T> operator*(tvec2<T> v, const mat2& m) {
 	return tvec2<T>(v.x * m(0, 0) + v.y * m(0, 1),
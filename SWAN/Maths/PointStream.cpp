@@ -0,0 +1,141 @@
+#include "PointStream.hpp"
+
+#include "SIMD.hpp" // For SWAN::detail::WideLanes, SWAN::detail::ScalarLanes
+
+#include <stdexcept> // For std::invalid_argument
+
+namespace SWAN
+{
+	namespace detail
+	{
+		/// Rows of the 3x4 part of a matrix, broadcast to every lane.
+		template <typename L>
+		struct BroadcastMatrix {
+			explicit BroadcastMatrix(const mat4& m)
+			{
+				for(int y = 0; y < 3; y++)
+					for(int x = 0; x < 4; x++)
+						e[y][x] = L::Set(m(x, y));
+			}
+
+			typename L::Type e[3][4];
+		};
+
+		// Every kernel processes points [begin, end) in steps of L::Width
+		// and returns the index of the first point it didn't process.
+
+		template <typename L>
+		std::size_t TransformPointsImpl(const mat4& mat, const PointStream& in, PointStream& out,
+		                                std::size_t begin, std::size_t end)
+		{
+			using V = typename L::Type;
+			BroadcastMatrix<L> m(mat);
+
+			std::size_t i = begin;
+			for(; i + L::Width <= end; i += L::Width) {
+				V x = L::Load(&in.x[i]), y = L::Load(&in.y[i]), z = L::Load(&in.z[i]);
+
+				V rx = L::Add(L::Add(L::Mul(m.e[0][0], x), L::Mul(m.e[0][1], y)), L::Add(L::Mul(m.e[0][2], z), m.e[0][3]));
+				V ry = L::Add(L::Add(L::Mul(m.e[1][0], x), L::Mul(m.e[1][1], y)), L::Add(L::Mul(m.e[1][2], z), m.e[1][3]));
+				V rz = L::Add(L::Add(L::Mul(m.e[2][0], x), L::Mul(m.e[2][1], y)), L::Add(L::Mul(m.e[2][2], z), m.e[2][3]));
+
+				L::Store(&out.x[i], rx);
+				L::Store(&out.y[i], ry);
+				L::Store(&out.z[i], rz);
+			}
+			return i;
+		}
+
+		template <typename L>
+		std::size_t TransformDirectionsImpl(const mat4& mat, const PointStream& in, PointStream& out,
+		                                    std::size_t begin, std::size_t end)
+		{
+			using V = typename L::Type;
+			BroadcastMatrix<L> m(mat);
+
+			std::size_t i = begin;
+			for(; i + L::Width <= end; i += L::Width) {
+				V x = L::Load(&in.x[i]), y = L::Load(&in.y[i]), z = L::Load(&in.z[i]);
+
+				V rx = L::Add(L::Add(L::Mul(m.e[0][0], x), L::Mul(m.e[0][1], y)), L::Mul(m.e[0][2], z));
+				V ry = L::Add(L::Add(L::Mul(m.e[1][0], x), L::Mul(m.e[1][1], y)), L::Mul(m.e[1][2], z));
+				V rz = L::Add(L::Add(L::Mul(m.e[2][0], x), L::Mul(m.e[2][1], y)), L::Mul(m.e[2][2], z));
+
+				L::Store(&out.x[i], rx);
+				L::Store(&out.y[i], ry);
+				L::Store(&out.z[i], rz);
+			}
+			return i;
+		}
+
+		// The new center is the transformed old center, the new half-extents are
+		// the old ones multiplied by the absolute values of the 3x3 part (Arvo's method).
+		template <typename L>
+		std::size_t TransformAABBsImpl(const mat4& mat,
+		                               const PointStream& mins, const PointStream& maxs,
+		                               PointStream& outMins, PointStream& outMaxs,
+		                               std::size_t begin, std::size_t end)
+		{
+			using V = typename L::Type;
+			BroadcastMatrix<L> m(mat);
+
+			V a[3][3];
+			for(int y = 0; y < 3; y++)
+				for(int x = 0; x < 3; x++)
+					a[y][x] = L::Abs(m.e[y][x]);
+
+			const V half = L::Set(0.5f);
+
+			std::size_t i = begin;
+			for(; i + L::Width <= end; i += L::Width) {
+				V minX = L::Load(&mins.x[i]), minY = L::Load(&mins.y[i]), minZ = L::Load(&mins.z[i]);
+				V maxX = L::Load(&maxs.x[i]), maxY = L::Load(&maxs.y[i]), maxZ = L::Load(&maxs.z[i]);
+
+				V cx = L::Mul(L::Add(minX, maxX), half), ex = L::Mul(L::Sub(maxX, minX), half);
+				V cy = L::Mul(L::Add(minY, maxY), half), ey = L::Mul(L::Sub(maxY, minY), half);
+				V cz = L::Mul(L::Add(minZ, maxZ), half), ez = L::Mul(L::Sub(maxZ, minZ), half);
+
+				V c[3], e[3];
+				for(int r = 0; r < 3; r++) {
+					c[r] = L::Add(L::Add(L::Mul(m.e[r][0], cx), L::Mul(m.e[r][1], cy)), L::Add(L::Mul(m.e[r][2], cz), m.e[r][3]));
+					e[r] = L::Add(L::Add(L::Mul(a[r][0], ex), L::Mul(a[r][1], ey)), L::Mul(a[r][2], ez));
+				}
+
+				L::Store(&outMins.x[i], L::Sub(c[0], e[0]));
+				L::Store(&outMins.y[i], L::Sub(c[1], e[1]));
+				L::Store(&outMins.z[i], L::Sub(c[2], e[2]));
+				L::Store(&outMaxs.x[i], L::Add(c[0], e[0]));
+				L::Store(&outMaxs.y[i], L::Add(c[1], e[1]));
+				L::Store(&outMaxs.z[i], L::Add(c[2], e[2]));
+			}
+			return i;
+		}
+	} // namespace detail
+
+	void TransformPoints(const mat4& m, const PointStream& in, PointStream& out)
+	{
+		out.resize(in.size());
+		std::size_t i = detail::TransformPointsImpl<detail::WideLanes>(m, in, out, 0, in.size());
+		detail::TransformPointsImpl<detail::ScalarLanes>(m, in, out, i, in.size());
+	}
+
+	void TransformDirections(const mat4& m, const PointStream& in, PointStream& out)
+	{
+		out.resize(in.size());
+		std::size_t i = detail::TransformDirectionsImpl<detail::WideLanes>(m, in, out, 0, in.size());
+		detail::TransformDirectionsImpl<detail::ScalarLanes>(m, in, out, i, in.size());
+	}
+
+	void TransformAABBs(const mat4& m,
+	                    const PointStream& mins, const PointStream& maxs,
+	                    PointStream& outMins, PointStream& outMaxs)
+	{
+		if(mins.size() != maxs.size())
+			throw std::invalid_argument("TransformAABBs() - mins and maxs have different sizes!");
+
+		outMins.resize(mins.size());
+		outMaxs.resize(mins.size());
+		std::size_t i = detail::TransformAABBsImpl<detail::WideLanes>(m, mins, maxs, outMins, outMaxs, 0, mins.size());
+		detail::TransformAABBsImpl<detail::ScalarLanes>(m, mins, maxs, outMins, outMaxs, i, mins.size());
+	}
+} // namespace SWAN
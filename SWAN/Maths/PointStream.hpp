@@ -0,0 +1,99 @@
+#ifndef SWAN_POINT_STREAM_HPP
+#define SWAN_POINT_STREAM_HPP
+
+#include <cstddef> // For std::size_t
+#include <vector>  // For std::vector<T>
+
+#include "Matrix.hpp" // For SWAN::mat4
+#include "Vector.hpp" // For SWAN::vec3
+
+namespace SWAN
+{
+	/**
+	 * @brief A structure-of-arrays list of 3D points (or directions).
+	 *
+	 * Every coordinate lives in its own contiguous float array, so that the
+	 * Transform*() kernels below can process 4 (SSE) or 8 (AVX) points per instruction.
+	 */
+	struct PointStream {
+		PointStream() {}
+		explicit PointStream(std::size_t count) : x(count), y(count), z(count) {}
+		explicit PointStream(const std::vector<vec3>& points)
+		{
+			reserve(points.size());
+			for(const vec3& p : points)
+				push_back(p);
+		}
+
+		inline std::size_t size() const { return x.size(); }
+		inline bool empty() const { return x.empty(); }
+
+		inline void resize(std::size_t count)
+		{
+			x.resize(count);
+			y.resize(count);
+			z.resize(count);
+		}
+		inline void reserve(std::size_t count)
+		{
+			x.reserve(count);
+			y.reserve(count);
+			z.reserve(count);
+		}
+		inline void clear()
+		{
+			x.clear();
+			y.clear();
+			z.clear();
+		}
+
+		inline void push_back(vec3 p)
+		{
+			x.push_back(p.x);
+			y.push_back(p.y);
+			z.push_back(p.z);
+		}
+
+		/// Get the i-th point.
+		inline vec3 get(std::size_t i) const { return vec3(x[i], y[i], z[i]); }
+
+		/// Set the i-th point.
+		inline void set(std::size_t i, vec3 p)
+		{
+			x[i] = p.x;
+			y[i] = p.y;
+			z[i] = p.z;
+		}
+
+		std::vector<float> x, y, z;
+	};
+
+	/**
+	 * @brief Transforms every point in a stream by an affine matrix (w = 1).
+	 *
+	 * Same result as vec4(p, 1) * Transpose(m) for every point, without the projective divide.
+	 * @p out is resized to match @p in. @p in and @p out may be the same stream.
+	 */
+	extern void TransformPoints(const mat4& m, const PointStream& in, PointStream& out);
+
+	/**
+	 * @brief Transforms every direction in a stream by a matrix (w = 0), i.e. ignores translation.
+	 *
+	 * @p out is resized to match @p in. @p in and @p out may be the same stream.
+	 */
+	extern void TransformDirections(const mat4& m, const PointStream& in, PointStream& out);
+
+	/**
+	 * @brief Transforms a list of axis-aligned boxes and returns the boxes that enclose the results.
+	 *
+	 * The i-th box is (mins[i], maxs[i]). Uses the center/extent form, so each box
+	 * costs about as much as transforming two points instead of eight corners.
+	 * @p outMins and @p outMaxs are resized to match @p mins.
+	 * Throws std::invalid_argument if @p mins and @p maxs have different sizes.
+	 */
+	extern void TransformAABBs(const mat4& m,
+	                           const PointStream& mins, const PointStream& maxs,
+	                           PointStream& outMins, PointStream& outMaxs);
+} // namespace SWAN
+
+#endif
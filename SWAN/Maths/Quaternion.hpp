@@ -0,0 +1,134 @@
+#ifndef SWAN_QUATERNION_HPP
+#define SWAN_QUATERNION_HPP
+
+#include <cmath> // For std::sin(), std::cos(), std::acos(), std::sqrt()
+
+#include "Matrix.hpp" // For SWAN::mat4
+#include "SIMD.hpp"   // For SWAN_SIMD_SSE
+#include "Vector.hpp" // For SWAN::vec3
+
+namespace SWAN
+{
+	/**
+	 * @brief A rotation quaternion, stored as (x, y, z, w) where w is the real part.
+	 *
+	 * Rotations compose like matrices: ToMat4(a * b) == ToMat4(a) * ToMat4(b).
+	 */
+	struct alignas(16) quat {
+		/// Constructs the identity rotation.
+		constexpr quat() : x(0), y(0), z(0), w(1) {}
+		constexpr quat(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+		/// Rotation of @p angle radians around @p axis.
+		template <typename T>
+		static quat FromAxisAngle(double angle, const tvec3<T>& axis)
+		{
+			vec3 a = Normalized(vec3(axis));
+			double s = std::sin(angle / 2);
+			return quat(a.x * s, a.y * s, a.z * s, std::cos(angle / 2));
+		}
+
+		/// Same rotation as Transform's Euler angles: Y * X * Z.
+		template <typename T>
+		static quat FromEuler(const tvec3<T>& euler)
+		{
+			double sx = std::sin(euler.x / 2), cx = std::cos(euler.x / 2);
+			double sy = std::sin(euler.y / 2), cy = std::cos(euler.y / 2);
+			double sz = std::sin(euler.z / 2), cz = std::cos(euler.z / 2);
+
+			// Expanded form of quat(0, sy, 0, cy) * quat(sx, 0, 0, cx) * quat(0, 0, sz, cz).
+			return quat(cy * sx * cz + sy * cx * sz,
+			            sy * cx * cz - cy * sx * sz,
+			            cy * cx * sz - sy * sx * cz,
+			            cy * cx * cz + sy * sx * sz);
+		}
+
+		float x, y, z, w;
+	};
+
+	constexpr quat Conjugate(const quat& q) { return quat(-q.x, -q.y, -q.z, q.w); }
+	constexpr double Dot(const quat& a, const quat& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+	constexpr quat operator-(const quat& q) { return quat(-q.x, -q.y, -q.z, -q.w); }
+	constexpr quat operator+(const quat& a, const quat& b) { return quat(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); }
+	constexpr quat operator*(const quat& q, double d) { return quat(q.x * d, q.y * d, q.z * d, q.w * d); }
+
+	inline double Length(const quat& q) { return std::sqrt(Dot(q, q)); }
+	inline quat Normalized(const quat& q) { return q * (1.0 / Length(q)); }
+
+	/// Inverse rotation. For unit quaternions this is the same as Conjugate().
+	inline quat Inverse(const quat& q) { return Conjugate(q) * (1.0 / Dot(q, q)); }
+
+	/// Composes two rotations, b is applied first.
+	inline quat operator*(const quat& a, const quat& b)
+	{
+#if defined(SWAN_SIMD_SSE)
+		__m128 va = _mm_load_ps(&a.x), vb = _mm_load_ps(&b.x);
+
+		// a.w * b + a.x * (bw, -bz, by, -bx) + a.y * (bz, bw, -bx, -by) + a.z * (-by, bx, bw, -bz)
+		__m128 r = _mm_mul_ps(SWAN_SPLAT(va, 3), vb);
+		r = _mm_add_ps(r, _mm_mul_ps(SWAN_SPLAT(va, 0), _mm_mul_ps(SWAN_SWIZZLE(vb, 3, 2, 1, 0), _mm_setr_ps(1, -1, 1, -1))));
+		r = _mm_add_ps(r, _mm_mul_ps(SWAN_SPLAT(va, 1), _mm_mul_ps(SWAN_SWIZZLE(vb, 2, 3, 0, 1), _mm_setr_ps(1, 1, -1, -1))));
+		r = _mm_add_ps(r, _mm_mul_ps(SWAN_SPLAT(va, 2), _mm_mul_ps(SWAN_SWIZZLE(vb, 1, 0, 3, 2), _mm_setr_ps(-1, 1, 1, -1))));
+
+		quat res;
+		_mm_store_ps(&res.x, r);
+		return res;
+#else
+		return quat(a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		            a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		            a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+#endif
+	}
+
+	/// Rotates a vector by a unit quaternion.
+	template <typename T>
+	inline tvec3<T> operator*(const quat& q, const tvec3<T>& v)
+	{
+		// v + 2w(u x v) + 2u x (u x v), where u is the vector part of q
+		vec3 u(q.x, q.y, q.z);
+		vec3 t = Cross(u, vec3(v)) * 2.0;
+		return tvec3<T>(vec3(v) + t * q.w + Cross(u, t));
+	}
+
+	/// Normalized linear interpolation. Cheaper than Slerp(), but doesn't keep a constant angular speed.
+	inline quat Nlerp(const quat& a, const quat& b, double t)
+	{
+		quat to = Dot(a, b) < 0 ? -b : b;
+		return Normalized(a * (1 - t) + to * t);
+	}
+
+	/// Spherical linear interpolation between two unit quaternions, along the shortest path.
+	inline quat Slerp(const quat& a, const quat& b, double t)
+	{
+		double cosTheta = Dot(a, b);
+		quat to = b;
+		if(cosTheta < 0) {
+			cosTheta = -cosTheta;
+			to = -b;
+		}
+
+		// Almost the same rotation, sin(theta) would be too close to 0.
+		if(cosTheta > 0.9995)
+			return Nlerp(a, to, t);
+
+		double theta = std::acos(cosTheta);
+		double invSin = 1.0 / std::sin(theta);
+		return a * (std::sin((1 - t) * theta) * invSin) + to * (std::sin(t * theta) * invSin);
+	}
+
+	/// Converts a unit quaternion to a rotation matrix, same layout as Rotate().
+	inline mat4 ToMat4(const quat& q)
+	{
+		float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+		float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+		float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+		return mat4(1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy), 0,
+		            2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx), 0,
+		            2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy), 0,
+		            0, 0, 0, 1);
+	}
+} // namespace SWAN
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef SWAN_SIMD_HPP
+#define SWAN_SIMD_HPP
+
+// Compile-time selection of the instruction set used by the maths kernels.
+//
+// SWAN_SIMD_SSE is defined when SSE2 is available (always true on x86-64),
+// SWAN_SIMD_AVX is additionally defined when the compiler targets AVX (-mavx).
+// Define SWAN_NO_SIMD to force the scalar fallbacks everywhere.
+
+#if !defined(SWAN_NO_SIMD)
+#	if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#		define SWAN_SIMD_SSE 1
+#		include <emmintrin.h> // For SSE2 intrinsics
+#	endif
+#	if defined(SWAN_SIMD_SSE) && defined(__AVX__)
+#		define SWAN_SIMD_AVX 1
+#		include <immintrin.h> // For AVX intrinsics
+#	endif
+#endif
+
+#if defined(SWAN_SIMD_SSE)
+/// Builds an immediate for _mm_shuffle_ps() that picks lanes (x, y, z, w).
+#	define SWAN_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+/// Rearranges the lanes of a single vector.
+#	define SWAN_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps((v), (v), SWAN_SHUFFLE_MASK(x, y, z, w))
+/// Broadcasts one lane of a vector to all four lanes.
+#	define SWAN_SPLAT(v, i) _mm_shuffle_ps((v), (v), SWAN_SHUFFLE_MASK(i, i, i, i))
+#endif
+
+namespace SWAN
+{
+	namespace detail
+	{
+		// "Lanes" wrap one instruction set behind the same interface, so that a
+		// kernel can be written once as a template and instantiated for each width.
+
+		/// One float at a time. Used for the tail of a stream and with SWAN_NO_SIMD.
+		struct ScalarLanes {
+			using Type = float;
+			static constexpr int Width = 1;
+
+			static inline Type Load(const float* p) { return *p; }
+			static inline void Store(float* p, Type v) { *p = v; }
+			static inline Type Set(float f) { return f; }
+
+			static inline Type Add(Type a, Type b) { return a + b; }
+			static inline Type Sub(Type a, Type b) { return a - b; }
+			static inline Type Mul(Type a, Type b) { return a * b; }
+			static inline Type Min(Type a, Type b) { return a < b ? a : b; }
+			static inline Type Max(Type a, Type b) { return a > b ? a : b; }
+			static inline Type Abs(Type a) { return a < 0 ? -a : a; }
+			static inline Type Div(Type a, Type b) { return a / b; }
+
+			// Comparisons give a mask, MoveMask() turns it into one bit per lane.
+			using Mask = bool;
+			static inline Mask Less(Type a, Type b) { return a < b; }
+			static inline Mask LessEqual(Type a, Type b) { return a <= b; }
+			static inline Mask And(Mask a, Mask b) { return a && b; }
+			static inline int MoveMask(Mask m) { return m ? 1 : 0; }
+		};
+
+#if defined(SWAN_SIMD_SSE)
+		/// Four floats at a time.
+		struct SSELanes {
+			using Type = __m128;
+			static constexpr int Width = 4;
+
+			static inline Type Load(const float* p) { return _mm_loadu_ps(p); }
+			static inline void Store(float* p, Type v) { _mm_storeu_ps(p, v); }
+			static inline Type Set(float f) { return _mm_set1_ps(f); }
+
+			static inline Type Add(Type a, Type b) { return _mm_add_ps(a, b); }
+			static inline Type Sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+			static inline Type Mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+			static inline Type Min(Type a, Type b) { return _mm_min_ps(a, b); }
+			static inline Type Max(Type a, Type b) { return _mm_max_ps(a, b); }
+			static inline Type Abs(Type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+			static inline Type Div(Type a, Type b) { return _mm_div_ps(a, b); }
+
+			using Mask = __m128;
+			static inline Mask Less(Type a, Type b) { return _mm_cmplt_ps(a, b); }
+			static inline Mask LessEqual(Type a, Type b) { return _mm_cmple_ps(a, b); }
+			static inline Mask And(Mask a, Mask b) { return _mm_and_ps(a, b); }
+			static inline int MoveMask(Mask m) { return _mm_movemask_ps(m); }
+		};
+#endif
+
+#if defined(SWAN_SIMD_AVX)
+		/// Eight floats at a time.
+		struct AVXLanes {
+			using Type = __m256;
+			static constexpr int Width = 8;
+
+			static inline Type Load(const float* p) { return _mm256_loadu_ps(p); }
+			static inline void Store(float* p, Type v) { _mm256_storeu_ps(p, v); }
+			static inline Type Set(float f) { return _mm256_set1_ps(f); }
+
+			static inline Type Add(Type a, Type b) { return _mm256_add_ps(a, b); }
+			static inline Type Sub(Type a, Type b) { return _mm256_sub_ps(a, b); }
+			static inline Type Mul(Type a, Type b) { return _mm256_mul_ps(a, b); }
+			static inline Type Min(Type a, Type b) { return _mm256_min_ps(a, b); }
+			static inline Type Max(Type a, Type b) { return _mm256_max_ps(a, b); }
+			static inline Type Abs(Type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+			static inline Type Div(Type a, Type b) { return _mm256_div_ps(a, b); }
+
+			using Mask = __m256;
+			static inline Mask Less(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+			static inline Mask LessEqual(Type a, Type b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+			static inline Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+			static inline int MoveMask(Mask m) { return _mm256_movemask_ps(m); }
+		};
+#endif
+
+		/// The widest lanes available in this build.
+#if defined(SWAN_SIMD_AVX)
+		using WideLanes = AVXLanes;
+#elif defined(SWAN_SIMD_SSE)
+		using WideLanes = SSELanes;
+#else
+		using WideLanes = ScalarLanes;
+#endif
+	} // namespace detail
+} // namespace SWAN
+
+#endif
@@ -239,7 +239,7 @@ namespace SWAN
 			return tvec3<U>(x, y, z);
 		}
 
-		float x, y, z, w;
+		T x, y, z, w;
 	};
 
 	template <typename T>
@@ -341,33 +341,33 @@ namespace SWAN
 	template <typename T, typename U = T>
 	constexpr ENABLE_IF_ARITH(U, tvec2<T>) operator*(tvec2<T> v, U d)
 	{
-		return { v.x * d, v.y * d };
+		return tvec2<T>(v.x * d, v.y * d);
 	}
 	template <typename T, typename U = T>
 	constexpr ENABLE_IF_ARITH(U, tvec3<T>) operator*(tvec3<T> v, U d)
 	{
-		return { v.x * d, v.y * d, v.z * d };
+		return tvec3<T>(v.x * d, v.y * d, v.z * d);
 	}
 	template <typename T, typename U = T>
 	constexpr ENABLE_IF_ARITH(U, tvec4<T>) operator*(tvec4<T> v, U d)
 	{
-		return { v.x * d, v.y * d, v.z * d, v.w * d };
+		return tvec4<T>(v.x * d, v.y * d, v.z * d, v.w * d);
 	}
 
 	template <typename T, typename U = T>
 	constexpr ENABLE_IF_ARITH(U, tvec2<T>) operator/(tvec2<T> v, U d)
 	{
-		return { v.x / d, v.y / d };
+		return tvec2<T>(v.x / d, v.y / d);
 	}
 	template <typename T, typename U = T>
 	constexpr ENABLE_IF_ARITH(U, tvec3<T>) operator/(tvec3<T> v, U d)
 	{
-		return { v.x / d, v.y / d, v.z / d };
+		return tvec3<T>(v.x / d, v.y / d, v.z / d);
 	}
 	template <typename T, typename U = T>
 	constexpr ENABLE_IF_ARITH(U, tvec4<T>) operator/(tvec4<T> v, U d)
 	{
-		return { v.x / d, v.y / d, v.z / d, v.w / d };
+		return tvec4<T>(v.x / d, v.y / d, v.z / d, v.w / d);
 	}
 
 	template <typename T, typename U = T>
@@ -443,9 +443,9 @@ namespace SWAN
 	template <typename T, typename U = T>
 	constexpr tvec3<T> Cross(tvec3<T> a, tvec3<U> b)
 	{
-		return { a.y * b.z - a.z * b.y,
-			     a.z * b.x - a.x * b.z,
-			     a.x * b.y - a.y * b.x };
+		return tvec3<T>(a.y * b.z - a.z * b.y,
+		                a.z * b.x - a.x * b.z,
+		                a.x * b.y - a.y * b.x);
 	}
 
 	template <typename T, typename U = T>
@@ -496,9 +496,24 @@ namespace SWAN
 	using dvec3 = tvec3<double>;
 	using dvec4 = tvec4<double>;
 
-	using vec2 = dvec2;
-	using vec3 = dvec3;
-	using vec4 = dvec4;
+	/**
+	 * @brief Scalar type used by vec2, vec3 and vec4 (and through them, by physics and meshes).
+	 *
+	 * float by default, which halves the memory traffic of every vector.
+	 * Build with SWAN_DOUBLE_PRECISION defined (-DSWAN_DOUBLE_PRECISION=ON in CMake)
+	 * for large worlds that need double precision positions.
+	 *
+	 * @note Matrices always store floats, since that's what gets uploaded to the GPU.
+	 */
+#if defined(SWAN_DOUBLE_PRECISION)
+	using Real = double;
+#else
+	using Real = float;
+#endif
+
+	using vec2 = tvec2<Real>;
+	using vec3 = tvec3<Real>;
+	using vec4 = tvec4<Real>;
 
 } // namespace SWAN
 
@@ -6,13 +6,16 @@ namespace SWAN
 	{
 		bool glInit = false;
 
-		/// Vector of functions to call upon GL initialization.
-		std::vector<std::function<void(void)>> funcs;
+		std::vector<std::function<void(void)>>& funcs()
+		{
+			static std::vector<std::function<void(void)>> f;
+			return f;
+		}
 
 		void finishInit()
 		{
 			glInit = true;
-			for(auto& f : funcs)
+			for(auto& f : funcs())
 				f();
 		}
 	} // namespace detail
@@ -13,7 +13,8 @@ namespace SWAN
 		extern bool glInit;
 
 		/// Vector of functions to call upon GL initialization.
-		extern std::vector<std::function<void(void)>> funcs;
+		/// It's made on first use, since OnGLInit objects are often static and can be constructed before it.
+		extern std::vector<std::function<void(void)>>& funcs();
 
 		/// Finishes OpenGL initialization by calling all functions in funcs.
 		/// Called by SWAN::Display::Init().
@@ -34,7 +35,7 @@ namespace SWAN
 		OnGLInit(std::function<void(void)> f)
 		{
 			if(!IsGLInitialized())
-				detail::funcs.push_back(f);
+				detail::funcs().push_back(f);
 			else
 				f();
 		}
@@ -45,7 +46,7 @@ namespace SWAN
 		OnGLInit(std::initializer_list<std::function<void(void)>> i)
 		{
 			if(!IsGLInitialized())
-				detail::funcs.insert(detail::funcs.end(), i.begin(), i.end());
+				detail::funcs().insert(detail::funcs().end(), i.begin(), i.end());
 			else
 				for(auto f : i)
 					f();
@@ -0,0 +1,614 @@
+#include "Recorder.hpp"
+
+#include "OnGLInit.hpp" // For SWAN::IsGLInitialized(), SWAN::detail::finishInit()
+
+#include <glad/glad.h>
+
+#include <algorithm> // For std::min(), std::copy()
+#include <cstdio>    // For std::FILE, std::fopen(), std::fseek(), std::snprintf()
+#include <cstring>   // For std::memcpy(), std::memcmp(), std::strlen()
+
+namespace SWAN
+{
+	namespace GL
+	{
+		static const char* const commandNames[] = {
+#define SWAN_GL_COMMAND_NAME(name, args) "gl" #name,
+			SWAN_GL_RECORDED_COMMANDS(SWAN_GL_COMMAND_NAME)
+#undef SWAN_GL_COMMAND_NAME
+		};
+
+		static const char* const commandArgs[] = {
+#define SWAN_GL_COMMAND_ARGS(name, args) args,
+			SWAN_GL_RECORDED_COMMANDS(SWAN_GL_COMMAND_ARGS)
+#undef SWAN_GL_COMMAND_ARGS
+		};
+
+		/// Size of a call's arguments, and length of an array of floats.
+		using ArgSize = std::uint32_t;
+
+		/// Every call starts with its command and the size of its arguments.
+		static constexpr std::size_t HeaderSize = 1 + sizeof(ArgSize);
+
+		static const char LogMagic[8] = { 'S', 'W', 'A', 'N', 'G', 'L', '0', '2' };
+
+		const char* GetCommandName(Command c) { return c < Command::Count ? commandNames[(unsigned) c] : "gl?"; }
+
+		/// FNV-1a, enough to tell whether two uploads had the same data.
+		static std::uint64_t Hash(const void* data, std::size_t size)
+		{
+			const std::uint8_t* p = (const std::uint8_t*) data;
+			std::uint64_t h = 14695981039346656037ull;
+			for(std::size_t i = 0; i < size; i++)
+				h = (h ^ p[i]) * 1099511628211ull;
+			return h;
+		}
+
+		template <typename T>
+		static T Read(const std::uint8_t* p)
+		{
+			T v;
+			std::memcpy(&v, p, sizeof(T));
+			return v;
+		}
+
+		/// Where the argument of type @p type at @p p ends, or null if it runs past @p end.
+		static const std::uint8_t* ArgEnd(char type, const std::uint8_t* p, const std::uint8_t* end)
+		{
+			std::size_t left = end - p, size;
+			switch(type) {
+				case 'b': size = 1; break;
+				case 'z': size = 8; break;
+				case 'd': size = 4 + 8; break;
+				case 's': size = left >= 1 ? 1 + *p : 1; break;
+				case 'F': size = left >= sizeof(ArgSize) ? sizeof(ArgSize) + 4 * (std::size_t) Read<ArgSize>(p) : sizeof(ArgSize); break;
+				default: size = 4; break;
+			}
+			return size <= left ? p + size : nullptr;
+		}
+
+		void CommandLog::clear()
+		{
+			bytes.clear();
+			last = 0;
+			numCalls = 0;
+			std::fill(std::begin(counts), std::end(counts), 0);
+			dataBytes = 0;
+		}
+
+		unsigned long CommandLog::getDrawCalls() const
+		{
+			return count(Command::DrawArrays) + count(Command::DrawArraysInstanced) +
+			       count(Command::DrawElements) + count(Command::DrawElementsInstanced);
+		}
+
+		void CommandLog::replay(const std::function<void(const Entry&)>& f) const
+		{
+			for(std::size_t i = 0; i + HeaderSize <= bytes.size();) {
+				Entry e;
+				e.command = (Command) bytes[i];
+				e.size = Read<ArgSize>(&bytes[i + 1]);
+				e.args = bytes.data() + i + HeaderSize;
+				f(e);
+				i += HeaderSize + e.size;
+			}
+		}
+
+		std::string CommandLog::Describe(const Entry& e)
+		{
+			if(e.command >= Command::Count)
+				return "gl?()";
+
+			std::string res = GetCommandName(e.command);
+			res += '(';
+
+			char buf[64];
+			const std::uint8_t *p = e.args, *end = e.args + e.size, *next;
+			for(const char* type = commandArgs[(unsigned) e.command]; *type && (next = ArgEnd(*type, p, end)); type++, p = next) {
+				if(type != commandArgs[(unsigned) e.command])
+					res += ", ";
+
+				switch(*type) {
+					case 'e': std::snprintf(buf, sizeof(buf), "0x%X", Read<std::uint32_t>(p)); break;
+					case 'u': std::snprintf(buf, sizeof(buf), "%u", Read<std::uint32_t>(p)); break;
+					case 'i': std::snprintf(buf, sizeof(buf), "%d", Read<std::int32_t>(p)); break;
+					case 'f': std::snprintf(buf, sizeof(buf), "%g", Read<float>(p)); break;
+					case 'b': std::snprintf(buf, sizeof(buf), "%s", *p ? "true" : "false"); break;
+					case 'z': std::snprintf(buf, sizeof(buf), "%lld", (long long) Read<std::int64_t>(p)); break;
+					case 's':
+						res += '"';
+						res.append((const char*) p + 1, *p);
+						res += '"';
+						continue;
+					case 'd':
+						std::snprintf(buf, sizeof(buf), "<%u bytes #%016llx>", Read<std::uint32_t>(p), (unsigned long long) Read<std::uint64_t>(p + 4));
+						break;
+					case 'F': {
+						ArgSize n = Read<ArgSize>(p);
+						res += '[';
+						for(ArgSize i = 0; i < n; i++) {
+							std::snprintf(buf, sizeof(buf), i ? ", %g" : "%g", Read<float>(p + sizeof(ArgSize) + 4 * i));
+							res += buf;
+						}
+						res += ']';
+						continue;
+					}
+				}
+				res += buf;
+			}
+			return res + ')';
+		}
+
+		bool CommandLog::save(const std::string& path) const
+		{
+			std::FILE* f = std::fopen(path.c_str(), "wb");
+			if(!f)
+				return false;
+
+			std::uint64_t size = bytes.size();
+			bool ok = std::fwrite(LogMagic, sizeof(LogMagic), 1, f) == 1 &&
+			          std::fwrite(&size, sizeof(size), 1, f) == 1 &&
+			          (size == 0 || std::fwrite(bytes.data(), size, 1, f) == 1);
+			return std::fclose(f) == 0 && ok;
+		}
+
+		bool CommandLog::load(const std::string& path)
+		{
+			std::FILE* f = std::fopen(path.c_str(), "rb");
+			if(!f)
+				return false;
+
+			char magic[sizeof(LogMagic)];
+			std::uint64_t size = 0;
+			std::vector<std::uint8_t> data;
+			bool ok = std::fread(magic, sizeof(magic), 1, f) == 1 && std::memcmp(magic, LogMagic, sizeof(magic)) == 0 &&
+			          std::fread(&size, sizeof(size), 1, f) == 1;
+			if(ok) {
+				// Don't trust the size further than the file goes.
+				long start = std::ftell(f);
+				ok = start >= 0 && std::fseek(f, 0, SEEK_END) == 0 && size <= (std::uint64_t) (std::ftell(f) - start) &&
+				     std::fseek(f, start, SEEK_SET) == 0;
+			}
+			if(ok) {
+				data.resize(size);
+				ok = size == 0 || std::fread(data.data(), size, 1, f) == 1;
+			}
+			std::fclose(f);
+			if(!ok)
+				return false;
+
+			// The counters aren't saved, they're recounted from the calls. Every call has to be
+			// a known command whose arguments fill exactly the size it has.
+			std::size_t calls = 0, lastCall = 0;
+			unsigned long callCounts[(unsigned) Command::Count] = {};
+			unsigned long long callData = 0;
+			for(std::size_t i = 0; i < data.size();) {
+				if(data.size() - i < HeaderSize || data[i] >= (std::uint8_t) Command::Count)
+					return false;
+				std::size_t argSize = Read<ArgSize>(&data[i + 1]);
+				if(argSize > data.size() - i - HeaderSize)
+					return false;
+
+				const std::uint8_t *p = &data[i + HeaderSize], *end = p + argSize;
+				for(const char* type = commandArgs[data[i]]; *type; type++) {
+					const std::uint8_t* next = ArgEnd(*type, p, end);
+					if(!next)
+						return false;
+					if(*type == 'd')
+						callData += Read<std::uint32_t>(p);
+					p = next;
+				}
+				if(p != end)
+					return false;
+
+				calls++;
+				callCounts[data[i]]++;
+				lastCall = i + 1;
+				i += HeaderSize + argSize;
+			}
+
+			bytes = std::move(data);
+			last = lastCall;
+			numCalls = calls;
+			std::copy(std::begin(callCounts), std::end(callCounts), counts);
+			dataBytes = callData;
+			return true;
+		}
+
+		void CommandLog::begin(Command c)
+		{
+			bytes.push_back((std::uint8_t) c);
+			last = bytes.size();
+			bytes.insert(bytes.end(), sizeof(ArgSize), 0);
+
+			numCalls++;
+			counts[(unsigned) c]++;
+		}
+
+		void CommandLog::append(const void* data, std::size_t size)
+		{
+			const std::uint8_t* p = (const std::uint8_t*) data;
+			bytes.insert(bytes.end(), p, p + size);
+
+			ArgSize argSize = bytes.size() - last - sizeof(ArgSize);
+			std::memcpy(&bytes[last], &argSize, sizeof(argSize));
+		}
+
+		void CommandLog::putU32(std::uint32_t v) { append(&v, sizeof(v)); }
+		void CommandLog::putI32(std::int32_t v) { append(&v, sizeof(v)); }
+		void CommandLog::putI64(std::int64_t v) { append(&v, sizeof(v)); }
+		void CommandLog::putF32(float v) { append(&v, sizeof(v)); }
+		void CommandLog::putBool(bool v)
+		{
+			std::uint8_t b = v;
+			append(&b, 1);
+		}
+
+		void CommandLog::putString(const char* s)
+		{
+			std::uint8_t length = std::min<std::size_t>(s ? std::strlen(s) : 0, 255);
+			append(&length, 1);
+			append(s, length);
+		}
+
+		void CommandLog::putData(const void* data, std::size_t size)
+		{
+			if(!data)
+				size = 0;
+			putU32(size);
+			std::uint64_t hash = data ? Hash(data, size) : 0;
+			append(&hash, sizeof(hash));
+			dataBytes += size;
+		}
+
+		void CommandLog::putFloats(const float* v, std::size_t count)
+		{
+			ArgSize n = v ? count : 0;
+			append(&n, sizeof(n));
+			append(v, n * sizeof(float));
+		}
+
+		long FindFirstDifference(const CommandLog& a, const CommandLog& b)
+		{
+			std::vector<CommandLog::Entry> entries;
+			a.replay([&](const CommandLog::Entry& e) { entries.push_back(e); });
+
+			long index = 0, diff = -1;
+			b.replay([&](const CommandLog::Entry& e) {
+				if(diff >= 0)
+					return;
+				if(index >= (long) entries.size())
+					diff = index;
+				else {
+					const CommandLog::Entry& o = entries[index];
+					if(o.command != e.command || o.size != e.size || std::memcmp(o.args, e.args, e.size) != 0)
+						diff = index;
+				}
+				index++;
+			});
+
+			if(diff < 0 && index < (long) entries.size())
+				diff = index;
+			return diff;
+		}
+
+		namespace detail
+		{
+			/// The log calls go to, or null to drop them.
+			static CommandLog* recordLog = nullptr;
+			static bool recording = false;
+
+			static GLuint nextName = 1;
+			static GLint nextLocation = 0;
+
+			/// Memory handed out by glMapBufferRange(), recorded when it's unmapped.
+			static std::vector<std::uint8_t> mappedData;
+
+			/// The functions that were there before the recording backend.
+			static struct {
+#define SWAN_GL_SAVED_FUNCTION(name, args) decltype(glad_gl##name) name;
+				SWAN_GL_RECORDED_COMMANDS(SWAN_GL_SAVED_FUNCTION)
+#undef SWAN_GL_SAVED_FUNCTION
+			} driverFunctions;
+
+			static void GenNames(Command c, GLsizei n, GLuint* names)
+			{
+				for(GLsizei i = 0; i < n; i++)
+					names[i] = nextName++;
+				if(recordLog) {
+					recordLog->begin(c);
+					recordLog->putI32(n);
+					recordLog->putU32(n > 0 ? names[0] : 0);
+				}
+			}
+
+			static void DeleteNames(Command c, GLsizei n, const GLuint* names)
+			{
+				if(recordLog) {
+					recordLog->begin(c);
+					recordLog->putI32(n);
+					recordLog->putU32(n > 0 ? names[0] : 0);
+				}
+			}
+
+			/// Bytes of pixel data glTexImage2D() reads, for the formats SWAN uses.
+			static std::size_t PixelBytes(GLsizei width, GLsizei height, GLenum format, GLenum type)
+			{
+				std::size_t components = 1, size = 1;
+				switch(format) {
+					case GL_RG: components = 2; break;
+					case GL_RGB: components = 3; break;
+					case GL_RGBA: components = 4; break;
+				}
+				switch(type) {
+					case GL_FLOAT:
+					case GL_UNSIGNED_INT:
+					case GL_UNSIGNED_INT_24_8: size = 4; break;
+				}
+				return (std::size_t) width * height * components * size;
+			}
+
+			// Stand-ins for the GL functions. Each one records its call, and queries get answers
+			// that let SWAN carry on as if a driver was there.
+			namespace Recorded
+			{
+#define SWAN_GL_RECORD(name) \
+	if(CommandLog* log = recordLog) log->begin(Command::name); \
+	if(CommandLog* log = recordLog)
+
+				void APIENTRY ActiveTexture(GLenum texture) { SWAN_GL_RECORD(ActiveTexture) log->putU32(texture); }
+				void APIENTRY AttachShader(GLuint program, GLuint shader)
+				{
+					SWAN_GL_RECORD(AttachShader) log->putU32(program), log->putU32(shader);
+				}
+				void APIENTRY BindAttribLocation(GLuint program, GLuint index, const GLchar* name)
+				{
+					SWAN_GL_RECORD(BindAttribLocation) log->putU32(program), log->putU32(index), log->putString(name);
+				}
+				void APIENTRY BindBuffer(GLenum target, GLuint buffer) { SWAN_GL_RECORD(BindBuffer) log->putU32(target), log->putU32(buffer); }
+				void APIENTRY BindBufferBase(GLenum target, GLuint index, GLuint buffer)
+				{
+					SWAN_GL_RECORD(BindBufferBase) log->putU32(target), log->putU32(index), log->putU32(buffer);
+				}
+				void APIENTRY BindFramebuffer(GLenum target, GLuint fb) { SWAN_GL_RECORD(BindFramebuffer) log->putU32(target), log->putU32(fb); }
+				void APIENTRY BindRenderbuffer(GLenum target, GLuint rb) { SWAN_GL_RECORD(BindRenderbuffer) log->putU32(target), log->putU32(rb); }
+				void APIENTRY BindTexture(GLenum target, GLuint texture) { SWAN_GL_RECORD(BindTexture) log->putU32(target), log->putU32(texture); }
+				void APIENTRY BindVertexArray(GLuint array) { SWAN_GL_RECORD(BindVertexArray) log->putU32(array); }
+				void APIENTRY BufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+				{
+					SWAN_GL_RECORD(BufferData) log->putU32(target), log->putI64(size), log->putData(data, size), log->putU32(usage);
+				}
+				void APIENTRY BufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+				{
+					SWAN_GL_RECORD(BufferSubData) log->putU32(target), log->putI64(offset), log->putData(data, size);
+				}
+				void APIENTRY Clear(GLbitfield mask) { SWAN_GL_RECORD(Clear) log->putU32(mask); }
+				void APIENTRY ClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
+				{
+					SWAN_GL_RECORD(ClearColor) log->putF32(r), log->putF32(g), log->putF32(b), log->putF32(a);
+				}
+				void APIENTRY CompileShader(GLuint shader) { SWAN_GL_RECORD(CompileShader) log->putU32(shader); }
+				GLuint APIENTRY CreateProgram()
+				{
+					GLuint name = nextName++;
+					SWAN_GL_RECORD(CreateProgram) log->putU32(name);
+					return name;
+				}
+				GLuint APIENTRY CreateShader(GLenum type)
+				{
+					GLuint name = nextName++;
+					SWAN_GL_RECORD(CreateShader) log->putU32(type), log->putU32(name);
+					return name;
+				}
+				void APIENTRY DeleteBuffers(GLsizei n, const GLuint* names) { DeleteNames(Command::DeleteBuffers, n, names); }
+				void APIENTRY DeleteFramebuffers(GLsizei n, const GLuint* names) { DeleteNames(Command::DeleteFramebuffers, n, names); }
+				void APIENTRY DeleteProgram(GLuint program) { SWAN_GL_RECORD(DeleteProgram) log->putU32(program); }
+				void APIENTRY DeleteRenderbuffers(GLsizei n, const GLuint* names) { DeleteNames(Command::DeleteRenderbuffers, n, names); }
+				void APIENTRY DeleteShader(GLuint shader) { SWAN_GL_RECORD(DeleteShader) log->putU32(shader); }
+				void APIENTRY DeleteTextures(GLsizei n, const GLuint* names) { DeleteNames(Command::DeleteTextures, n, names); }
+				void APIENTRY DeleteVertexArrays(GLsizei n, const GLuint* names) { DeleteNames(Command::DeleteVertexArrays, n, names); }
+				void APIENTRY DetachShader(GLuint program, GLuint shader)
+				{
+					SWAN_GL_RECORD(DetachShader) log->putU32(program), log->putU32(shader);
+				}
+				void APIENTRY Disable(GLenum cap) { SWAN_GL_RECORD(Disable) log->putU32(cap); }
+				void APIENTRY DisableVertexAttribArray(GLuint index) { SWAN_GL_RECORD(DisableVertexAttribArray) log->putU32(index); }
+				void APIENTRY DrawArrays(GLenum mode, GLint first, GLsizei count)
+				{
+					SWAN_GL_RECORD(DrawArrays) log->putU32(mode), log->putI32(first), log->putI32(count);
+				}
+				void APIENTRY DrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+				{
+					SWAN_GL_RECORD(DrawArraysInstanced) log->putU32(mode), log->putI32(first), log->putI32(count), log->putI32(instances);
+				}
+				void APIENTRY DrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+				{
+					SWAN_GL_RECORD(DrawElements) log->putU32(mode), log->putI32(count), log->putU32(type), log->putI64((std::intptr_t) indices);
+				}
+				void APIENTRY DrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void* indices, GLsizei instances)
+				{
+					SWAN_GL_RECORD(DrawElementsInstanced)
+					log->putU32(mode), log->putI32(count), log->putU32(type), log->putI64((std::intptr_t) indices), log->putI32(instances);
+				}
+				void APIENTRY Enable(GLenum cap) { SWAN_GL_RECORD(Enable) log->putU32(cap); }
+				void APIENTRY EnableVertexAttribArray(GLuint index) { SWAN_GL_RECORD(EnableVertexAttribArray) log->putU32(index); }
+				void APIENTRY FramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum rbTarget, GLuint rb)
+				{
+					SWAN_GL_RECORD(FramebufferRenderbuffer) log->putU32(target), log->putU32(attachment), log->putU32(rbTarget), log->putU32(rb);
+				}
+				void APIENTRY FramebufferTexture2D(GLenum target, GLenum attachment, GLenum texTarget, GLuint texture, GLint level)
+				{
+					SWAN_GL_RECORD(FramebufferTexture2D)
+					log->putU32(target), log->putU32(attachment), log->putU32(texTarget), log->putU32(texture), log->putI32(level);
+				}
+				void APIENTRY GenBuffers(GLsizei n, GLuint* names) { GenNames(Command::GenBuffers, n, names); }
+				void APIENTRY GenFramebuffers(GLsizei n, GLuint* names) { GenNames(Command::GenFramebuffers, n, names); }
+				void APIENTRY GenRenderbuffers(GLsizei n, GLuint* names) { GenNames(Command::GenRenderbuffers, n, names); }
+				void APIENTRY GenTextures(GLsizei n, GLuint* names) { GenNames(Command::GenTextures, n, names); }
+				void APIENTRY GenVertexArrays(GLsizei n, GLuint* names) { GenNames(Command::GenVertexArrays, n, names); }
+				void APIENTRY GenerateMipmap(GLenum target) { SWAN_GL_RECORD(GenerateMipmap) log->putU32(target); }
+				void APIENTRY GetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+				{
+					if(length)
+						*length = 0;
+					if(infoLog && bufSize > 0)
+						infoLog[0] = '\0';
+					SWAN_GL_RECORD(GetProgramInfoLog) log->putU32(program);
+				}
+				void APIENTRY GetProgramiv(GLuint program, GLenum pname, GLint* params)
+				{
+					*params = pname == GL_LINK_STATUS ? GL_TRUE : 0;
+					SWAN_GL_RECORD(GetProgramiv) log->putU32(program), log->putU32(pname);
+				}
+				void APIENTRY GetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei* length, GLchar* infoLog)
+				{
+					if(length)
+						*length = 0;
+					if(infoLog && bufSize > 0)
+						infoLog[0] = '\0';
+					SWAN_GL_RECORD(GetShaderInfoLog) log->putU32(shader);
+				}
+				void APIENTRY GetShaderiv(GLuint shader, GLenum pname, GLint* params)
+				{
+					*params = pname == GL_COMPILE_STATUS ? GL_TRUE : 0;
+					SWAN_GL_RECORD(GetShaderiv) log->putU32(shader), log->putU32(pname);
+				}
+				GLuint APIENTRY GetUniformBlockIndex(GLuint program, const GLchar* name)
+				{
+					SWAN_GL_RECORD(GetUniformBlockIndex) log->putU32(program), log->putString(name), log->putU32(0);
+					return 0;
+				}
+				GLint APIENTRY GetUniformLocation(GLuint program, const GLchar* name)
+				{
+					GLint location = nextLocation++;
+					SWAN_GL_RECORD(GetUniformLocation) log->putU32(program), log->putString(name), log->putI32(location);
+					return location;
+				}
+				void APIENTRY LinkProgram(GLuint program) { SWAN_GL_RECORD(LinkProgram) log->putU32(program); }
+				void* APIENTRY MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+				{
+					mappedData.assign(length, 0);
+					SWAN_GL_RECORD(MapBufferRange) log->putU32(target), log->putI64(offset), log->putI64(length), log->putU32(access);
+					return mappedData.data();
+				}
+				void APIENTRY RenderbufferStorage(GLenum target, GLenum format, GLsizei width, GLsizei height)
+				{
+					SWAN_GL_RECORD(RenderbufferStorage) log->putU32(target), log->putU32(format), log->putI32(width), log->putI32(height);
+				}
+				void APIENTRY Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+				{
+					SWAN_GL_RECORD(Scissor) log->putI32(x), log->putI32(y), log->putI32(width), log->putI32(height);
+				}
+				void APIENTRY ShaderSource(GLuint shader, GLsizei count, const GLchar* const* strings, const GLint* lengths)
+				{
+					if(CommandLog* log = recordLog) {
+						std::string source;
+						for(GLsizei i = 0; i < count; i++)
+							source.append(strings[i], lengths && lengths[i] >= 0 ? lengths[i] : std::strlen(strings[i]));
+						log->begin(Command::ShaderSource);
+						log->putU32(shader);
+						log->putData(source.data(), source.size());
+					}
+				}
+				void APIENTRY TexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height, GLint border,
+				                         GLenum format, GLenum type, const void* pixels)
+				{
+					SWAN_GL_RECORD(TexImage2D)
+					{
+						log->putU32(target), log->putI32(level), log->putI32(internalFormat), log->putI32(width), log->putI32(height);
+						log->putI32(border), log->putU32(format), log->putU32(type), log->putData(pixels, PixelBytes(width, height, format, type));
+					}
+				}
+				void APIENTRY TexParameterf(GLenum target, GLenum pname, GLfloat param)
+				{
+					SWAN_GL_RECORD(TexParameterf) log->putU32(target), log->putU32(pname), log->putF32(param);
+				}
+				void APIENTRY TexParameteri(GLenum target, GLenum pname, GLint param)
+				{
+					SWAN_GL_RECORD(TexParameteri) log->putU32(target), log->putU32(pname), log->putI32(param);
+				}
+				void APIENTRY Uniform1f(GLint location, GLfloat v) { SWAN_GL_RECORD(Uniform1f) log->putI32(location), log->putF32(v); }
+				void APIENTRY Uniform1i(GLint location, GLint v) { SWAN_GL_RECORD(Uniform1i) log->putI32(location), log->putI32(v); }
+				void APIENTRY Uniform2fv(GLint location, GLsizei count, const GLfloat* v)
+				{
+					SWAN_GL_RECORD(Uniform2fv) log->putI32(location), log->putI32(count), log->putFloats(v, count * 2);
+				}
+				void APIENTRY Uniform3fv(GLint location, GLsizei count, const GLfloat* v)
+				{
+					SWAN_GL_RECORD(Uniform3fv) log->putI32(location), log->putI32(count), log->putFloats(v, count * 3);
+				}
+				void APIENTRY Uniform4fv(GLint location, GLsizei count, const GLfloat* v)
+				{
+					SWAN_GL_RECORD(Uniform4fv) log->putI32(location), log->putI32(count), log->putFloats(v, count * 4);
+				}
+				void APIENTRY UniformBlockBinding(GLuint program, GLuint index, GLuint binding)
+				{
+					SWAN_GL_RECORD(UniformBlockBinding) log->putU32(program), log->putU32(index), log->putU32(binding);
+				}
+				void APIENTRY UniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* v)
+				{
+					SWAN_GL_RECORD(UniformMatrix2fv) log->putI32(location), log->putI32(count), log->putBool(transpose), log->putFloats(v, count * 4);
+				}
+				void APIENTRY UniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* v)
+				{
+					SWAN_GL_RECORD(UniformMatrix3fv) log->putI32(location), log->putI32(count), log->putBool(transpose), log->putFloats(v, count * 9);
+				}
+				void APIENTRY UniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* v)
+				{
+					SWAN_GL_RECORD(UniformMatrix4fv) log->putI32(location), log->putI32(count), log->putBool(transpose), log->putFloats(v, count * 16);
+				}
+				GLboolean APIENTRY UnmapBuffer(GLenum target)
+				{
+					SWAN_GL_RECORD(UnmapBuffer) log->putU32(target), log->putData(mappedData.data(), mappedData.size());
+					return GL_TRUE;
+				}
+				void APIENTRY UseProgram(GLuint program) { SWAN_GL_RECORD(UseProgram) log->putU32(program); }
+				void APIENTRY VertexAttribDivisor(GLuint index, GLuint divisor)
+				{
+					SWAN_GL_RECORD(VertexAttribDivisor) log->putU32(index), log->putU32(divisor);
+				}
+				void APIENTRY VertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer)
+				{
+					SWAN_GL_RECORD(VertexAttribPointer)
+					log->putU32(index), log->putI32(size), log->putU32(type), log->putBool(normalized), log->putI32(stride), log->putI64((std::intptr_t) pointer);
+				}
+				void APIENTRY Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+				{
+					SWAN_GL_RECORD(Viewport) log->putI32(x), log->putI32(y), log->putI32(width), log->putI32(height);
+				}
+
+#undef SWAN_GL_RECORD
+			} // namespace Recorded
+		}     // namespace detail
+
+		void UseRecordingBackend(CommandLog* log)
+		{
+			detail::recordLog = log;
+			if(!detail::recording) {
+#define SWAN_GL_INSTALL_FUNCTION(name, args)                 \
+	detail::driverFunctions.name = glad_gl##name; \
+	glad_gl##name = detail::Recorded::name;
+				SWAN_GL_RECORDED_COMMANDS(SWAN_GL_INSTALL_FUNCTION)
+#undef SWAN_GL_INSTALL_FUNCTION
+				detail::recording = true;
+			}
+
+			if(!IsGLInitialized())
+				SWAN::detail::finishInit();
+		}
+
+		void UseDriverBackend()
+		{
+			if(!detail::recording)
+				return;
+
+#define SWAN_GL_RESTORE_FUNCTION(name, args) glad_gl##name = detail::driverFunctions.name;
+			SWAN_GL_RECORDED_COMMANDS(SWAN_GL_RESTORE_FUNCTION)
+#undef SWAN_GL_RESTORE_FUNCTION
+			detail::recording = false;
+			detail::recordLog = nullptr;
+		}
+
+		bool IsRecording() { return detail::recording; }
+	} // namespace GL
+} // namespace SWAN
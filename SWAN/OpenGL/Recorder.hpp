@@ -0,0 +1,206 @@
+#ifndef SWAN_GL_RECORDER_HPP
+#define SWAN_GL_RECORDER_HPP
+
+#include <cstddef>    // For std::size_t
+#include <cstdint>    // For std::uint8_t
+#include <functional> // For std::function<Sig>
+#include <string>     // For std::string
+#include <vector>     // For std::vector<T>
+
+namespace SWAN
+{
+	namespace GL
+	{
+/**
+ * @brief The GL functions the recording backend stands in for, with the types of their recorded arguments.
+ *
+ * Every function SWAN calls is here. Argument types:
+ *     e  GLenum or GLbitfield       u  GLuint         i  GLint or GLsizei
+ *     f  GLfloat                    b  GLboolean      z  GLsizeiptr, GLintptr or a buffer offset
+ *     s  string                     d  data passed by pointer, as its size and a hash
+ *     F  array of GLfloats
+ * Generated and deleted names are recorded as the count and the first name. What's written to
+ * a mapped buffer is recorded as the data of glUnmapBuffer().
+ */
+#define SWAN_GL_RECORDED_COMMANDS(X)        \
+	X(ActiveTexture, "e")                   \
+	X(AttachShader, "uu")                   \
+	X(BindAttribLocation, "uus")            \
+	X(BindBuffer, "eu")                     \
+	X(BindBufferBase, "euu")                \
+	X(BindFramebuffer, "eu")                \
+	X(BindRenderbuffer, "eu")               \
+	X(BindTexture, "eu")                    \
+	X(BindVertexArray, "u")                 \
+	X(BufferData, "ezde")                   \
+	X(BufferSubData, "ezd")                 \
+	X(Clear, "e")                           \
+	X(ClearColor, "ffff")                   \
+	X(CompileShader, "u")                   \
+	X(CreateProgram, "u")                   \
+	X(CreateShader, "eu")                   \
+	X(DeleteBuffers, "iu")                  \
+	X(DeleteFramebuffers, "iu")             \
+	X(DeleteProgram, "u")                   \
+	X(DeleteRenderbuffers, "iu")            \
+	X(DeleteShader, "u")                    \
+	X(DeleteTextures, "iu")                 \
+	X(DeleteVertexArrays, "iu")             \
+	X(DetachShader, "uu")                   \
+	X(Disable, "e")                         \
+	X(DisableVertexAttribArray, "u")        \
+	X(DrawArrays, "eii")                    \
+	X(DrawArraysInstanced, "eiii")          \
+	X(DrawElements, "eiez")                 \
+	X(DrawElementsInstanced, "eiezi")       \
+	X(Enable, "e")                          \
+	X(EnableVertexAttribArray, "u")         \
+	X(FramebufferRenderbuffer, "eeeu")      \
+	X(FramebufferTexture2D, "eeeui")        \
+	X(GenBuffers, "iu")                     \
+	X(GenFramebuffers, "iu")                \
+	X(GenRenderbuffers, "iu")               \
+	X(GenTextures, "iu")                    \
+	X(GenVertexArrays, "iu")                \
+	X(GenerateMipmap, "e")                  \
+	X(GetProgramInfoLog, "u")               \
+	X(GetProgramiv, "ue")                   \
+	X(GetShaderInfoLog, "u")                \
+	X(GetShaderiv, "ue")                    \
+	X(GetUniformBlockIndex, "usu")          \
+	X(GetUniformLocation, "usi")            \
+	X(LinkProgram, "u")                     \
+	X(MapBufferRange, "ezze")               \
+	X(RenderbufferStorage, "eeii")          \
+	X(Scissor, "iiii")                      \
+	X(ShaderSource, "ud")                   \
+	X(TexImage2D, "eiiiiieed")              \
+	X(TexParameterf, "eef")                 \
+	X(TexParameteri, "eei")                 \
+	X(Uniform1f, "if")                      \
+	X(Uniform1i, "ii")                      \
+	X(Uniform2fv, "iiF")                    \
+	X(Uniform3fv, "iiF")                    \
+	X(Uniform4fv, "iiF")                    \
+	X(UniformBlockBinding, "uuu")           \
+	X(UniformMatrix2fv, "iibF")             \
+	X(UniformMatrix3fv, "iibF")             \
+	X(UniformMatrix4fv, "iibF")             \
+	X(UnmapBuffer, "ed")                    \
+	X(UseProgram, "u")                      \
+	X(VertexAttribDivisor, "uu")            \
+	X(VertexAttribPointer, "uiebiz")        \
+	X(Viewport, "iiii")
+
+		/// A GL function the recording backend stands in for.
+		enum class Command : std::uint8_t {
+#define SWAN_GL_COMMAND_ENUM(name, args) name,
+			SWAN_GL_RECORDED_COMMANDS(SWAN_GL_COMMAND_ENUM)
+#undef SWAN_GL_COMMAND_ENUM
+			Count
+		};
+
+		/// The name of the GL function, like "glBindBuffer".
+		extern const char* GetCommandName(Command c);
+
+		/**
+		 * @brief GL calls recorded by the recording backend, in a compact binary form.
+		 *
+		 * Every call is stored as its command, the size of its arguments and the arguments.
+		 * Data passed by pointer (buffer contents, pixels, shader sources) is stored as its
+		 * size and a hash, so logs stay small but still show when the data changes.
+		 */
+		class CommandLog
+		{
+		  public:
+			/// A recorded call. @p args points into the log.
+			struct Entry {
+				Command command;
+				const std::uint8_t* args;
+				unsigned size;
+			};
+
+			/// Forget every recorded call.
+			void clear();
+
+			/// Number of recorded calls.
+			inline std::size_t size() const { return numCalls; }
+
+			/// Number of recorded calls to @p c.
+			inline unsigned long count(Command c) const { return counts[(unsigned) c]; }
+
+			/// Number of draw calls (glDraw*) recorded.
+			unsigned long getDrawCalls() const;
+
+			/// Bytes of data the calls passed by pointer.
+			inline unsigned long long getDataBytes() const { return dataBytes; }
+
+			/// Size of the log itself in bytes.
+			inline std::size_t getLogBytes() const { return bytes.size(); }
+
+			/// Call @p f with every recorded call, in order.
+			void replay(const std::function<void(const Entry&)>& f) const;
+
+			/// A line describing the call, like "glBindBuffer(0x8892, 3)".
+			static std::string Describe(const Entry& e);
+
+			/// Write the log to a file. Returns false if it can't be written.
+			bool save(const std::string& path) const;
+
+			/// Replace the log with one written by save(). Returns false, and keeps the log as it is,
+			/// if the file can't be read or any call in it is malformed.
+			bool load(const std::string& path);
+
+			/// Start appending a call, used by the recording backend. Its arguments are appended with put*().
+			void begin(Command c);
+			void putU32(std::uint32_t v);
+			void putI32(std::int32_t v);
+			void putI64(std::int64_t v);
+			void putF32(float v);
+			void putBool(bool v);
+			void putString(const char* s);
+			void putData(const void* data, std::size_t size);
+			void putFloats(const float* v, std::size_t count);
+
+		  private:
+			/// Appends to the arguments of the last call.
+			void append(const void* data, std::size_t size);
+
+			std::vector<std::uint8_t> bytes;
+			/// Offset of the size of the last call's arguments.
+			std::size_t last = 0;
+
+			std::size_t numCalls = 0;
+			unsigned long counts[(unsigned) Command::Count] = {};
+			unsigned long long dataBytes = 0;
+		};
+
+		/// Index of the first call in which the logs differ, or -1 if they're the same.
+		extern long FindFirstDifference(const CommandLog& a, const CommandLog& b);
+
+		/**
+		 * @brief Makes the GL functions SWAN calls append to @p log instead of calling OpenGL.
+		 *
+		 * No context is needed, so VAOs, shaders, textures, framebuffers and everything rendered
+		 * with them can be benchmarked headless. If @p log is null, the calls do nothing (a null
+		 * backend). Names are handed out in order from 1, shaders always compile and link, and
+		 * uniforms get locations in order from 0.
+		 *
+		 * If OpenGL isn't initialized, this runs the OnGLInit functions like Display::Init() does,
+		 * so the built-in shaders and VAOs get set up against the recorder.
+		 *
+		 * @warning Only the functions in SWAN_GL_RECORDED_COMMANDS are replaced. Switch to a null
+		 *          log before @p log is destroyed, since static VAOs and buffers still call GL when
+		 *          the program exits.
+		 */
+		extern void UseRecordingBackend(CommandLog* log);
+
+		/// Give back the GL functions that were there before UseRecordingBackend().
+		extern void UseDriverBackend();
+
+		/// Whether the recording backend is in use.
+		extern bool IsRecording();
+	} // namespace GL
+} // namespace SWAN
+
+#endif
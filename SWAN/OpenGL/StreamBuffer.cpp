@@ -0,0 +1,95 @@
+#include "StreamBuffer.hpp"
+
+#include "OnGLInit.hpp"
+
+#include <cstring> // For std::memcpy()
+
+namespace SWAN
+{
+	namespace GL
+	{
+		namespace detail
+		{
+			StreamStats streamStats;
+			StreamStats lastFrameStreamStats;
+
+			void EndStreamFrame()
+			{
+				lastFrameStreamStats = streamStats;
+				streamStats = StreamStats();
+			}
+		} // namespace detail
+
+		constexpr std::size_t StreamBuffer::DefaultCapacity;
+
+		StreamBuffer::StreamBuffer(std::size_t capacity) : capacity(capacity)
+		{
+			if(IsGLInitialized())
+				glGenBuffers(1, &id);
+			else
+				OnGLInit([this]() mutable { glGenBuffers(1, &id); });
+		}
+
+		StreamBuffer::~StreamBuffer() { glDeleteBuffers(1, &id); }
+
+		static std::size_t AlignUp(std::size_t offset, std::size_t alignment)
+		{
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+
+		GLintptr StreamBuffer::push(const void* data, std::size_t size, std::size_t alignment)
+		{
+			reserve({ size }, alignment);
+			std::size_t offset = AlignUp(head, alignment);
+			glBindBuffer(GL_ARRAY_BUFFER, id);
+
+			// Nothing has been drawn from this part of the storage since it was allocated,
+			// so there's nothing for the driver to wait for.
+			void* dst = glMapBufferRange(GL_ARRAY_BUFFER, offset, size,
+			                             GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			if(dst) {
+				std::memcpy(dst, data, size);
+				glUnmapBuffer(GL_ARRAY_BUFFER);
+			} else {
+				glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
+			}
+
+			head = offset + size;
+			detail::streamStats.bytes += size;
+			detail::streamStats.allocations++;
+			return offset;
+		}
+
+		void StreamBuffer::reserve(std::initializer_list<std::size_t> sizes, std::size_t alignment)
+		{
+			// Where the pushes end from the head, and how much room they take in fresh storage.
+			std::size_t end = head, total = 0;
+			for(std::size_t size : sizes) {
+				end = AlignUp(end, alignment) + size;
+				total = AlignUp(total, alignment) + size;
+			}
+
+			if(total > capacity) {
+				while(capacity < total)
+					capacity = capacity ? capacity * 2 : total;
+				allocated = false;
+			}
+
+			if(!allocated || end > capacity) {
+				// Orphan the storage, draws that were already issued keep reading the old one.
+				glBindBuffer(GL_ARRAY_BUFFER, id);
+				glBufferData(GL_ARRAY_BUFFER, capacity, nullptr, GL_STREAM_DRAW);
+				if(allocated)
+					detail::streamStats.orphans++;
+				allocated = true;
+				head = 0;
+			}
+		}
+
+		StreamBuffer& GetVertexStream()
+		{
+			static StreamBuffer stream;
+			return stream;
+		}
+	} // namespace GL
+} // namespace SWAN
@@ -0,0 +1,88 @@
+#ifndef SWAN_STREAM_BUFFER_OBJECT_HPP
+#define SWAN_STREAM_BUFFER_OBJECT_HPP
+
+#include <glad/glad.h>
+#include <cstddef>          // For std::size_t
+#include <initializer_list> // For std::initializer_list<T>
+
+namespace SWAN
+{
+	namespace GL
+	{
+		/// How much data went through streaming buffers, and how often they had to start over.
+		struct StreamStats {
+			unsigned long long bytes = 0;
+			unsigned long allocations = 0;
+			unsigned long orphans = 0;
+		};
+
+		namespace detail
+		{
+			/// Counts for the frame being rendered.
+			extern StreamStats streamStats;
+			/// Counts for the last whole frame, a frame ends with Display::Clear().
+			extern StreamStats lastFrameStreamStats;
+
+			/// Makes the current counts the last frame's, and starts counting the next frame.
+			extern void EndStreamFrame();
+		} // namespace detail
+
+		/**
+		 * @brief A structure describing a ring buffer for data that's drawn once and thrown away.
+		 *
+		 * Every push() is appended after the last one, so the driver never has to reallocate the
+		 * buffer or wait for draws reading earlier data. When the buffer is full, it's orphaned:
+		 * the driver gives it new storage and frees the old one once the draws reading it are done.
+		 *
+		 * @warning Data only lasts until the buffer is orphaned, so push it again for every draw.
+		 *            A draw that reads several pushes has to reserve() them first.
+		 */
+		struct StreamBuffer {
+			/// Bytes of a stream buffer unless given otherwise.
+			static constexpr std::size_t DefaultCapacity = 4 << 20;
+
+			/// Construct a stream buffer of @p capacity bytes.
+			explicit StreamBuffer(std::size_t capacity = DefaultCapacity);
+			/// Destroy a stream buffer.
+			~StreamBuffer();
+
+			StreamBuffer(const StreamBuffer&) = delete;
+			StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+			/**
+			 * @brief Copy @p size bytes of @p data into the buffer.
+			 *
+			 * The buffer is left bound to GL_ARRAY_BUFFER. If @p size doesn't fit in the buffer at
+			 * all, the buffer is grown.
+			 *
+			 * @return The offset of the data in the buffer, a multiple of @p alignment.
+			 */
+			GLintptr push(const void* data, std::size_t size, std::size_t alignment = 16);
+
+			/**
+			 * @brief Make room for pushes of @p sizes bytes, so that none of them orphans the buffer.
+			 *
+			 * Orphans the buffer at most once, before the first of them, so everything one draw
+			 * reads stays in the same storage. Call it with the sizes of all the draw's pushes.
+			 */
+			void reserve(std::initializer_list<std::size_t> sizes, std::size_t alignment = 16);
+
+			/// OpenGL ID for the buffer.
+			GLuint id = 0;
+
+			/// Bytes of storage the buffer has.
+			std::size_t capacity;
+
+			/// Offset after the last pushed data.
+			std::size_t head = 0;
+
+			/// Whether the buffer's storage has been allocated.
+			bool allocated = false;
+		};
+
+		/// The stream buffer VAO::streamAttribData(), VAO::streamInstanceData() and VAO::streamIndices() use.
+		extern StreamBuffer& GetVertexStream();
+	} // namespace GL
+} // namespace SWAN
+
+#endif //SWAN_STREAM_BUFFER_OBJECT_HPP
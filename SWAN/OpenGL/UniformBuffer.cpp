@@ -0,0 +1,79 @@
+#include "UniformBuffer.hpp"
+
+#include "OnGLInit.hpp"
+
+#include <cstring> // For std::memcmp(), std::memcpy()
+
+namespace SWAN
+{
+	namespace GL
+	{
+		namespace detail
+		{
+			unsigned long numUniformBufferUploads = 0;
+			unsigned long numUniformBufferSkips = 0;
+
+			/// The buffer bound to each binding point, to skip binding it again.
+			static std::vector<GLuint>& boundUniformBuffers()
+			{
+				static std::vector<GLuint> bound;
+				return bound;
+			}
+		} // namespace detail
+
+		UniformBuffer::UniformBuffer()
+		{
+			// Constructed before any buffer is, so it's destroyed after every buffer,
+			// static ones included.
+			detail::boundUniformBuffers();
+
+			if(IsGLInitialized())
+				glGenBuffers(1, &id);
+			else
+				OnGLInit([this]() mutable { glGenBuffers(1, &id); });
+		}
+
+		UniformBuffer::~UniformBuffer()
+		{
+			for(GLuint& bound : detail::boundUniformBuffers())
+				if(bound == id)
+					bound = 0;
+			glDeleteBuffers(1, &id);
+		}
+
+		bool UniformBuffer::store(const void* data, size_t size, GLenum drawType)
+		{
+			if(!data || size == 0) // No data
+				return false;
+
+			if(contents.size() == size && std::memcmp(contents.data(), data, size) == 0) {
+				detail::numUniformBufferSkips++;
+				return false;
+			}
+
+			glBindBuffer(GL_UNIFORM_BUFFER, id);
+			if(contents.size() == size)
+				glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+			else
+				glBufferData(GL_UNIFORM_BUFFER, size, data, drawType);
+
+			contents.resize(size);
+			std::memcpy(contents.data(), data, size);
+
+			detail::numUniformBufferUploads++;
+			return true;
+		}
+
+		void UniformBuffer::bindTo(GLuint binding) const
+		{
+			std::vector<GLuint>& bound = detail::boundUniformBuffers();
+			if(binding >= bound.size())
+				bound.resize(binding + 1, 0);
+			else if(bound[binding] == id)
+				return;
+
+			glBindBufferBase(GL_UNIFORM_BUFFER, binding, id);
+			bound[binding] = id;
+		}
+	} // namespace GL
+} // namespace SWAN
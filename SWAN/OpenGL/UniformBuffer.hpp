@@ -0,0 +1,45 @@
+#ifndef SWAN_UNIFORM_BUFFER_OBJECT_HPP
+#define SWAN_UNIFORM_BUFFER_OBJECT_HPP
+
+#include <glad/glad.h>
+#include <vector>
+
+namespace SWAN
+{
+	namespace GL
+	{
+		namespace detail
+		{
+			extern unsigned long numUniformBufferUploads;
+			extern unsigned long numUniformBufferSkips;
+		} // namespace detail
+
+		/**
+		 * @brief A structure describing an OpenGL uniform buffer object, which holds the values of a uniform block.
+		 *
+		 * Shaders read a block from whichever buffer is bound to the block's binding point (see
+		 * Shader::bindUniformBlock()), so one upload serves every shader using the block.
+		 */
+		struct UniformBuffer {
+			/// Construct a uniform buffer.
+			UniformBuffer();
+			/// Destroy a uniform buffer.
+			~UniformBuffer();
+
+			/// Upload @p size bytes of @p data, unless the buffer already holds exactly those.
+			/// Returns whether anything was uploaded.
+			bool store(const void* data, size_t size, GLenum drawType = GL_DYNAMIC_DRAW);
+
+			/// Bind the buffer to the uniform block binding point @p binding (if necessary).
+			void bindTo(GLuint binding) const;
+
+			/// OpenGL ID for the buffer.
+			GLuint id = 0;
+
+			/// A copy of what was last uploaded.
+			std::vector<unsigned char> contents;
+		};
+	} // namespace GL
+} // namespace SWAN
+
+#endif //SWAN_UNIFORM_BUFFER_OBJECT_HPP
@@ -1,6 +1,7 @@
 #include "VAO.hpp"
 
 #include "OnGLInit.hpp"
+#include "StreamBuffer.hpp" // For SWAN::GL::GetVertexStream()
 
 namespace SWAN
 {
@@ -15,6 +16,32 @@ namespace SWAN
 			unsigned long numDeletions = 0;
 		} // namespace detail
 
+		/// Upload @p data to @p vbo, only reallocating it if the data doesn't fit.
+		static void Upload(VAO& vao, GLenum target, GLuint vbo, const void* data, size_t size, GLenum drawType)
+		{
+			glBindBuffer(target, vbo);
+
+			size_t& allocated = vao.bufferSizes[vbo];
+			if(size <= allocated) {
+				glBufferSubData(target, 0, size, data);
+			} else {
+				glBufferData(target, size, data, drawType);
+				allocated = size;
+			}
+		}
+
+		/// Point the attributes of per-instance records at @p offset in the bound GL_ARRAY_BUFFER.
+		static void SetInstanceAttribs(unsigned firstAttrib, unsigned numAttribs, GLintptr offset)
+		{
+			const GLsizei stride = numAttribs * 4 * sizeof(float);
+			for(unsigned i = 0; i < numAttribs; i++) {
+				unsigned attrib = firstAttrib + i;
+				glVertexAttribPointer(attrib, 4, GL_FLOAT, GL_FALSE, stride, (const void*) (offset + i * 4 * sizeof(float)));
+				glVertexAttribDivisor(attrib, 1);
+				glEnableVertexAttribArray(attrib);
+			}
+		}
+
 		VAO::VAO()
 		{
 			if(IsGLInitialized())
@@ -56,8 +83,8 @@ namespace SWAN
 		{
 			bind();
 			if(hasIndices) {
-				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-				glDrawElements(renderType, count, GL_UNSIGNED_INT, 0);
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indicesStreamed ? GetVertexStream().id : indexBuffer);
+				glDrawElements(renderType, count, GL_UNSIGNED_INT, (const void*) indexOffset);
 			} else {
 				glDrawArrays(renderType, 0, count);
 			}
@@ -66,6 +93,19 @@ namespace SWAN
 			detail::numDrawCalls++;
 		}
 
+		void VAO::drawInstanced(int count, int instances, GLenum renderType) const
+		{
+			bind();
+			if(hasIndices) {
+				glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indicesStreamed ? GetVertexStream().id : indexBuffer);
+				glDrawElementsInstanced(renderType, count, GL_UNSIGNED_INT, (const void*) indexOffset, instances);
+			} else {
+				glDrawArraysInstanced(renderType, 0, count, instances);
+			}
+
+			detail::numDrawCalls++;
+		}
+
 		void VAO::storeIndices(const unsigned* indices, size_t size, GLenum drawType)
 		{
 			if(!indices || size == 0)
@@ -76,12 +116,13 @@ namespace SWAN
 			if(indexBuffer == 0) {
 				glGenBuffers(1, &indexBuffer);
 			}
-			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-			glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+			Upload(*this, GL_ELEMENT_ARRAY_BUFFER, indexBuffer, indices, size, drawType);
 			//glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 			// unbind();
 			hasIndices = true;
+			indicesStreamed = false;
+			indexOffset = 0;
 		}
 
 		void VAO::storeAttribData(unsigned attribNumber,
@@ -103,13 +144,74 @@ namespace SWAN
 				vboIter = attribVBOs.find(attribNumber);
 			}
 
-			glBindBuffer(GL_ARRAY_BUFFER, vboIter->second);
-			glBufferData(GL_ARRAY_BUFFER, dataSize, data, drawType);
+			Upload(*this, GL_ARRAY_BUFFER, vboIter->second, data, dataSize, drawType);
 			glVertexAttribPointer(attribNumber, glNumComponents, GL_FLOAT, GL_FALSE, 0, 0);
 			glEnableVertexAttribArray(attribNumber);
 
 			// glBindBuffer(GL_ARRAY_BUFFER, 0);
 			// unbind();
 		}
+
+		void VAO::storeInstanceData(unsigned firstAttrib,
+		                            unsigned numAttribs,
+		                            const float* data,
+		                            size_t dataSize,
+		                            GLenum drawType)
+		{
+			if(!data || dataSize == 0) // No data
+				return;
+
+			bind();
+
+			// The whole record lives in one VBO, kept under its first attribute.
+			auto vboIter = attribVBOs.find(firstAttrib);
+			if(vboIter == attribVBOs.end()) {
+				GLuint vbo;
+				glGenBuffers(1, &vbo);
+				vboIter = attribVBOs.insert({ firstAttrib, vbo }).first;
+			}
+
+			Upload(*this, GL_ARRAY_BUFFER, vboIter->second, data, dataSize, drawType);
+			SetInstanceAttribs(firstAttrib, numAttribs, 0);
+		}
+
+		void VAO::streamIndices(const unsigned* indices, size_t size)
+		{
+			if(!indices || size == 0)
+				return;
+
+			bind();
+			indexOffset = GetVertexStream().push(indices, size);
+			hasIndices = true;
+			indicesStreamed = true;
+		}
+
+		void VAO::streamAttribData(unsigned attribNumber,
+		                           size_t glNumComponents,
+		                           const float* data,
+		                           size_t dataSize)
+		{
+			if(!data || dataSize == 0) // No data
+				return;
+
+			bind();
+
+			// push() leaves the stream bound to GL_ARRAY_BUFFER.
+			GLintptr offset = GetVertexStream().push(data, dataSize);
+			glVertexAttribPointer(attribNumber, glNumComponents, GL_FLOAT, GL_FALSE, 0, (const void*) offset);
+			glEnableVertexAttribArray(attribNumber);
+		}
+
+		void VAO::streamInstanceData(unsigned firstAttrib,
+		                             unsigned numAttribs,
+		                             const float* data,
+		                             size_t dataSize)
+		{
+			if(!data || dataSize == 0) // No data
+				return;
+
+			bind();
+			SetInstanceAttribs(firstAttrib, numAttribs, GetVertexStream().push(data, dataSize));
+		}
 	} // namespace GL
 } // namespace SWAN
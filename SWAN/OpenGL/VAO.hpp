@@ -38,6 +38,9 @@ namespace SWAN
 			/// Render the contents of the VAO onscreen.
 			void draw(int count, GLenum renderType = GL_TRIANGLES) const;
 
+			/// Render @p instances copies of the contents of the VAO with one draw call.
+			void drawInstanced(int count, int instances, GLenum renderType = GL_TRIANGLES) const;
+
 			/// Add indices to the VAO.
 			void storeIndices(const unsigned* indices, size_t size, GLenum drawType = GL_STATIC_DRAW);
 
@@ -48,6 +51,39 @@ namespace SWAN
 			                     size_t dataSize,
 			                     GLenum drawType = GL_STATIC_DRAW);
 
+			/**
+			 * @brief Add per-instance data to the VAO.
+			 *
+			 * @p data holds one record of @p numAttribs vec4s per instance, stored in one buffer and
+			 * read by the attributes @p firstAttrib to @p firstAttrib + @p numAttribs - 1, which
+			 * move on to the next record once per instance instead of once per vertex.
+			 */
+			void storeInstanceData(unsigned firstAttrib,
+			                       unsigned numAttribs,
+			                       const float* data,
+			                       size_t dataSize,
+			                       GLenum drawType = GL_DYNAMIC_DRAW);
+
+			/**
+			 * @brief Like storeIndices(), but puts the indices in the vertex stream (see GetVertexStream()).
+			 *
+			 * For geometry that changes every time it's drawn. Nothing is reallocated, but the data
+			 * only lasts until the stream wraps around, so stream it again before every draw.
+			 */
+			void streamIndices(const unsigned* indices, size_t size);
+
+			/// Like storeAttribData(), but puts the data in the vertex stream. See streamIndices().
+			void streamAttribData(unsigned attribNumber,
+			                      size_t glNumComponents,
+			                      const float* data,
+			                      size_t dataSize);
+
+			/// Like storeInstanceData(), but puts the data in the vertex stream. See streamIndices().
+			void streamInstanceData(unsigned firstAttrib,
+			                        unsigned numAttribs,
+			                        const float* data,
+			                        size_t dataSize);
+
 			/// OpenGL ID for the VAO.
 			GLuint id = 0;
 
@@ -57,8 +93,15 @@ namespace SWAN
 
 			/// ID of index VBO.
 			GLuint indexBuffer = 0;
+			/// Whether the indices are in the vertex stream instead of the index VBO.
+			bool indicesStreamed = false;
+			/// Offset of the indices in the vertex stream.
+			GLintptr indexOffset = 0;
+
 			/// A mapping of attribute numbers to the VBOs that store their data.
 			std::map<unsigned, GLuint> attribVBOs;
+			/// Bytes allocated for each VBO, so storing data that fits doesn't reallocate it.
+			std::map<GLuint, size_t> bufferSizes;
 		};
 	} // namespace GL
 } // namespace SWAN
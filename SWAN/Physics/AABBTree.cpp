@@ -0,0 +1,263 @@
+#include "AABBTree.hpp"
+
+#include <algorithm> // For std::max()
+
+namespace SWAN
+{
+	constexpr AABBTree::ProxyID AABBTree::None;
+
+	/// How many frames of movement the fat box is extended by.
+	static constexpr double DisplacementMultiplier = 2;
+
+	std::uint32_t AABBTree::allocateNode()
+	{
+		std::uint32_t index;
+		if(freeList == None) {
+			index = nodes.size();
+			nodes.push_back(Node());
+		} else {
+			index = freeList;
+			freeList = nodes[index].parent;
+		}
+
+		Node& node = nodes[index];
+		node.parent = node.child1 = node.child2 = None;
+		node.height = 0;
+		node.userData = 0;
+		return index;
+	}
+
+	void AABBTree::freeNode(std::uint32_t index)
+	{
+		nodes[index].parent = freeList;
+		nodes[index].height = -1;
+		freeList = index;
+	}
+
+	AABBTree::ProxyID AABBTree::insert(const AABB& box, std::uint32_t userData)
+	{
+		std::uint32_t leaf = allocateNode();
+		nodes[leaf].box = AABB(box.min - vec3(margin), box.max + vec3(margin));
+		nodes[leaf].userData = userData;
+
+		insertLeaf(leaf);
+		proxyCount++;
+		return leaf;
+	}
+
+	void AABBTree::remove(ProxyID proxy)
+	{
+		removeLeaf(proxy);
+		freeNode(proxy);
+		proxyCount--;
+	}
+
+	bool AABBTree::move(ProxyID proxy, const AABB& box, vec3 displacement)
+	{
+		if(nodes[proxy].box.Contains(box))
+			return false;
+
+		removeLeaf(proxy);
+
+		AABB fat(box.min - vec3(margin), box.max + vec3(margin));
+
+		// Extend the box in the direction of movement, so it stays valid for a few more steps.
+		vec3 d = displacement * DisplacementMultiplier;
+		(d.x < 0 ? fat.min.x : fat.max.x) += d.x;
+		(d.y < 0 ? fat.min.y : fat.max.y) += d.y;
+		(d.z < 0 ? fat.min.z : fat.max.z) += d.z;
+
+		nodes[proxy].box = fat;
+		insertLeaf(proxy);
+		return true;
+	}
+
+	void AABBTree::queryPairs(Vector<Pair>& out) const
+	{
+		out.clear();
+		if(root == None)
+			return;
+
+		// Every internal node checks its two subtrees against each other, which finds each pair
+		// exactly once and skips whole subtrees at a time, unlike querying the tree once per leaf.
+		Vector<Pair> stack;
+		for(std::uint32_t i = 0; i < nodes.size(); i++) {
+			if(nodes[i].height < 1)
+				continue;
+
+			stack.push_back({ nodes[i].child1, nodes[i].child2 });
+			while(!stack.empty()) {
+				Pair p = stack.back();
+				stack.pop_back();
+
+				const Node& a = nodes[p.a];
+				const Node& b = nodes[p.b];
+				if(!a.box.Overlaps(b.box))
+					continue;
+
+				if(a.isLeaf() && b.isLeaf()) {
+					out.push_back(p.a < p.b ? p : Pair{ p.b, p.a });
+				} else if(b.isLeaf() || (!a.isLeaf() && a.height > b.height)) {
+					// Descend into the taller side.
+					stack.push_back({ a.child1, p.b });
+					stack.push_back({ a.child2, p.b });
+				} else {
+					stack.push_back({ p.a, b.child1 });
+					stack.push_back({ p.a, b.child2 });
+				}
+			}
+		}
+	}
+
+	void AABBTree::insertLeaf(std::uint32_t leaf)
+	{
+		if(root == None) {
+			root = leaf;
+			nodes[root].parent = None;
+			return;
+		}
+
+		// Find the best sibling: walk down while the cost of descending is lower than pairing up here.
+		AABB leafBox = nodes[leaf].box;
+		std::uint32_t index = root;
+		while(!nodes[index].isLeaf()) {
+			const Node& node = nodes[index];
+			double area = node.box.SurfaceArea();
+			double combinedArea = node.box.Merged(leafBox).SurfaceArea();
+
+			// Cost of creating a new parent for this node and the leaf.
+			double cost = 2 * combinedArea;
+			// Minimum cost of pushing the leaf further down, every ancestor grows by this much.
+			double inheritanceCost = 2 * (combinedArea - area);
+
+			auto descendCost = [&](std::uint32_t child) {
+				const Node& c = nodes[child];
+				double merged = c.box.Merged(leafBox).SurfaceArea();
+				return (c.isLeaf() ? merged : merged - c.box.SurfaceArea()) + inheritanceCost;
+			};
+			double cost1 = descendCost(node.child1);
+			double cost2 = descendCost(node.child2);
+
+			if(cost < cost1 && cost < cost2)
+				break;
+
+			index = cost1 < cost2 ? node.child1 : node.child2;
+		}
+		std::uint32_t sibling = index;
+
+		// Create a new parent for the sibling and the leaf.
+		std::uint32_t oldParent = nodes[sibling].parent;
+		std::uint32_t newParent = allocateNode();
+		nodes[newParent].parent = oldParent;
+		nodes[newParent].box = leafBox.Merged(nodes[sibling].box);
+		nodes[newParent].height = nodes[sibling].height + 1;
+		nodes[newParent].child1 = sibling;
+		nodes[newParent].child2 = leaf;
+		nodes[sibling].parent = newParent;
+		nodes[leaf].parent = newParent;
+
+		if(oldParent == None) {
+			root = newParent;
+		} else {
+			if(nodes[oldParent].child1 == sibling)
+				nodes[oldParent].child1 = newParent;
+			else
+				nodes[oldParent].child2 = newParent;
+		}
+
+		refit(oldParent);
+	}
+
+	void AABBTree::removeLeaf(std::uint32_t leaf)
+	{
+		if(leaf == root) {
+			root = None;
+			return;
+		}
+
+		std::uint32_t parent = nodes[leaf].parent;
+		std::uint32_t grandParent = nodes[parent].parent;
+		std::uint32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+		// The sibling takes the parent's place.
+		if(grandParent == None) {
+			root = sibling;
+			nodes[sibling].parent = None;
+			freeNode(parent);
+			return;
+		}
+
+		if(nodes[grandParent].child1 == parent)
+			nodes[grandParent].child1 = sibling;
+		else
+			nodes[grandParent].child2 = sibling;
+		nodes[sibling].parent = grandParent;
+		freeNode(parent);
+
+		refit(grandParent);
+	}
+
+	void AABBTree::refit(std::uint32_t index)
+	{
+		while(index != None) {
+			index = balance(index);
+
+			Node& node = nodes[index];
+			const Node& c1 = nodes[node.child1];
+			const Node& c2 = nodes[node.child2];
+			node.height = 1 + std::max(c1.height, c2.height);
+			node.box = c1.box.Merged(c2.box);
+
+			index = node.parent;
+		}
+	}
+
+	std::uint32_t AABBTree::balance(std::uint32_t iA)
+	{
+		Node& A = nodes[iA];
+		if(A.isLeaf() || A.height < 2)
+			return iA;
+
+		std::uint32_t iB = A.child1, iC = A.child2;
+		int diff = nodes[iC].height - nodes[iB].height;
+		if(diff >= -1 && diff <= 1)
+			return iA;
+
+		// Rotate the taller child (U) up, A becomes its child.
+		// U's taller child stays with U, its shorter one moves over to A.
+		std::uint32_t iU = diff > 1 ? iC : iB;
+		Node& U = nodes[iU];
+		std::uint32_t iF = U.child1, iG = U.child2;
+
+		U.child1 = iA;
+		U.parent = A.parent;
+		A.parent = iU;
+
+		if(U.parent == None)
+			root = iU;
+		else if(nodes[U.parent].child1 == iA)
+			nodes[U.parent].child1 = iU;
+		else
+			nodes[U.parent].child2 = iU;
+
+		std::uint32_t iKeep = nodes[iF].height > nodes[iG].height ? iF : iG;
+		std::uint32_t iMove = iKeep == iF ? iG : iF;
+		U.child2 = iKeep;
+		if(iU == iC)
+			A.child2 = iMove;
+		else
+			A.child1 = iMove;
+		nodes[iMove].parent = iA;
+
+		const Node& a1 = nodes[A.child1];
+		const Node& a2 = nodes[A.child2];
+		A.box = a1.box.Merged(a2.box);
+		A.height = 1 + std::max(a1.height, a2.height);
+
+		const Node& keep = nodes[iKeep];
+		U.box = A.box.Merged(keep.box);
+		U.height = 1 + std::max(A.height, keep.height);
+
+		return iU;
+	}
+} // namespace SWAN
@@ -0,0 +1,137 @@
+#ifndef SWAN_AABB_TREE_HPP
+#define SWAN_AABB_TREE_HPP
+
+#include <cstdint> // For std::uint32_t, std::int32_t
+
+#include "Basic.hpp"        // For SWAN::AABB
+#include "Core/Defs.hpp"    // For SWAN::Vector<T>
+#include "Maths/Vector.hpp" // For SWAN::vec3
+
+namespace SWAN
+{
+	/**
+	 * @brief Dynamic bounding volume tree, used as a broadphase.
+	 *
+	 * Every proxy is a leaf holding a "fat" AABB: the real box grown by a margin
+	 * (and in the direction of movement), so small movements don't touch the tree.
+	 * Leaves are inserted where they increase the surface area the least,
+	 * and the tree is kept balanced with rotations on the way back up.
+	 *
+	 * Nodes live in one array and are recycled through a free list,
+	 * so proxy IDs stay valid until the proxy is removed.
+	 */
+	class AABBTree
+	{
+	  public:
+		using ProxyID = std::uint32_t;
+
+		/// ID of a proxy that doesn't exist.
+		static constexpr ProxyID None = ~ProxyID(0);
+
+		/// A pair of overlapping proxies, a < b.
+		struct Pair {
+			ProxyID a, b;
+		};
+
+		/// @param margin How much the boxes are grown on every side.
+		explicit AABBTree(double margin = 0.1) : margin(margin) {}
+
+		/// Add a proxy for a box. @p userData is handed back by getUserData().
+		ProxyID insert(const AABB& box, std::uint32_t userData);
+
+		/// Remove a proxy.
+		void remove(ProxyID proxy);
+
+		/**
+		 * @brief Update the box of a proxy.
+		 *
+		 * @param displacement How far the box moved since the last call, the fat box is extended in that direction.
+		 *
+		 * @return Whether the proxy had to be reinserted, i.e. the new box wasn't inside the fat one anymore.
+		 */
+		bool move(ProxyID proxy, const AABB& box, vec3 displacement = vec3(0));
+
+		/// Get the user data that was passed to insert().
+		inline std::uint32_t getUserData(ProxyID proxy) const { return nodes[proxy].userData; }
+
+		/// Get the fat box of a proxy.
+		inline const AABB& getFatAABB(ProxyID proxy) const { return nodes[proxy].box; }
+
+		/// Call @p callback with the ID of every proxy whose fat box overlaps @p box.
+		template <typename Callback>
+		void query(const AABB& box, Callback callback) const
+		{
+			Vector<std::uint32_t> stack;
+			query(box, stack, callback);
+		}
+
+		/// Fills @p out with every pair of proxies whose fat boxes overlap. Each pair is reported once.
+		void queryPairs(Vector<Pair>& out) const;
+
+		/// Number of proxies.
+		inline unsigned size() const { return proxyCount; }
+
+		/// Height of the tree, 0 for a single leaf and -1 when empty.
+		inline int getHeight() const { return root == None ? -1 : nodes[root].height; }
+
+	  private:
+		struct Node {
+			AABB box;
+			/// Parent node, or the next free node while the node is on the free list.
+			std::uint32_t parent;
+			/// Children, child1 is None for leaves.
+			std::uint32_t child1, child2;
+			/// Height of the subtree, 0 for leaves and -1 for free nodes.
+			std::int32_t height;
+			std::uint32_t userData;
+
+			inline bool isLeaf() const { return child1 == None; }
+		};
+
+		template <typename Callback>
+		void query(const AABB& box, Vector<std::uint32_t>& stack, Callback& callback) const
+		{
+			if(root == None)
+				return;
+
+			stack.clear();
+			stack.push_back(root);
+			while(!stack.empty()) {
+				std::uint32_t index = stack.back();
+				stack.pop_back();
+
+				const Node& node = nodes[index];
+
+				if(!node.box.Overlaps(box))
+					continue;
+
+				if(node.isLeaf()) {
+					callback(index);
+				} else {
+					stack.push_back(node.child1);
+					stack.push_back(node.child2);
+				}
+			}
+		}
+
+		std::uint32_t allocateNode();
+		void freeNode(std::uint32_t node);
+
+		void insertLeaf(std::uint32_t leaf);
+		void removeLeaf(std::uint32_t leaf);
+
+		/// Rotates the subtree at @p a if it's unbalanced, returns the new root of the subtree.
+		std::uint32_t balance(std::uint32_t a);
+
+		/// Recalculates boxes and heights from @p index up to the root, balancing on the way.
+		void refit(std::uint32_t index);
+
+		Vector<Node> nodes;
+		std::uint32_t root = None;
+		std::uint32_t freeList = None;
+		unsigned proxyCount = 0;
+		double margin;
+	};
+} // namespace SWAN
+
+#endif
@@ -6,6 +6,109 @@
 
 namespace SWAN
 {
+	static inline double Axis(const vec3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+	/// Narrows [tMin, tMax] to the part of start + dir * t that's inside the box. Returns false if that part is empty.
+	static bool ClipToSlabs(const AABB& aabb, vec3 start, vec3 dir, double& tMin, double& tMax)
+	{
+		for(int axis = 0; axis < 3; axis++) {
+			double s = Axis(start, axis), d = Axis(dir, axis);
+			double lo = Axis(aabb.min, axis), hi = Axis(aabb.max, axis);
+
+			// Parallel to this slab, it's either always or never between the two planes.
+			if(std::abs(d) < std::numeric_limits<double>::epsilon()) {
+				if(s < lo || s > hi)
+					return false;
+				continue;
+			}
+
+			double t1 = (lo - s) / d, t2 = (hi - s) / d;
+			if(t1 > t2)
+				std::swap(t1, t2);
+			tMin = std::max(tMin, t1);
+			tMax = std::min(tMax, t2);
+			if(tMin > tMax)
+				return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Moller-Trumbore intersection of start + dir * t with a triangle, both sides count.
+	 *
+	 * @return false if they're parallel or the line misses the triangle, otherwise @p t is set.
+	 */
+	static bool MollerTrumbore(const Triangle& tri, vec3 start, vec3 dir, double& t)
+	{
+		vec3 e1 = tri.points[1] - tri.points[0];
+		vec3 e2 = tri.points[2] - tri.points[0];
+
+		vec3 p = Cross(dir, e2);
+		double det = Dot(e1, p);
+		if(std::abs(det) < 1e-9)
+			return false;
+		double invDet = 1 / det;
+
+		vec3 s = start - tri.points[0];
+		double u = Dot(s, p) * invDet;
+		if(u < 0 || u > 1)
+			return false;
+
+		vec3 q = Cross(s, e1);
+		double v = Dot(dir, q) * invDet;
+		if(v < 0 || u + v > 1)
+			return false;
+
+		t = Dot(e2, q) * invDet;
+		return true;
+	}
+
+	// From Ericson, "Real-Time Collision Detection", 5.1.5.
+	vec3 ClosestPoint(const Triangle& triangle, vec3 p)
+	{
+		const vec3 &a = triangle.points[0], &b = triangle.points[1], &c = triangle.points[2];
+		vec3 ab = b - a, ac = c - a, ap = p - a;
+
+		// Checks the vertex regions, then the edge regions, then the face.
+		double d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+		if(d1 <= 0 && d2 <= 0)
+			return a;
+
+		vec3 bp = p - b;
+		double d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+		if(d3 >= 0 && d4 <= d3)
+			return b;
+
+		double vc = d1 * d4 - d3 * d2;
+		if(vc <= 0 && d1 >= 0 && d3 <= 0)
+			return a + ab * (d1 / (d1 - d3));
+
+		vec3 cp = p - c;
+		double d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+		if(d6 >= 0 && d5 <= d6)
+			return c;
+
+		double vb = d5 * d2 - d1 * d6;
+		if(vb <= 0 && d2 >= 0 && d6 <= 0)
+			return a + ac * (d2 / (d2 - d6));
+
+		double va = d3 * d6 - d5 * d4;
+		if(va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0)
+			return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+
+		double denom = 1 / (va + vb + vc);
+		return a + ab * (vb * denom) + ac * (vc * denom);
+	}
+
+	static inline Intersection PointIntersection(vec3 point)
+	{
+		Intersection res;
+		res.happened = true;
+		res.point = point;
+		res.type = Intersection::Type::Point;
+		return res;
+	}
+
 	// The code is a modified version of www.miguelcasillas.com/?p=43
 	// (archive: https://web.archive.org/web/20160320085053/http://www.miguelcasillas.com/?p=43)
 	/**
@@ -115,10 +218,22 @@ namespace SWAN
 
 	Intersection FindIntersection(AABB aabb, Line line)
 	{
+		double tMin = -std::numeric_limits<double>::infinity(), tMax = std::numeric_limits<double>::infinity();
+		if(!ClipToSlabs(aabb, line.point, line.vec, tMin, tMax))
+			return Intersection();
+
+		// The point where the line enters the box.
+		return PointIntersection(line.point + line.vec * tMin);
 	}
 
 	Intersection FindIntersection(AABB aabb, Ray ray)
 	{
+		double tMin = 0, tMax = std::numeric_limits<double>::infinity();
+		if(!ClipToSlabs(aabb, ray.start, ray.dir, tMin, tMax))
+			return Intersection();
+
+		// The point where the ray enters the box, or its start if it starts inside.
+		return PointIntersection(ray.start + ray.dir * tMin);
 	}
 
 	Intersection FindIntersection(AABB aabb, Segment segment)
@@ -172,12 +287,48 @@ namespace SWAN
 	}
 	Intersection FindIntersection(Sphere sphere, Line line)
 	{
+		// Solve |m + vec * t|^2 = r^2 for t.
+		vec3 m = line.point - sphere.center;
+		double a = Dot(line.vec, line.vec);
+		double b = Dot(m, line.vec);
+		double c = Dot(m, m) - (double) sphere.radius * sphere.radius;
+
+		double discriminant = b * b - a * c;
+		if(a == 0 || discriminant < 0)
+			return Intersection();
+
+		// The first of the two points.
+		double t = (-b - std::sqrt(discriminant)) / a;
+		return PointIntersection(line.point + line.vec * t);
 	}
 	Intersection FindIntersection(Sphere sphere, Ray ray)
 	{
+		vec3 m = ray.start - sphere.center;
+		double b = Dot(m, ray.dir);
+		double c = Dot(m, m) - (double) sphere.radius * sphere.radius;
+
+		// Starts outside and points away from the sphere.
+		if(c > 0 && b > 0)
+			return Intersection();
+
+		double discriminant = b * b - c;
+		if(discriminant < 0)
+			return Intersection();
+
+		// A negative t means the ray starts inside.
+		double t = std::max(-b - std::sqrt(discriminant), 0.0);
+		return PointIntersection(ray.start + ray.dir * t);
 	}
 	Intersection FindIntersection(Sphere sphere, Segment segment)
 	{
+		double length = segment.length();
+		if(length == 0)
+			return FindIntersection(sphere, segment.start);
+
+		Intersection res = FindIntersection(sphere, Ray(segment.start, segment.end - segment.start));
+		if(res.happened && Length(res.point - segment.start) > length)
+			return Intersection();
+		return res;
 	}
 	Intersection FindIntersection(Sphere sphere, AABB aabb)
 	{
@@ -198,21 +349,144 @@ namespace SWAN
 
 	Intersection FindIntersection(Triangle triangle, Line line)
 	{
-		Intersection i = FindIntersection(line, Plane(triangle));
+		double t;
+		if(!MollerTrumbore(triangle, line.point, line.vec, t))
+			return Intersection();
+
+		return PointIntersection(line.point + line.vec * t);
+	}
 
-		// If the plane the triangle lies on and the line don't intersect,
-		// the line and the triangle can't either.
-		if(!i.happened)
+	Intersection FindIntersection(Triangle triangle, Ray ray)
+	{
+		double t;
+		if(!MollerTrumbore(triangle, ray.start, ray.dir, t) || t < 0)
 			return Intersection();
 
-		//if(i.point)
+		return PointIntersection(ray.start + ray.dir * t);
 	}
 
-	Intersection FindIntersection(Triangle triangle, Segment segment) {}
-	Intersection FindIntersection(Triangle triangle, Plane plane) {}
+	Intersection FindIntersection(Triangle triangle, Segment segment)
+	{
+		// With the unnormalized direction, the segment is 0 <= t <= 1.
+		vec3 dir = segment.end - segment.start;
+		double t;
+		if(!MollerTrumbore(triangle, segment.start, dir, t) || t < 0 || t > 1)
+			return Intersection();
+
+		return PointIntersection(segment.start + dir * t);
+	}
+
+	// Separating axis test from Akenine-Moller, "Fast 3D Triangle-Box Overlap Testing".
+	Intersection FindIntersection(Triangle triangle, AABB aabb)
+	{
+		vec3 c = aabb.center(), e = (aabb.max - aabb.min) / 2;
+		vec3 v[3] = { triangle.points[0] - c, triangle.points[1] - c, triangle.points[2] - c };
+		vec3 edges[3] = { v[1] - v[0], v[2] - v[1], v[0] - v[2] };
+
+		// Projects the triangle and the box onto an axis, true if there's a gap between them.
+		auto separated = [&](vec3 axis) {
+			double p0 = Dot(v[0], axis), p1 = Dot(v[1], axis), p2 = Dot(v[2], axis);
+			double r = e.x * std::abs(axis.x) + e.y * std::abs(axis.y) + e.z * std::abs(axis.z);
+			return std::min(p0, std::min(p1, p2)) > r || std::max(p0, std::max(p1, p2)) < -r;
+		};
+
+		// The box's axes, the triangle's normal, and the crossings of the box's axes with the edges.
+		const vec3 axes[3] = { vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+		for(const vec3& axis : axes)
+			if(separated(axis))
+				return Intersection();
+		if(separated(Cross(edges[0], edges[1])))
+			return Intersection();
+		for(const vec3& axis : axes)
+			for(const vec3& edge : edges)
+				if(separated(Cross(axis, edge)))
+					return Intersection();
+
+		return PointIntersection(ClosestPoint(triangle, c));
+	}
+
+	Intersection FindIntersection(Triangle triangle, Sphere sphere)
+	{
+		vec3 p = ClosestPoint(triangle, sphere.center);
+		vec3 d = p - sphere.center;
+		if(Dot(d, d) > (double) sphere.radius * sphere.radius)
+			return Intersection();
+
+		return PointIntersection(p);
+	}
+
+	Intersection FindIntersection(Triangle triangle, Plane plane)
+	{
+		double d[3];
+		for(int i = 0; i < 3; i++)
+			d[i] = Dot(triangle.points[i], plane.normal) - plane.offset;
+
+		const double epsilon = std::numeric_limits<float>::epsilon();
+		if((d[0] > epsilon && d[1] > epsilon && d[2] > epsilon) || (d[0] < -epsilon && d[1] < -epsilon && d[2] < -epsilon))
+			return Intersection();
+
+		Intersection res;
+		res.happened = true;
+		if(std::abs(d[0]) <= epsilon && std::abs(d[1]) <= epsilon && std::abs(d[2]) <= epsilon) {
+			res.type = Intersection::Type::Triangle;
+			res.triangle = triangle;
+			return res;
+		}
+
+		// Where the edges cross the plane. A point on the plane is shared by two edges, so it can come up twice.
+		vec3 points[3];
+		int count = 0;
+		for(int i = 0; i < 3; i++) {
+			int j = (i + 1) % 3;
+			vec3 p;
+			if(std::abs(d[i]) <= epsilon)
+				p = triangle.points[i];
+			else if((d[i] < 0) != (d[j] < 0) && std::abs(d[j]) > epsilon)
+				p = triangle.points[i] + (triangle.points[j] - triangle.points[i]) * (d[i] / (d[i] - d[j]));
+			else
+				continue;
+
+			if(count == 0 || Length(p - points[0]) > epsilon)
+				points[count++] = p;
+		}
+
+		if(count == 1)
+			return PointIntersection(points[0]);
+
+		// The segment where they cross, from point to point + vec.
+		res.type = Intersection::Type::Line;
+		res.line.point = points[0];
+		res.line.vec = points[1] - points[0];
+		return res;
+	}
 
 	Intersection FindIntersection(Line l1, Line l2)
 	{
+		// Closest points of both lines, l1.point + l1.vec * s and l2.point + l2.vec * t.
+		vec3 r = l1.point - l2.point;
+		double a = Dot(l1.vec, l1.vec), b = Dot(l1.vec, l2.vec), c = Dot(l2.vec, l2.vec);
+		double d = Dot(l1.vec, r), e = Dot(l2.vec, r);
+		double denom = a * c - b * b;
+		const double epsilon = std::numeric_limits<float>::epsilon();
+
+		if(std::abs(denom) <= epsilon * a * c) {
+			// Parallel, they only meet if they're the same line.
+			vec3 offset = r - l2.vec * (e / c);
+			if(Length(offset) > epsilon)
+				return Intersection();
+
+			Intersection res;
+			res.happened = true;
+			res.type = Intersection::Type::Line;
+			res.line = l1;
+			return res;
+		}
+
+		double s = (b * e - c * d) / denom, t = (a * e - b * d) / denom;
+		vec3 p1 = l1.point + l1.vec * s, p2 = l2.point + l2.vec * t;
+		if(Length(p1 - p2) > epsilon * std::max(1.0, Length(p1)))
+			return Intersection();
+		return PointIntersection((p1 + p2) / 2);
 	}
 
 	Intersection FindIntersection(Triangle t1, Triangle t2)
@@ -231,10 +505,47 @@ namespace SWAN
 			return Intersection();
 		}
 
-	} // namespace SWAN
+		// If two triangles cross, the ends of the segment they share lie on their edges,
+		// so one of the six edges goes through the other triangle.
+		// Coplanar triangles aren't handled, their edges are parallel to the other triangle.
+		for(int i = 0; i < 3; i++) {
+			double t;
+			vec3 e = t1.points[(i + 1) % 3] - t1.points[i];
+			if(MollerTrumbore(t2, t1.points[i], e, t) && t >= 0 && t <= 1)
+				return PointIntersection(t1.points[i] + e * t);
+
+			e = t2.points[(i + 1) % 3] - t2.points[i];
+			if(MollerTrumbore(t1, t2.points[i], e, t) && t >= 0 && t <= 1)
+				return PointIntersection(t2.points[i] + e * t);
+		}
+		return Intersection();
+	}
 
 	Intersection FindIntersection(Plane p1, Plane p2)
 	{
+		vec3 dir = Cross(p1.normal, p2.normal);
+		double length2 = Dot(dir, dir);
+		const double epsilon = std::numeric_limits<float>::epsilon();
+
+		Intersection res;
+		if(length2 <= epsilon * epsilon) {
+			// Parallel, they only meet if they're the same plane (possibly facing the other way).
+			double offset = Dot(p1.normal, p2.normal) > 0 ? p2.offset : -p2.offset;
+			if(std::abs(p1.offset - offset) > epsilon)
+				return res;
+
+			res.happened = true;
+			res.type = Intersection::Type::Plane;
+			res.plane = p1;
+			return res;
+		}
+
+		// The point on both planes closest to the origin.
+		res.happened = true;
+		res.type = Intersection::Type::Line;
+		res.line.point = (Cross(p2.normal, dir) * p1.offset + Cross(dir, p1.normal) * p2.offset) / length2;
+		res.line.vec = dir / std::sqrt(length2);
+		return res;
 	}
 
 	Intersection FindIntersection(AABB a, AABB b)
@@ -3,6 +3,8 @@
 
 #include "Maths/Vector.hpp"
 #include "Transform.hpp"
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <vector>
 
@@ -108,28 +110,57 @@ namespace SWAN
 		/// Gets the volume of the bounding box.
 		inline double Volume() const { return XLen() * YLen() * ZLen(); }
 
-		AABB ApplyTransform(Transform t) const
-		{
-			AABB res;
+		/// Gets the surface area of the bounding box.
+		inline double SurfaceArea() const { return 2 * (XLen() * YLen() + YLen() * ZLen() + ZLen() * XLen()); }
 
-			auto rotMat = t.getRotMat();
-			res.min = vec4(min, 1) * rotMat;
-			res.max = vec4(max, 1) * rotMat;
+		/// Whether the two boxes overlap (touching counts). Cheaper than FindIntersection(AABB, AABB).
+		inline bool Overlaps(const AABB& o) const
+		{
+			return min.x <= o.max.x && max.x >= o.min.x
+			       && min.y <= o.max.y && max.y >= o.min.y
+			       && min.z <= o.max.z && max.z >= o.min.z;
+		}
 
-			res.min += t.pos;
-			res.max += t.pos;
+		/// Whether the other box is completely inside this one.
+		inline bool Contains(const AABB& o) const
+		{
+			return min.x <= o.min.x && min.y <= o.min.y && min.z <= o.min.z
+			       && max.x >= o.max.x && max.y >= o.max.y && max.z >= o.max.z;
+		}
 
-			vec3 tmp1 = res.min, tmp2 = res.max;
+		/// Get the smallest box that contains both boxes.
+		inline AABB Merged(const AABB& o) const
+		{
+			return AABB(vec3(std::min(min.x, o.min.x), std::min(min.y, o.min.y), std::min(min.z, o.min.z)),
+			            vec3(std::max(max.x, o.max.x), std::max(max.y, o.max.y), std::max(max.z, o.max.z)));
+		}
 
-			res.min.x = std::min(tmp1.x, tmp2.x);
-			res.min.y = std::min(tmp1.y, tmp2.y);
-			res.min.z = std::min(tmp1.z, tmp2.z);
+		/// Squared distance from a point to the box, 0 if the point is inside.
+		inline double DistanceSquared(const vec3& p) const
+		{
+			double dx = std::max<double>(std::max<double>(min.x - p.x, 0), p.x - max.x);
+			double dy = std::max<double>(std::max<double>(min.y - p.y, 0), p.y - max.y);
+			double dz = std::max<double>(std::max<double>(min.z - p.z, 0), p.z - max.z);
+			return dx * dx + dy * dy + dz * dz;
+		}
 
-			res.max.x = std::max(tmp1.x, tmp2.x);
-			res.max.y = std::max(tmp1.y, tmp2.y);
-			res.max.z = std::max(tmp1.z, tmp2.z);
+		/**
+		 * @brief Get the AABB that encloses this one after it's transformed by the Transform's Model matrix.
+		 *
+		 * Transforms the center and grows the half extents by the absolute values of the 3x3 part,
+		 * instead of transforming all 8 corners.
+		 */
+		AABB ApplyTransform(const Transform& t) const { return ApplyTransform(t.getModelAffine()); }
 
-			return res;
+		/// Same as ApplyTransform(const Transform&), with an already calculated matrix.
+		AABB ApplyTransform(const affine3x4& m) const
+		{
+			vec3 c = TransformPoint(m, center());
+			vec3 e = (max - min) / 2;
+			vec3 ext(std::abs(m(0, 0)) * e.x + std::abs(m(1, 0)) * e.y + std::abs(m(2, 0)) * e.z,
+			         std::abs(m(0, 1)) * e.x + std::abs(m(1, 1)) * e.y + std::abs(m(2, 1)) * e.z,
+			         std::abs(m(0, 2)) * e.x + std::abs(m(1, 2)) * e.y + std::abs(m(2, 2)) * e.z);
+			return AABB(c - ext, c + ext);
 		}
 	};
 
@@ -158,6 +189,67 @@ namespace SWAN
 		inline vec3 getPointOnPlane() { return normal * offset; }
 	};
 
+	/// Six planes facing inwards, a point is inside the frustum if it's in front of all of them.
+	struct Frustum {
+		enum PlaneIndex { Left, Right, Bottom, Top, Near, Far };
+
+		Plane planes[6];
+
+		/// Mask with a bit set for every plane.
+		static constexpr unsigned AllPlanes = 0x3F;
+
+		/// Extracts the planes from a projection * view matrix (Gribb & Hartmann).
+		static Frustum FromMatrix(const mat4& m)
+		{
+			auto row = [&](int y) { return vec4(m(0, y), m(1, y), m(2, y), m(3, y)); };
+			vec4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+			vec4 p[6] = { r3 + r0, r3 - r0, r3 + r1, r3 - r1, r3 + r2, r3 - r2 };
+
+			Frustum f;
+			for(int i = 0; i < 6; i++) {
+				vec3 n(p[i].x, p[i].y, p[i].z);
+				double len = Length(n);
+				// ax + by + cz + d >= 0 inside, the plane's offset is -d.
+				f.planes[i].normal = n / len;
+				f.planes[i].offset = -p[i].w / len;
+			}
+			return f;
+		}
+
+		/**
+		 * @brief Tests a box against the planes set in @p mask.
+		 *
+		 * @return false if the box is completely behind one of the planes.
+		 *         Planes the box is completely in front of are cleared from @p mask,
+		 *         so children of the box don't have to test them again.
+		 */
+		inline bool Overlaps(const AABB& box, unsigned& mask) const
+		{
+			for(int i = 0; i < 6; i++) {
+				if(!(mask & (1u << i)))
+					continue;
+
+				const Plane& p = planes[i];
+				// The corners furthest along and against the normal.
+				vec3 pos(p.normal.x >= 0 ? box.max.x : box.min.x, p.normal.y >= 0 ? box.max.y : box.min.y, p.normal.z >= 0 ? box.max.z : box.min.z);
+				vec3 neg(p.normal.x >= 0 ? box.min.x : box.max.x, p.normal.y >= 0 ? box.min.y : box.max.y, p.normal.z >= 0 ? box.min.z : box.max.z);
+
+				if(Dot(p.normal, pos) < p.offset)
+					return false;
+				if(Dot(p.normal, neg) >= p.offset)
+					mask &= ~(1u << i);
+			}
+			return true;
+		}
+
+		/// Whether the box is (at least partly) inside. Conservative: boxes near corners may pass.
+		inline bool Overlaps(const AABB& box) const
+		{
+			unsigned mask = AllPlanes;
+			return Overlaps(box, mask);
+		}
+	};
+
 	struct Sphere {
 		/// Center point of the sphere.
 		vec3 center;
@@ -208,6 +300,36 @@ namespace SWAN
 	// ---------------------------------------------------------------------------------------------------------- //
 	// ---------------------------------------------------------------------------------------------------------- //
 
+	/**
+	 * @brief Fast slab test of a ray against a box, for tree traversals.
+	 *
+	 * @param invDir 1 / the ray's direction, computed once per ray.
+	 * @param t Set to the distance at which the ray enters the box, 0 if it starts inside.
+	 *
+	 * @return Whether the ray enters the box within @p maxDistance.
+	 */
+	inline bool RayHitsAABB(const vec3& start, const vec3& invDir, const AABB& box, double maxDistance, double& t)
+	{
+		double t1 = (box.min.x - start.x) * invDir.x, t2 = (box.max.x - start.x) * invDir.x;
+		double tMin = std::min(t1, t2), tMax = std::max(t1, t2);
+
+		t1 = (box.min.y - start.y) * invDir.y;
+		t2 = (box.max.y - start.y) * invDir.y;
+		tMin = std::max(tMin, std::min(t1, t2));
+		tMax = std::min(tMax, std::max(t1, t2));
+
+		t1 = (box.min.z - start.z) * invDir.z;
+		t2 = (box.max.z - start.z) * invDir.z;
+		tMin = std::max(tMin, std::min(t1, t2));
+		tMax = std::min(tMax, std::max(t1, t2));
+
+		t = std::max(tMin, 0.0);
+		return tMax >= t && t <= maxDistance;
+	}
+
+	/// Finds the point on a triangle that's closest to @p p.
+	extern vec3 ClosestPoint(const Triangle& triangle, vec3 p);
+
 	/// Enumeration for HalfSpaceTest() result.
 	enum class HSResult {
 		/// The point is in front of the plane.
@@ -259,10 +381,15 @@ namespace SWAN
 	extern Intersection FindIntersection(Triangle triangle, Line line);
 	extern Intersection FindIntersection(Triangle triangle, Ray ray);
 	extern Intersection FindIntersection(Triangle triangle, Segment segment);
+	/// Where a triangle crosses a plane: a Line from point to point + vec along the segment they share, a Point if
+	/// only a corner touches, or the Triangle if it lies on the plane.
 	extern Intersection FindIntersection(Triangle triangle, Plane plane);
+	extern Intersection FindIntersection(Triangle triangle, AABB aabb);
+	extern Intersection FindIntersection(Triangle triangle, Sphere sphere);
 
 	extern Intersection FindIntersection(Line l1, Line l2);
 	extern Intersection FindIntersection(Triangle t1, Triangle t2);
+	/// Where two planes cross: a Line with a normalized vec, or the Plane if they are the same.
 	extern Intersection FindIntersection(Plane p1, Plane p2);
 	extern Intersection FindIntersection(AABB a1, AABB a2);
 	extern Intersection FindIntersection(Sphere s1, Sphere s2);
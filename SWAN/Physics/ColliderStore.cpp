@@ -0,0 +1,156 @@
+#include "ColliderStore.hpp"
+
+#include <limits> // For std::numeric_limits<T>
+
+#include "Maths/SIMD.hpp" // For SWAN::detail::WideLanes, SWAN::detail::ScalarLanes
+
+namespace SWAN
+{
+	constexpr ColliderStore::ProxyID ColliderStore::None;
+
+	namespace detail
+	{
+		/// A box broadcast to every lane.
+		template <typename L>
+		struct BroadcastBox {
+			BroadcastBox(vec3 min, vec3 max)
+			    : minX(L::Set(min.x)), minY(L::Set(min.y)), minZ(L::Set(min.z)),
+			      maxX(L::Set(max.x)), maxY(L::Set(max.y)), maxZ(L::Set(max.z)) {}
+
+			typename L::Type minX, minY, minZ, maxX, maxY, maxZ;
+		};
+
+		/// Tests a box against boxes [j, j + L::Width), returns a bit for every one that overlaps it.
+		template <typename L>
+		inline int OverlapMask(const BroadcastBox<L>& b, const PointStream& mins, const PointStream& maxs, std::size_t j)
+		{
+			typename L::Mask x = L::And(L::LessEqual(b.minX, L::Load(&maxs.x[j])), L::LessEqual(L::Load(&mins.x[j]), b.maxX));
+			typename L::Mask y = L::And(L::LessEqual(b.minY, L::Load(&maxs.y[j])), L::LessEqual(L::Load(&mins.y[j]), b.maxY));
+			typename L::Mask z = L::And(L::LessEqual(b.minZ, L::Load(&maxs.z[j])), L::LessEqual(L::Load(&mins.z[j]), b.maxZ));
+			return L::MoveMask(L::And(x, L::And(y, z)));
+		}
+
+		/// Calls @p emit with the index of every box in [begin, end) that overlaps box @p b,
+		/// in steps of L::Width. Stops early once the boxes' min X goes past box i's max X,
+		/// which is only useful when they're sorted. Returns the index of the first box it didn't test.
+		template <typename L, typename Emit>
+		std::size_t OverlapImpl(const BroadcastBox<L>& b, float maxX, const PointStream& mins, const PointStream& maxs,
+		                        std::size_t begin, std::size_t end, Emit& emit)
+		{
+			std::size_t j = begin;
+			for(; j + L::Width <= end && mins.x[j] <= maxX; j += L::Width) {
+				int bits = OverlapMask<L>(b, mins, maxs, j);
+				for(int lane = 0; bits; lane++, bits >>= 1)
+					if(bits & 1)
+						emit(j + lane);
+			}
+			return j;
+		}
+	} // namespace detail
+
+	ColliderStore::ProxyID ColliderStore::insert(const AABB& box, std::uint32_t data)
+	{
+		ProxyID id;
+		if(freeIDs.empty()) {
+			id = slots.size();
+			slots.push_back(0);
+			orderPositions.push_back(0);
+		} else {
+			id = freeIDs.back();
+			freeIDs.pop_back();
+		}
+
+		slots[id] = ids.size();
+		mins.push_back(box.min);
+		maxs.push_back(box.max);
+		userData.push_back(data);
+		ids.push_back(id);
+
+		// Sorted into place by the next queryPairs().
+		orderPositions[id] = order.size();
+		order.push_back(id);
+		return id;
+	}
+
+	void ColliderStore::remove(ProxyID proxy)
+	{
+		// Move the last box into the hole.
+		std::uint32_t slot = slots[proxy], last = ids.size() - 1;
+		mins.set(slot, mins.get(last));
+		maxs.set(slot, maxs.get(last));
+		userData[slot] = userData[last];
+		ids[slot] = ids[last];
+		slots[ids[slot]] = slot;
+
+		mins.resize(last);
+		maxs.resize(last);
+		userData.pop_back();
+		ids.pop_back();
+
+		// Same for the order, the next queryPairs() sorts the moved ID back into place.
+		std::uint32_t pos = orderPositions[proxy];
+		order[pos] = order.back();
+		orderPositions[order[pos]] = pos;
+		order.pop_back();
+
+		freeIDs.push_back(proxy);
+	}
+
+	void ColliderStore::move(ProxyID proxy, const AABB& box, vec3)
+	{
+		mins.set(slots[proxy], box.min);
+		maxs.set(slots[proxy], box.max);
+	}
+
+	void ColliderStore::query(const AABB& box, Vector<ProxyID>& out) const
+	{
+		out.clear();
+
+		auto emit = [&](std::size_t j) { out.push_back(ids[j]); };
+
+		// Nothing's sorted, so the early stop is disabled with an infinite max X.
+		const float maxX = std::numeric_limits<float>::infinity();
+		std::size_t j = detail::OverlapImpl(detail::BroadcastBox<detail::WideLanes>(box.min, box.max), maxX, mins, maxs, 0, ids.size(), emit);
+		detail::OverlapImpl(detail::BroadcastBox<detail::ScalarLanes>(box.min, box.max), maxX, mins, maxs, j, ids.size(), emit);
+	}
+
+	void ColliderStore::queryPairs(Vector<Pair>& out)
+	{
+		out.clear();
+		std::size_t n = ids.size();
+
+		// Boxes move a little between steps, so the last order is nearly sorted already.
+		for(std::size_t i = 1; i < n; i++) {
+			ProxyID id = order[i];
+			float key = mins.x[slots[id]];
+			std::size_t j = i;
+			for(; j > 0 && mins.x[slots[order[j - 1]]] > key; j--)
+				order[j] = order[j - 1];
+			order[j] = id;
+		}
+
+		sortedMins.resize(n);
+		sortedMaxs.resize(n);
+		for(std::size_t i = 0; i < n; i++) {
+			sortedMins.set(i, mins.get(slots[order[i]]));
+			sortedMaxs.set(i, maxs.get(slots[order[i]]));
+			orderPositions[order[i]] = i;
+		}
+
+		// Sweep along X: every box only has to be tested against the boxes after it
+		// that start before it ends.
+		for(std::size_t i = 0; i < n; i++) {
+			ProxyID a = order[i];
+			vec3 min = sortedMins.get(i), max = sortedMaxs.get(i);
+			auto emit = [&](std::size_t j) {
+				ProxyID b = order[j];
+				out.push_back(a < b ? Pair{ a, b } : Pair{ b, a });
+			};
+
+			std::size_t j = detail::OverlapImpl(detail::BroadcastBox<detail::WideLanes>(min, max), sortedMaxs.x[i],
+			                                    sortedMins, sortedMaxs, i + 1, n, emit);
+			detail::OverlapImpl(detail::BroadcastBox<detail::ScalarLanes>(min, max), sortedMaxs.x[i],
+			                    sortedMins, sortedMaxs, j, n, emit);
+		}
+	}
+} // namespace SWAN
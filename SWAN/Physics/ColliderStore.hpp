@@ -0,0 +1,91 @@
+#ifndef SWAN_COLLIDER_STORE_HPP
+#define SWAN_COLLIDER_STORE_HPP
+
+#include <cstdint> // For std::uint32_t
+
+#include "Basic.hpp"             // For SWAN::AABB
+#include "Core/Defs.hpp"         // For SWAN::Vector<T>
+#include "Maths/PointStream.hpp" // For SWAN::PointStream
+
+namespace SWAN
+{
+	/**
+	 * @brief Boxes stored as structure of arrays, with SIMD overlap tests.
+	 *
+	 * The mins and maxs are kept packed in one float array per axis, so one box
+	 * is tested against 4 (SSE) or 8 (AVX) others per instruction, and hits are
+	 * written out as a compact list of pairs.
+	 *
+	 * queryPairs() sorts the boxes along X (an insertion sort, since the order barely
+	 * changes between steps) and only tests the boxes whose X ranges overlap.
+	 * Has the same interface as AABBTree, so it can be used as a PhysicsWorld broadphase,
+	 * which works well for up to a few thousand boxes.
+	 */
+	class ColliderStore
+	{
+	  public:
+		using ProxyID = std::uint32_t;
+
+		/// ID of a proxy that doesn't exist.
+		static constexpr ProxyID None = ~ProxyID(0);
+
+		/// A pair of overlapping proxies, a < b.
+		struct Pair {
+			ProxyID a, b;
+		};
+
+		ProxyID insert(const AABB& box, std::uint32_t userData);
+
+		/// Remove a proxy. The last box takes its place in the arrays.
+		void remove(ProxyID proxy);
+
+		/// Update the box of a proxy. The displacement is only there for compatibility with AABBTree.
+		void move(ProxyID proxy, const AABB& box, vec3 displacement = vec3(0));
+
+		/// Get the user data that was passed to insert().
+		inline std::uint32_t getUserData(ProxyID proxy) const { return userData[slots[proxy]]; }
+
+		/// Get the box of a proxy.
+		inline AABB getAABB(ProxyID proxy) const { return AABB(mins.get(slots[proxy]), maxs.get(slots[proxy])); }
+
+		/// Whether the boxes of two proxies overlap.
+		inline bool overlaps(ProxyID a, ProxyID b) const
+		{
+			std::uint32_t i = slots[a], j = slots[b];
+			return mins.x[i] <= maxs.x[j] && mins.x[j] <= maxs.x[i]
+			       && mins.y[i] <= maxs.y[j] && mins.y[j] <= maxs.y[i]
+			       && mins.z[i] <= maxs.z[j] && mins.z[j] <= maxs.z[i];
+		}
+
+		/// Fills @p out with the ID of every proxy whose box overlaps @p box. Tests every box.
+		void query(const AABB& box, Vector<ProxyID>& out) const;
+
+		/// Fills @p out with every pair of proxies whose boxes overlap. Each pair is reported once.
+		void queryPairs(Vector<Pair>& out);
+
+		/// Number of proxies.
+		inline unsigned size() const { return ids.size(); }
+
+		/// The packed boxes, in no particular order.
+		inline const PointStream& getMins() const { return mins; }
+		inline const PointStream& getMaxs() const { return maxs; }
+
+	  private:
+		/// Boxes, user data and IDs, packed by slot.
+		PointStream mins, maxs;
+		Vector<std::uint32_t> userData;
+		Vector<ProxyID> ids;
+
+		/// Slot of every ID.
+		Vector<std::uint32_t> slots;
+		Vector<ProxyID> freeIDs;
+
+		/// IDs sorted by min X as of the last queryPairs(), and their boxes in that order.
+		Vector<ProxyID> order;
+		/// Position of every ID in order, so remove() doesn't have to search for it.
+		Vector<std::uint32_t> orderPositions;
+		PointStream sortedMins, sortedMaxs;
+	};
+} // namespace SWAN
+
+#endif
@@ -0,0 +1,216 @@
+#include "ContactManifold.hpp"
+
+#include <algorithm> // For std::min(), std::max()
+#include <cmath>     // For std::sqrt()
+
+namespace SWAN
+{
+	constexpr unsigned ContactManifold::MaxPoints;
+
+	void ContactManifold::WarmStartFrom(const ContactManifold& old)
+	{
+		for(unsigned i = 0; i < count; i++) {
+			for(unsigned j = 0; j < old.count; j++) {
+				if(points[i].feature != old.points[j].feature)
+					continue;
+
+				points[i].normalImpulse = old.points[j].normalImpulse;
+				points[i].tangentImpulse[0] = old.points[j].tangentImpulse[0];
+				points[i].tangentImpulse[1] = old.points[j].tangentImpulse[1];
+				break;
+			}
+		}
+	}
+
+	bool FindContact(const AABB& a, const AABB& b, ContactManifold& out)
+	{
+		const double aMin[3] = { a.min.x, a.min.y, a.min.z }, aMax[3] = { a.max.x, a.max.y, a.max.z };
+		const double bMin[3] = { b.min.x, b.min.y, b.min.z }, bMax[3] = { b.max.x, b.max.y, b.max.z };
+
+		// The overlap of the two boxes, and the axis it's thinnest along.
+		double lo[3], hi[3];
+		int axis = 0;
+		for(int i = 0; i < 3; i++) {
+			lo[i] = std::max(aMin[i], bMin[i]);
+			hi[i] = std::min(aMax[i], bMax[i]);
+			if(hi[i] < lo[i])
+				return false;
+			if(hi[i] - lo[i] < hi[axis] - lo[axis])
+				axis = i;
+		}
+
+		// Push apart along the axis, away from A's center.
+		bool positive = bMin[axis] + bMax[axis] > aMin[axis] + aMax[axis];
+		double n[3] = { 0, 0, 0 };
+		n[axis] = positive ? 1 : -1;
+		out.normal = vec3(n[0], n[1], n[2]);
+
+		// The corners of the overlap's face across the axis, halfway through it.
+		int u = (axis + 1) % 3, v = (axis + 2) % 3;
+		double depth = hi[axis] - lo[axis];
+		out.count = 4;
+		for(unsigned corner = 0; corner < 4; corner++) {
+			double p[3];
+			p[axis] = (lo[axis] + hi[axis]) / 2;
+			p[u] = corner & 1 ? hi[u] : lo[u];
+			p[v] = corner & 2 ? hi[v] : lo[v];
+
+			ContactPoint& point = out.points[corner];
+			point = ContactPoint();
+			point.position = vec3(p[0], p[1], p[2]);
+			point.depth = depth;
+			point.feature = (axis * 2 + positive) * 4 + corner;
+		}
+		return true;
+	}
+
+	bool FindContact(const AABB& a, const Plane& b, ContactManifold& out)
+	{
+		vec3 corners[8];
+		for(unsigned i = 0; i < 8; i++)
+			corners[i] = vec3(i & 1 ? a.max.x : a.min.x, i & 2 ? a.max.y : a.min.y, i & 4 ? a.max.z : a.min.z);
+		return FindContact(corners, 8, b, out);
+	}
+
+	bool FindContact(const vec3* vertices, unsigned count, const Plane& b, ContactManifold& out)
+	{
+		struct Vertex {
+			double distance;
+			unsigned index;
+		};
+
+		// Only the deepest MaxPoints are kept, in a small sorted list.
+		Vertex deepest[ContactManifold::MaxPoints];
+		unsigned found = 0;
+		for(unsigned i = 0; i < count; i++) {
+			double distance = Dot(vertices[i], b.normal) - b.offset;
+			if(distance > 0)
+				continue;
+
+			// Ties go to the lower index, so the choice is stable between steps.
+			unsigned j = std::min(found, ContactManifold::MaxPoints - 1);
+			if(found == ContactManifold::MaxPoints && distance >= deepest[j].distance)
+				continue;
+			for(; j > 0 && deepest[j - 1].distance > distance; j--)
+				deepest[j] = deepest[j - 1];
+			deepest[j] = { distance, i };
+			found = std::min(found + 1, ContactManifold::MaxPoints);
+		}
+		if(found == 0)
+			return false;
+
+		out.normal = -b.normal;
+		out.count = found;
+		for(unsigned i = 0; i < found; i++) {
+			ContactPoint& point = out.points[i];
+			point = ContactPoint();
+			point.position = vertices[deepest[i].index] - b.normal * (deepest[i].distance / 2);
+			point.depth = -deepest[i].distance;
+			point.feature = deepest[i].index;
+		}
+		return true;
+	}
+
+	/// Sets up a manifold with a single point.
+	static void SinglePoint(ContactManifold& out, vec3 normal, vec3 position, double depth)
+	{
+		out.normal = normal;
+		out.count = 1;
+		out.points[0] = ContactPoint();
+		out.points[0].position = position;
+		out.points[0].depth = depth;
+	}
+
+	bool FindContact(const Sphere& a, const Sphere& b, ContactManifold& out)
+	{
+		vec3 d = b.center - a.center;
+		double distance = Length(d), radii = (double) a.radius + b.radius;
+		if(distance >= radii)
+			return false;
+
+		// Concentric spheres have no direction between them, any will do.
+		vec3 n = distance > 0 ? d / distance : vec3(0, 1, 0);
+		double depth = radii - distance;
+		SinglePoint(out, n, a.center + n * (a.radius - depth / 2), depth);
+		return true;
+	}
+
+	bool FindContact(const Sphere& a, const AABB& b, ContactManifold& out)
+	{
+		vec3 p(std::max(b.min.x, std::min(a.center.x, b.max.x)),
+		       std::max(b.min.y, std::min(a.center.y, b.max.y)),
+		       std::max(b.min.z, std::min(a.center.z, b.max.z)));
+		vec3 d = p - a.center;
+		double distance2 = Dot(d, d);
+		if(distance2 >= (double) a.radius * a.radius)
+			return false;
+
+		if(distance2 > 0) {
+			double distance = std::sqrt(distance2);
+			vec3 n = d / distance;
+			double depth = a.radius - distance;
+			SinglePoint(out, n, p - n * (depth / 2), depth);
+			return true;
+		}
+
+		// The center is inside the box, it leaves through the closest face.
+		const double toMin[3] = { a.center.x - b.min.x, a.center.y - b.min.y, a.center.z - b.min.z };
+		const double toMax[3] = { b.max.x - a.center.x, b.max.y - a.center.y, b.max.z - a.center.z };
+		int axis = 0;
+		bool positive = toMax[0] < toMin[0];
+		double closest = std::min(toMin[0], toMax[0]);
+		for(int i = 1; i < 3; i++) {
+			if(std::min(toMin[i], toMax[i]) < closest) {
+				axis = i;
+				positive = toMax[i] < toMin[i];
+				closest = std::min(toMin[i], toMax[i]);
+			}
+		}
+
+		// The sphere leaves through the face, so B is pushed the other way.
+		double n[3] = { 0, 0, 0 };
+		n[axis] = positive ? -1 : 1;
+		SinglePoint(out, vec3(n[0], n[1], n[2]), a.center, closest + a.radius);
+		return true;
+	}
+
+	bool FindContact(const AABB& a, const Sphere& b, ContactManifold& out)
+	{
+		if(!FindContact(b, a, out))
+			return false;
+		out.Flip();
+		return true;
+	}
+
+	bool FindContact(const Sphere& a, const Plane& b, ContactManifold& out)
+	{
+		double distance = Dot(a.center, b.normal) - b.offset;
+		double depth = a.radius - distance;
+		if(depth <= 0)
+			return false;
+
+		SinglePoint(out, -b.normal, a.center - b.normal * (a.radius - depth / 2), depth);
+		return true;
+	}
+
+	void ContactCache::beginStep()
+	{
+		previous.swap(current);
+		current.clear();
+		cursor = 0;
+	}
+
+	ContactCache::Contact& ContactCache::add(std::uint32_t a, std::uint32_t b, const ContactManifold& manifold)
+	{
+		current.push_back({ a, b, manifold });
+		Contact& c = current.back();
+
+		// Both lists are sorted, so the old contact (if any) is at or after the cursor.
+		while(cursor < previous.size() && (previous[cursor].a < a || (previous[cursor].a == a && previous[cursor].b < b)))
+			cursor++;
+		if(cursor < previous.size() && previous[cursor].a == a && previous[cursor].b == b)
+			c.manifold.WarmStartFrom(previous[cursor].manifold);
+
+		return c;
+	}
+} // namespace SWAN
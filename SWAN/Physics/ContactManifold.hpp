@@ -0,0 +1,105 @@
+#ifndef SWAN_PHYS_CONTACT_MANIFOLD_HPP
+#define SWAN_PHYS_CONTACT_MANIFOLD_HPP
+
+#include <cstdint> // For std::uint32_t
+
+#include "Basic.hpp"         // For SWAN::AABB, SWAN::Plane, SWAN::Sphere
+#include "Core/Defs.hpp"     // For SWAN::Vector<T>
+#include "Maths/Vector.hpp"  // For SWAN::vec3
+
+namespace SWAN
+{
+	/// A point where two shapes touch, and what the solver knows about it.
+	struct ContactPoint {
+		vec3 position;
+
+		/// How far the shapes overlap along the manifold's normal.
+		double depth = 0;
+
+		/// Identifies which parts of the shapes touch here, so the point can be matched
+		/// with the same point from the last step.
+		std::uint32_t feature = 0;
+
+		/// Impulses accumulated by the solver, kept across steps to warm start it.
+		double normalImpulse = 0;
+		double tangentImpulse[2] = { 0, 0 };
+
+		/// Set up by PrepareContact().
+		double normalMass = 0, tangentMass = 0, bias = 0;
+	};
+
+	/// Up to 4 points where two shapes A and B touch, sharing a normal.
+	struct ContactManifold {
+		static constexpr unsigned MaxPoints = 4;
+
+		/// Points from A to B.
+		vec3 normal;
+		vec3 tangents[2];
+
+		unsigned count = 0;
+		ContactPoint points[MaxPoints];
+
+		/// Swaps A and B.
+		inline void Flip() { normal = -normal; }
+
+		/// Copies the accumulated impulses of the points of @p old with the same features.
+		void WarmStartFrom(const ContactManifold& old);
+	};
+
+	/// Finds the contact between two boxes. The normal is the axis they overlap the least along.
+	/// Returns false if they don't touch.
+	extern bool FindContact(const AABB& a, const AABB& b, ContactManifold& out);
+
+	/// Finds the contact between a box (A) and the solid side behind a plane (B), at the
+	/// (up to 4 deepest) corners of the box that are behind it. Returns false if there are none.
+	extern bool FindContact(const AABB& a, const Plane& b, ContactManifold& out);
+
+	/// Same as FindContact(const AABB&, const Plane&, ContactManifold&) for any convex shape
+	/// given by its vertices. The index of a vertex is its point's feature.
+	extern bool FindContact(const vec3* vertices, unsigned count, const Plane& b, ContactManifold& out);
+
+	/// Finds the contact between two spheres, at one point halfway into the overlap along the line between their centers.
+	extern bool FindContact(const Sphere& a, const Sphere& b, ContactManifold& out);
+
+	/// Finds the contact between a sphere and a box, at one point along the shortest way out of the box.
+	extern bool FindContact(const Sphere& a, const AABB& b, ContactManifold& out);
+	extern bool FindContact(const AABB& a, const Sphere& b, ContactManifold& out);
+
+	/// Finds the contact between a sphere and the solid side behind a plane, at one point.
+	extern bool FindContact(const Sphere& a, const Plane& b, ContactManifold& out);
+
+	/**
+	 * @brief Keeps the manifolds of the last step, to warm start the ones found in this step.
+	 *
+	 * Every step, call beginStep() and then add() with the manifold of every touching pair,
+	 * in increasing order of (a, b). The cached manifolds are kept in the same order, so
+	 * matching a new pair with its old manifold is one merge over both lists.
+	 */
+	class ContactCache
+	{
+	  public:
+		struct Contact {
+			std::uint32_t a, b;
+			ContactManifold manifold;
+		};
+
+		/// Forgets the manifolds from two steps ago, and starts collecting this step's.
+		void beginStep();
+
+		/// Adds the manifold of the pair (a, b) and warm starts it from the last step, if
+		/// the pair touched then. Pairs have to be added in increasing order.
+		Contact& add(std::uint32_t a, std::uint32_t b, const ContactManifold& manifold);
+
+		/// The contacts added since beginStep().
+		inline Vector<Contact>& getContacts() { return current; }
+		inline const Vector<Contact>& getContacts() const { return current; }
+
+	  private:
+		Vector<Contact> current, previous;
+
+		/// First contact in previous that hasn't been passed by add() yet.
+		std::size_t cursor = 0;
+	};
+} // namespace SWAN
+
+#endif
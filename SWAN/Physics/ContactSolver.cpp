@@ -0,0 +1,63 @@
+#include "ContactSolver.hpp"
+
+#include <algorithm> // For std::max(), std::min()
+#include <cmath>     // For std::abs()
+
+namespace SWAN
+{
+	/// Applies an impulse from A to B: pushes B along it and A against it.
+	static inline void ApplyImpulse(SolverBody& a, SolverBody& b, vec3 impulse)
+	{
+		if(a.inverseMass > 0)
+			a.velocity -= impulse * a.inverseMass;
+		if(b.inverseMass > 0)
+			b.velocity += impulse * b.inverseMass;
+	}
+
+	void PrepareContact(ContactManifold& manifold, SolverBody& a, SolverBody& b, double dt, const SolverSettings& settings)
+	{
+		// Any two directions across the normal.
+		vec3 n = manifold.normal;
+		vec3 axis = std::abs(n.x) < 0.57 ? vec3(1, 0, 0) : vec3(0, 1, 0);
+		manifold.tangents[0] = Normalized(Cross(n, axis));
+		manifold.tangents[1] = Cross(n, manifold.tangents[0]);
+
+		double inverseMass = a.inverseMass + b.inverseMass;
+		double mass = inverseMass > 0 ? 1 / inverseMass : 0;
+
+		for(unsigned i = 0; i < manifold.count; i++) {
+			ContactPoint& p = manifold.points[i];
+
+			// Bodies don't rotate, so the effective mass is the same along every direction.
+			p.normalMass = p.tangentMass = mass;
+			p.bias = settings.baumgarte / dt * std::max(0.0, p.depth - settings.slop);
+
+			ApplyImpulse(a, b, n * p.normalImpulse + manifold.tangents[0] * p.tangentImpulse[0] + manifold.tangents[1] * p.tangentImpulse[1]);
+		}
+	}
+
+	void SolveContact(ContactManifold& manifold, SolverBody& a, SolverBody& b, const SolverSettings& settings)
+	{
+		vec3 n = manifold.normal;
+		for(unsigned i = 0; i < manifold.count; i++) {
+			ContactPoint& p = manifold.points[i];
+
+			// Friction first, limited by the normal impulse from the last iteration.
+			double limit = settings.friction * p.normalImpulse;
+			for(int t = 0; t < 2; t++) {
+				vec3 tangent = manifold.tangents[t];
+				double vt = Dot(b.velocity - a.velocity, tangent);
+				double old = p.tangentImpulse[t];
+				p.tangentImpulse[t] = std::max(-limit, std::min(limit, old - vt * p.tangentMass));
+				ApplyImpulse(a, b, tangent * (p.tangentImpulse[t] - old));
+			}
+
+			// A approaches B when the relative velocity is against the normal. The accumulated
+			// impulse can only push, but a single iteration may take some of it back.
+			double vn = Dot(b.velocity - a.velocity, n);
+			double old = p.normalImpulse;
+			p.normalImpulse = std::max(0.0, old + (p.bias - vn) * p.normalMass);
+			ApplyImpulse(a, b, n * (p.normalImpulse - old));
+		}
+	}
+} // namespace SWAN
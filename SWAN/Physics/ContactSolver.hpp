@@ -0,0 +1,40 @@
+#ifndef SWAN_PHYS_CONTACT_SOLVER_HPP
+#define SWAN_PHYS_CONTACT_SOLVER_HPP
+
+#include "ContactManifold.hpp" // For SWAN::ContactManifold
+#include "Maths/Vector.hpp"    // For SWAN::vec3
+
+namespace SWAN
+{
+	/// The state of a body the contact solver changes. Bodies don't rotate.
+	struct SolverBody {
+		vec3 velocity;
+
+		/// 0 for bodies that can't be moved, their velocity is never written.
+		double inverseMass = 0;
+	};
+
+	struct SolverSettings {
+		/// Velocity iterations per step. Warm starting makes stacks converge in a few.
+		unsigned iterations = 4;
+
+		/// Coulomb friction coefficient.
+		double friction = 0.5;
+
+		/// Fraction of the overlap pushed out per step, and overlap that's left alone so contacts persist.
+		double baumgarte = 0.2, slop = 0.01;
+	};
+
+	/**
+	 * @brief Sets up a manifold for SolveContact() and applies its warm start impulses.
+	 *
+	 * A sequential impulse solver: call PrepareContact() once for every manifold, then
+	 * SolveContact() for every manifold, settings.iterations times.
+	 */
+	extern void PrepareContact(ContactManifold& manifold, SolverBody& a, SolverBody& b, double dt, const SolverSettings& settings);
+
+	/// Runs one iteration on a manifold: updates the accumulated impulses of its points and the velocities.
+	extern void SolveContact(ContactManifold& manifold, SolverBody& a, SolverBody& b, const SolverSettings& settings);
+} // namespace SWAN
+
+#endif
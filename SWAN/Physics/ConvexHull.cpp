@@ -0,0 +1,480 @@
+#include "ConvexHull.hpp"
+
+#include <algorithm> // For std::swap()
+#include <limits>    // For std::numeric_limits<T>
+
+#include "Maths/SIMD.hpp" // For SWAN::detail::WideLanes, SWAN::detail::ScalarLanes
+
+namespace SWAN
+{
+	namespace detail
+	{
+		template <typename L>
+		inline typename L::Type DotLanes(const PointStream& p, std::size_t i, typename L::Type dx, typename L::Type dy, typename L::Type dz)
+		{
+			return L::Add(L::Add(L::Mul(L::Load(&p.x[i]), dx), L::Mul(L::Load(&p.y[i]), dy)), L::Mul(L::Load(&p.z[i]), dz));
+		}
+
+		// Both kernels process points [begin, end) in steps of L::Width
+		// and return the index of the first point they didn't process.
+
+		/// Raises @p best to the largest dot product of a point with the direction.
+		template <typename L>
+		std::size_t MaxDotImpl(const PointStream& p, vec3 dir, float& best, std::size_t begin, std::size_t end)
+		{
+			using T = typename L::Type;
+			const T dx = L::Set(dir.x), dy = L::Set(dir.y), dz = L::Set(dir.z);
+
+			T m = L::Set(best);
+			std::size_t i = begin;
+			for(; i + L::Width <= end; i += L::Width)
+				m = L::Max(m, DotLanes<L>(p, i, dx, dy, dz));
+
+			float lanes[L::Width];
+			L::Store(lanes, m);
+			for(float f : lanes)
+				best = std::max(best, f);
+			return i;
+		}
+
+		/// Sets @p found to the first point whose dot product with the direction reaches @p target.
+		/// Stops there, so it returns @p end once it found one.
+		template <typename L>
+		std::size_t FindDotImpl(const PointStream& p, vec3 dir, float target, std::size_t& found, std::size_t begin, std::size_t end)
+		{
+			using T = typename L::Type;
+			const T dx = L::Set(dir.x), dy = L::Set(dir.y), dz = L::Set(dir.z), t = L::Set(target);
+
+			std::size_t i = begin;
+			for(; i + L::Width <= end; i += L::Width) {
+				int bits = L::MoveMask(L::LessEqual(t, DotLanes<L>(p, i, dx, dy, dz)));
+				if(bits) {
+					int lane = 0;
+					for(; !(bits & 1); bits >>= 1)
+						lane++;
+					found = i + lane;
+					return end;
+				}
+			}
+			return i;
+		}
+
+		/// A shape that GJK can work with, without knowing its type.
+		struct SupportMapping {
+			const void* shape;
+			vec3 (*support)(const void* shape, vec3 dir);
+			vec3 center;
+		};
+
+		inline SupportMapping MakeSupport(const ConvexHull& hull)
+		{
+			return { &hull, [](const void* s, vec3 d) { return static_cast<const ConvexHull*>(s)->Support(d); }, hull.Points.get(0) };
+		}
+
+		inline SupportMapping MakeSupport(const OBB& box)
+		{
+			return { &box, [](const void* s, vec3 d) { return static_cast<const OBB*>(s)->Support(d); }, box.center };
+		}
+
+		/// A point of the Minkowski difference A - B, and the points of A and B it came from.
+		struct SupportPoint {
+			vec3 w, a, b;
+		};
+
+		inline SupportPoint Support(const SupportMapping& a, const SupportMapping& b, vec3 dir)
+		{
+			SupportPoint p;
+			p.a = a.support(a.shape, dir);
+			p.b = b.support(b.shape, -dir);
+			p.w = p.a - p.b;
+			return p;
+		}
+	} // namespace detail
+
+	constexpr std::size_t ConvexHull::None;
+
+	std::size_t ConvexHull::SupportIndex(vec3 dir) const
+	{
+		std::size_t n = Points.size();
+		if(n == 0)
+			return None;
+
+		float best = -std::numeric_limits<float>::infinity();
+		std::size_t i = detail::MaxDotImpl<detail::WideLanes>(Points, dir, best, 0, n);
+		detail::MaxDotImpl<detail::ScalarLanes>(Points, dir, best, i, n);
+
+		// Same arithmetic as above, so the best point compares equal.
+		std::size_t found = 0;
+		i = detail::FindDotImpl<detail::WideLanes>(Points, dir, best, found, 0, n);
+		detail::FindDotImpl<detail::ScalarLanes>(Points, dir, best, found, i, n);
+		return found;
+	}
+
+	AABB ConvexHull::GetAABB() const
+	{
+		if(Empty())
+			return AABB(vec3(0), vec3(0));
+
+		AABB box(Points.get(0), Points.get(0));
+		for(std::size_t i = 1; i < Points.size(); i++)
+			box = box.Merged(AABB(Points.get(i), Points.get(i)));
+		return box;
+	}
+
+	ConvexHull ConvexHull::Transformed(const mat4& m) const
+	{
+		ConvexHull res;
+		TransformPoints(m, Points, res.Points);
+		return res;
+	}
+
+	// ------------------------------------------------ GJK ------------------------------------------------ //
+
+	using detail::SupportMapping;
+	using detail::SupportPoint;
+
+	/// Direction from the segment towards the origin, or the newest point alone if the origin is behind it.
+	static void LineCase(SupportPoint* s, unsigned& n, vec3& d)
+	{
+		const SupportPoint a = s[1], b = s[0];
+		vec3 ab = b.w - a.w, ao = -a.w;
+		if(Dot(ab, ao) > 0) {
+			d = Cross(Cross(ab, ao), ab);
+		} else {
+			s[0] = a;
+			n = 1;
+			d = ao;
+		}
+	}
+
+	/// Reduces a triangle to the feature closest to the origin. The newest point is last.
+	static void TriangleCase(SupportPoint* s, unsigned& n, vec3& d)
+	{
+		const SupportPoint a = s[2], b = s[1], c = s[0];
+		vec3 ab = b.w - a.w, ac = c.w - a.w, ao = -a.w;
+		vec3 abc = Cross(ab, ac);
+
+		if(Dot(Cross(abc, ac), ao) > 0) {
+			if(Dot(ac, ao) > 0) {
+				s[0] = c;
+				s[1] = a;
+				n = 2;
+				d = Cross(Cross(ac, ao), ac);
+				return;
+			}
+		} else if(Dot(Cross(ab, abc), ao) <= 0) {
+			// Above or below the triangle.
+			if(Dot(abc, ao) > 0) {
+				d = abc;
+			} else {
+				s[0] = b;
+				s[1] = c;
+				d = -abc;
+			}
+			return;
+		}
+
+		s[0] = b;
+		s[1] = a;
+		n = 2;
+		LineCase(s, n, d);
+	}
+
+	/// Updates the simplex and the search direction, returns true if the simplex contains the origin.
+	static bool DoSimplex(SupportPoint* s, unsigned& n, vec3& d)
+	{
+		if(n == 2) {
+			LineCase(s, n, d);
+			return false;
+		}
+		if(n == 3) {
+			TriangleCase(s, n, d);
+			return false;
+		}
+
+		// The origin was on the newest point's side of the old triangle, so only the
+		// three faces around the newest point have to be checked.
+		const SupportPoint a = s[3], b = s[2], c = s[1], e = s[0];
+		const SupportPoint faces[3][3] = { { c, b, a }, { e, c, a }, { b, e, a } };
+		const vec3 opposite[3] = { e.w, b.w, c.w };
+		for(int i = 0; i < 3; i++) {
+			vec3 normal = Cross(faces[i][1].w - faces[i][2].w, faces[i][0].w - faces[i][2].w);
+			if(Dot(normal, opposite[i] - a.w) > 0)
+				normal = -normal;
+
+			if(Dot(normal, -a.w) > 0) {
+				s[0] = faces[i][0];
+				s[1] = faces[i][1];
+				s[2] = faces[i][2];
+				n = 3;
+				TriangleCase(s, n, d);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// Runs GJK. Returns true if the shapes overlap, with a simplex that encloses the origin
+	/// (fewer than 4 points if the origin is on one of its faces).
+	static bool GJK(const SupportMapping& a, const SupportMapping& b, SupportPoint* s, unsigned& n)
+	{
+		vec3 d = b.center - a.center;
+		if(Dot(d, d) < 1e-12)
+			d = vec3(1, 0, 0);
+
+		s[0] = detail::Support(a, b, d);
+		n = 1;
+		d = -s[0].w;
+
+		for(int iteration = 0; iteration < 64; iteration++) {
+			if(Dot(d, d) < 1e-12)
+				return true;
+
+			SupportPoint p = detail::Support(a, b, d);
+			if(Dot(p.w, d) <= 0)
+				return false;
+
+			s[n++] = p;
+			if(DoSimplex(s, n, d))
+				return true;
+		}
+		return false;
+	}
+
+	/// Adds points to a simplex that's flat (fewer than 4 points) until it's a tetrahedron.
+	/// Returns false if the shapes are flat too.
+	static bool CompleteSimplex(const SupportMapping& a, const SupportMapping& b, SupportPoint* s, unsigned& n)
+	{
+		const vec3 axes[3] = { vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+		const double epsilon = 1e-6;
+
+		while(n < 4) {
+			vec3 dirs[6];
+			unsigned count = 0;
+			if(n == 1) {
+				for(const vec3& axis : axes) {
+					dirs[count++] = axis;
+					dirs[count++] = -axis;
+				}
+			} else if(n == 2) {
+				for(const vec3& axis : axes) {
+					vec3 c = Cross(s[1].w - s[0].w, axis);
+					dirs[count++] = c;
+					dirs[count++] = -c;
+				}
+			} else {
+				vec3 normal = Cross(s[1].w - s[0].w, s[2].w - s[0].w);
+				dirs[count++] = normal;
+				dirs[count++] = -normal;
+			}
+
+			bool added = false;
+			for(unsigned i = 0; i < count && !added; i++) {
+				if(Dot(dirs[i], dirs[i]) < epsilon * epsilon)
+					continue;
+				SupportPoint p = detail::Support(a, b, dirs[i]);
+				if(Dot(p.w - s[0].w, Normalized(dirs[i])) > epsilon) {
+					s[n++] = p;
+					added = true;
+				}
+			}
+			if(!added)
+				return false;
+		}
+		return true;
+	}
+
+	// ------------------------------------------------ EPA ------------------------------------------------ //
+
+	namespace
+	{
+		struct Face {
+			unsigned a, b, c;
+			vec3 normal;
+			double distance;
+		};
+
+		struct Edge {
+			unsigned a, b;
+		};
+	} // namespace
+
+	/// Expands the simplex from GJK until it finds the face of A - B closest to the origin.
+	static bool EPA(const SupportMapping& a, const SupportMapping& b, SupportPoint* s, ContactManifold& out)
+	{
+		const unsigned MaxIterations = 64, MaxPoints = 4 + MaxIterations, MaxFaces = 256, MaxEdges = 128;
+		SupportPoint points[MaxPoints];
+		Face faces[MaxFaces];
+		Edge edges[MaxEdges];
+		unsigned pointCount = 4, faceCount = 0;
+		for(unsigned i = 0; i < 4; i++)
+			points[i] = s[i];
+
+		// The polytope only grows, so the middle of the first tetrahedron stays inside it.
+		vec3 inside = (points[0].w + points[1].w + points[2].w + points[3].w) / 4;
+		auto addFace = [&](unsigned i, unsigned j, unsigned k) {
+			vec3 normal = Cross(points[j].w - points[i].w, points[k].w - points[i].w);
+			double length = Length(normal);
+			if(length < 1e-12 || faceCount == MaxFaces)
+				return;
+			normal = normal / length;
+			if(Dot(normal, points[i].w - inside) < 0) {
+				std::swap(j, k);
+				normal = -normal;
+			}
+			faces[faceCount++] = { i, j, k, normal, Dot(normal, points[i].w) };
+		};
+		addFace(0, 1, 2);
+		addFace(0, 3, 1);
+		addFace(0, 2, 3);
+		addFace(1, 3, 2);
+		if(faceCount < 4)
+			return false;
+
+		auto closestFace = [&]() {
+			unsigned closest = 0;
+			for(unsigned i = 1; i < faceCount; i++)
+				if(faces[i].distance < faces[closest].distance)
+					closest = i;
+			return faces[closest];
+		};
+
+		// A copy, since expanding the polytope moves and removes faces.
+		Face face = closestFace();
+		for(unsigned iteration = 0; iteration < MaxIterations; iteration++) {
+			SupportPoint p = detail::Support(a, b, face.normal);
+			if(Dot(p.w, face.normal) - face.distance < 1e-4 || pointCount == MaxPoints)
+				break;
+
+			// Remove every face that can see the new point, keeping the edges around the hole.
+			unsigned edgeCount = 0;
+			bool overflow = false;
+			auto addEdge = [&](unsigned i, unsigned j) {
+				for(unsigned e = 0; e < edgeCount; e++) {
+					if(edges[e].a == j && edges[e].b == i) {
+						edges[e] = edges[--edgeCount];
+						return;
+					}
+				}
+				if(edgeCount == MaxEdges)
+					overflow = true;
+				else
+					edges[edgeCount++] = { i, j };
+			};
+
+			for(unsigned i = 0; i < faceCount;) {
+				if(Dot(faces[i].normal, p.w - points[faces[i].a].w) > 1e-9) {
+					addEdge(faces[i].a, faces[i].b);
+					addEdge(faces[i].b, faces[i].c);
+					addEdge(faces[i].c, faces[i].a);
+					faces[i] = faces[--faceCount];
+				} else {
+					i++;
+				}
+			}
+			// The polytope can't be expanded any further, so settle for the closest face found so far.
+			if(overflow || edgeCount == 0)
+				break;
+
+			points[pointCount++] = p;
+			for(unsigned e = 0; e < edgeCount; e++)
+				addFace(edges[e].a, edges[e].b, pointCount - 1);
+			if(faceCount == 0)
+				break;
+			face = closestFace();
+		}
+
+		// The origin projected on the closest face, in barycentric coordinates, gives the deepest points of A and B.
+		const SupportPoint &pa = points[face.a], &pb = points[face.b], &pc = points[face.c];
+		vec3 p = face.normal * face.distance;
+		vec3 v0 = pb.w - pa.w, v1 = pc.w - pa.w, v2 = p - pa.w;
+		double d00 = Dot(v0, v0), d01 = Dot(v0, v1), d11 = Dot(v1, v1), d20 = Dot(v2, v0), d21 = Dot(v2, v1);
+		double denom = d00 * d11 - d01 * d01;
+		double v = denom != 0 ? (d11 * d20 - d01 * d21) / denom : 1 / 3.0;
+		double w = denom != 0 ? (d00 * d21 - d01 * d20) / denom : 1 / 3.0;
+		double u = 1 - v - w;
+
+		vec3 onA = pa.a * u + pb.a * v + pc.a * w;
+		vec3 onB = pa.b * u + pb.b * v + pc.b * w;
+
+		out.normal = face.normal;
+		out.count = 1;
+		out.points[0] = ContactPoint();
+		out.points[0].position = (onA + onB) / 2;
+		out.points[0].depth = face.distance;
+		return face.distance > 0;
+	}
+
+	static bool FindConvexContact(const SupportMapping& a, const SupportMapping& b, ContactManifold& out)
+	{
+		SupportPoint simplex[4];
+		unsigned n;
+		if(!GJK(a, b, simplex, n))
+			return false;
+		if(n < 4 && !CompleteSimplex(a, b, simplex, n))
+			return false;
+		return EPA(a, b, simplex, out);
+	}
+
+	bool FindContact(const ConvexHull& a, const ConvexHull& b, ContactManifold& out)
+	{
+		if(a.Empty() || b.Empty())
+			return false;
+		return FindConvexContact(detail::MakeSupport(a), detail::MakeSupport(b), out);
+	}
+
+	bool FindContact(const ConvexHull& a, const OBB& b, ContactManifold& out)
+	{
+		if(a.Empty())
+			return false;
+		return FindConvexContact(detail::MakeSupport(a), detail::MakeSupport(b), out);
+	}
+
+	bool FindContact(const OBB& a, const ConvexHull& b, ContactManifold& out)
+	{
+		if(b.Empty())
+			return false;
+		return FindConvexContact(detail::MakeSupport(a), detail::MakeSupport(b), out);
+	}
+
+	bool FindContact(const ConvexHull& a, const AABB& b, ContactManifold& out)
+	{
+		return FindContact(a, OBB(b), out);
+	}
+
+	bool FindContact(const AABB& a, const ConvexHull& b, ContactManifold& out)
+	{
+		return FindContact(OBB(a), b, out);
+	}
+
+	bool FindContact(const ConvexHull& a, const Plane& b, ContactManifold& out)
+	{
+		Vector<vec3> vertices(a.Points.size());
+		for(std::size_t i = 0; i < vertices.size(); i++)
+			vertices[i] = a.Points.get(i);
+		return FindContact(vertices.data(), vertices.size(), b, out);
+	}
+
+	Intersection FindIntersection(const ConvexHull& a, const ConvexHull& b)
+	{
+		if(a.Empty() || b.Empty())
+			return Intersection();
+
+		SupportPoint simplex[4];
+		unsigned n;
+		if(!GJK(detail::MakeSupport(a), detail::MakeSupport(b), simplex, n))
+			return Intersection();
+
+		// The simplex encloses the origin, so the average of its points on A is inside A, and
+		// close to B. Good enough as a point of contact.
+		vec3 point(0);
+		for(unsigned i = 0; i < n; i++)
+			point += simplex[i].a;
+
+		Intersection res;
+		res.happened = true;
+		res.type = Intersection::Type::Point;
+		res.point = point / (double) n;
+		return res;
+	}
+} // namespace SWAN
@@ -0,0 +1,69 @@
+#ifndef SWAN_PHYS_CONVEX_HULL_HPP
+#define SWAN_PHYS_CONVEX_HULL_HPP
+
+#include <cstddef> // For std::size_t
+#include <utility> // For std::move()
+
+#include "Basic.hpp"             // For SWAN::AABB, SWAN::Plane, SWAN::Intersection
+#include "ContactManifold.hpp"   // For SWAN::ContactManifold
+#include "Core/Defs.hpp"         // For SWAN::Vector<T>
+#include "Maths/PointStream.hpp" // For SWAN::PointStream
+#include "OBB.hpp"               // For SWAN::OBB
+
+namespace SWAN
+{
+	/**
+	 * @brief The convex hull of a set of points.
+	 *
+	 * Only the points are stored, the hull is whatever they span: collision tests only
+	 * need the point furthest along a direction (Support()), which is found with
+	 * 4 (SSE) or 8 (AVX) dot products per instruction. Points inside the hull
+	 * don't change the results, they only cost time.
+	 */
+	struct ConvexHull {
+		ConvexHull() {}
+		explicit ConvexHull(const Vector<vec3>& points) : Points(points) {}
+		explicit ConvexHull(PointStream points) : Points(std::move(points)) {}
+
+		/// Index returned by SupportIndex() for an empty hull.
+		static constexpr std::size_t None = ~std::size_t(0);
+
+		PointStream Points;
+
+		/// Whether the hull has no points. Empty hulls don't collide with anything.
+		inline bool Empty() const { return Points.size() == 0; }
+
+		/// Get the index of the point furthest along @p dir, the first one if there are several.
+		/// Returns None if the hull is empty.
+		std::size_t SupportIndex(vec3 dir) const;
+
+		/// Get the point furthest along @p dir. The hull mustn't be empty.
+		inline vec3 Support(vec3 dir) const { return Points.get(SupportIndex(dir)); }
+
+		/// Get the smallest AABB that contains the hull, an empty box at the origin if the hull is empty.
+		AABB GetAABB() const;
+
+		/// Get the hull after it's transformed by @p m.
+		ConvexHull Transformed(const mat4& m) const;
+	};
+
+	/**
+	 * @brief Finds the contact between two convex shapes with GJK, and EPA for the penetration.
+	 *
+	 * The contact has one point, halfway between the deepest points of both shapes.
+	 * Returns false if the shapes are apart or only touch.
+	 */
+	extern bool FindContact(const ConvexHull& a, const ConvexHull& b, ContactManifold& out);
+	extern bool FindContact(const ConvexHull& a, const OBB& b, ContactManifold& out);
+	extern bool FindContact(const OBB& a, const ConvexHull& b, ContactManifold& out);
+	extern bool FindContact(const ConvexHull& a, const AABB& b, ContactManifold& out);
+	extern bool FindContact(const AABB& a, const ConvexHull& b, ContactManifold& out);
+
+	/// Finds the contact between a hull and the solid side behind a plane. See FindContact(const AABB&, const Plane&, ContactManifold&).
+	extern bool FindContact(const ConvexHull& a, const Plane& b, ContactManifold& out);
+
+	/// Whether the hulls overlap, with a point inside both. Only runs GJK.
+	extern Intersection FindIntersection(const ConvexHull& a, const ConvexHull& b);
+} // namespace SWAN
+
+#endif
@@ -0,0 +1,170 @@
+#include "MeshBVH.hpp"
+
+#include <algorithm> // For std::min(), std::max(), std::partition()
+#include <limits>    // For std::numeric_limits<T>
+
+namespace SWAN
+{
+	constexpr int MeshBVH::MaxDepth;
+
+	/// Number of bins the centroids are sorted into along each axis.
+	static constexpr int BinCount = 16;
+	/// Leaves are always made below this many triangles, and always split above it when possible.
+	static constexpr std::uint32_t MinLeafSize = 2, MaxLeafSize = 8;
+	/// Cost of visiting a node, relative to testing a triangle.
+	static constexpr double TraversalCost = 1;
+
+	static inline double Axis(const vec3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+	static inline AABB EmptyBox()
+	{
+		Real inf = std::numeric_limits<Real>::max();
+		return AABB(vec3(inf), vec3(-inf));
+	}
+
+	static inline void Grow(AABB& box, const AABB& o)
+	{
+		box.min = vec3(std::min(box.min.x, o.min.x), std::min(box.min.y, o.min.y), std::min(box.min.z, o.min.z));
+		box.max = vec3(std::max(box.max.x, o.max.x), std::max(box.max.y, o.max.y), std::max(box.max.z, o.max.z));
+	}
+
+	void MeshBVH::build(Vector<Triangle>& triangles)
+	{
+		nodes.clear();
+		if(triangles.empty())
+			return;
+
+		struct Item {
+			AABB box;
+			vec3 centroid;
+			std::uint32_t triangle;
+		};
+		Vector<Item> items(triangles.size());
+		for(std::uint32_t i = 0; i < triangles.size(); i++) {
+			const Triangle& t = triangles[i];
+			items[i].box = EmptyBox();
+			for(const vec3& p : t.points)
+				Grow(items[i].box, AABB(p, p));
+			items[i].centroid = items[i].box.center();
+			items[i].triangle = i;
+		}
+
+		// Nodes are created depth-first: the left child right after its parent, the right child
+		// once the left subtree is done, which is when the parent learns its index.
+		struct Task {
+			std::uint32_t begin, end;
+			std::uint32_t parent;
+			int depth;
+		};
+		Vector<Task> tasks;
+		tasks.push_back({ 0, (std::uint32_t) items.size(), ~std::uint32_t(0), 0 });
+		nodes.reserve(2 * items.size() / MinLeafSize);
+
+		while(!tasks.empty()) {
+			Task task = tasks.back();
+			tasks.pop_back();
+
+			std::uint32_t index = nodes.size();
+			nodes.push_back(Node());
+			// Only right children are popped with a parent set, left ones are always index + 1.
+			if(task.parent != ~std::uint32_t(0))
+				nodes[task.parent].first = index;
+
+			AABB box = EmptyBox(), centroids = EmptyBox();
+			for(std::uint32_t i = task.begin; i < task.end; i++) {
+				Grow(box, items[i].box);
+				Grow(centroids, AABB(items[i].centroid, items[i].centroid));
+			}
+			nodes[index].box = box;
+
+			std::uint32_t count = task.end - task.begin;
+			auto makeLeaf = [&]() {
+				nodes[index].first = task.begin;
+				nodes[index].count = count;
+			};
+			if(count <= MinLeafSize || task.depth >= MaxDepth - 2) {
+				makeLeaf();
+				continue;
+			}
+
+			// Find the cheapest split by surface area, going through the bin boundaries of every axis.
+			double bestCost = std::numeric_limits<double>::max();
+			int bestAxis = -1, bestSplit = 0;
+			for(int axis = 0; axis < 3; axis++) {
+				double lo = Axis(centroids.min, axis), extent = Axis(centroids.max, axis) - lo;
+				if(extent <= 0)
+					continue;
+				double scale = BinCount / extent;
+
+				AABB binBoxes[BinCount];
+				std::uint32_t binCounts[BinCount] = {};
+				for(AABB& b : binBoxes)
+					b = EmptyBox();
+				for(std::uint32_t i = task.begin; i < task.end; i++) {
+					int bin = std::min(BinCount - 1, (int) ((Axis(items[i].centroid, axis) - lo) * scale));
+					binCounts[bin]++;
+					Grow(binBoxes[bin], items[i].box);
+				}
+
+				// Sweep from the right to get the area and count right of every boundary, then from the left.
+				double rightArea[BinCount];
+				std::uint32_t rightCount[BinCount];
+				AABB acc = EmptyBox();
+				std::uint32_t n = 0;
+				for(int b = BinCount - 1; b > 0; b--) {
+					Grow(acc, binBoxes[b]);
+					n += binCounts[b];
+					rightArea[b] = n ? acc.SurfaceArea() : 0;
+					rightCount[b] = n;
+				}
+
+				acc = EmptyBox();
+				n = 0;
+				for(int b = 0; b < BinCount - 1; b++) {
+					Grow(acc, binBoxes[b]);
+					n += binCounts[b];
+					if(n == 0 || rightCount[b + 1] == 0)
+						continue;
+
+					double cost = n * acc.SurfaceArea() + rightCount[b + 1] * rightArea[b + 1];
+					if(cost < bestCost) {
+						bestCost = cost;
+						bestAxis = axis;
+						bestSplit = b + 1;
+					}
+				}
+			}
+
+			// All the centroids are in one spot, nothing to split.
+			if(bestAxis == -1) {
+				makeLeaf();
+				continue;
+			}
+
+			double leafCost = count;
+			bestCost = TraversalCost + bestCost / box.SurfaceArea();
+			if(bestCost >= leafCost && count <= MaxLeafSize) {
+				makeLeaf();
+				continue;
+			}
+
+			double lo = Axis(centroids.min, bestAxis);
+			double scale = BinCount / (Axis(centroids.max, bestAxis) - lo);
+			Item* mid = std::partition(items.data() + task.begin, items.data() + task.end, [&](const Item& item) {
+				return std::min(BinCount - 1, (int) ((Axis(item.centroid, bestAxis) - lo) * scale)) < bestSplit;
+			});
+			std::uint32_t split = mid - items.data();
+
+			nodes[index].count = 0;
+			// The right child is pushed first, so the left one is built next and lands at index + 1.
+			tasks.push_back({ split, task.end, index, task.depth + 1 });
+			tasks.push_back({ task.begin, split, ~std::uint32_t(0), task.depth + 1 });
+		}
+
+		// Put the triangles in leaf order.
+		Vector<Triangle> sorted(triangles.size());
+		for(std::uint32_t i = 0; i < items.size(); i++)
+			sorted[i] = triangles[items[i].triangle];
+		triangles.swap(sorted);
+	}
+} // namespace SWAN
@@ -0,0 +1,179 @@
+#ifndef SWAN_MESH_BVH_HPP
+#define SWAN_MESH_BVH_HPP
+
+#include <algorithm> // For std::swap()
+#include <cstdint>   // For std::uint32_t
+
+#include "Basic.hpp"        // For SWAN::AABB, SWAN::Ray, SWAN::Triangle
+#include "Core/Defs.hpp"    // For SWAN::Vector<T>
+#include "Maths/Vector.hpp" // For SWAN::vec3
+
+namespace SWAN
+{
+	/**
+	 * @brief Static bounding volume hierarchy over a list of triangles.
+	 *
+	 * Built top-down with a binned surface area heuristic. build() reorders the triangles
+	 * so every leaf covers one contiguous range of them, and the nodes are stored
+	 * depth-first in one array: a node's left child is the next node, so only the
+	 * right child's index has to be stored.
+	 */
+	class MeshBVH
+	{
+	  public:
+		struct Node {
+			AABB box;
+			/// First triangle for leaves, index of the right child for internal nodes.
+			std::uint32_t first;
+			/// Number of triangles, 0 for internal nodes.
+			std::uint32_t count;
+
+			inline bool isLeaf() const { return count != 0; }
+		};
+
+		/// Builds the hierarchy, reordering @p triangles.
+		void build(Vector<Triangle>& triangles);
+
+		/// Whether there's no triangle in the hierarchy.
+		inline bool empty() const { return nodes.empty(); }
+
+		/// Box around every triangle.
+		inline AABB getBounds() const { return nodes.empty() ? AABB(vec3(0), vec3(0)) : nodes[0].box; }
+
+		inline const Vector<Node>& getNodes() const { return nodes; }
+
+		/**
+		 * @brief Walks the nodes whose boxes pass @p nodeTest.
+		 *
+		 * @p leaf is called with the range of triangles (first, count) of every leaf reached.
+		 */
+		template <typename NodeTest, typename Leaf>
+		void traverse(NodeTest nodeTest, Leaf leaf) const
+		{
+			if(nodes.empty())
+				return;
+
+			std::uint32_t stack[MaxDepth];
+			int top = 0;
+			stack[top++] = 0;
+
+			while(top > 0) {
+				std::uint32_t index = stack[--top];
+				const Node& node = nodes[index];
+				if(!nodeTest(node.box))
+					continue;
+
+				if(node.isLeaf()) {
+					leaf(node.first, node.count);
+				} else {
+					stack[top++] = node.first;
+					stack[top++] = index + 1;
+				}
+			}
+		}
+
+		/**
+		 * @brief Walks the nodes hit by a ray, nearest first.
+		 *
+		 * @p leaf is called with (first, count, tMax) for every leaf hit closer than @p tMax,
+		 * and should lower tMax when it finds a hit, which prunes the nodes that are further away.
+		 */
+		template <typename Leaf>
+		void traverse(const Ray& ray, double& tMax, Leaf leaf) const
+		{
+			if(nodes.empty())
+				return;
+
+			vec3 invDir(1.0 / ray.dir.x, 1.0 / ray.dir.y, 1.0 / ray.dir.z);
+
+			struct Entry {
+				std::uint32_t node;
+				double t;
+			};
+			Entry stack[MaxDepth];
+			int top = 0;
+
+			double t;
+			if(!RayHitsAABB(ray.start, invDir, nodes[0].box, tMax, t))
+				return;
+			stack[top++] = { 0, t };
+
+			while(top > 0) {
+				Entry e = stack[--top];
+				if(e.t > tMax)
+					continue;
+
+				const Node& node = nodes[e.node];
+				if(node.isLeaf()) {
+					leaf(node.first, node.count, tMax);
+					continue;
+				}
+
+				double t1, t2;
+				bool hit1 = RayHitsAABB(ray.start, invDir, nodes[e.node + 1].box, tMax, t1);
+				bool hit2 = RayHitsAABB(ray.start, invDir, nodes[node.first].box, tMax, t2);
+
+				// The nearer child goes on top, so it's visited first.
+				Entry near = { e.node + 1, t1 }, far = { node.first, t2 };
+				if(t2 < t1)
+					std::swap(near, far);
+				if(hit1 && hit2) {
+					stack[top++] = far;
+					stack[top++] = near;
+				} else if(hit1 || hit2) {
+					stack[top++] = hit1 ? Entry{ e.node + 1, t1 } : Entry{ node.first, t2 };
+				}
+			}
+		}
+
+		/**
+		 * @brief Walks this hierarchy and @p other together, descending into pairs of nodes whose boxes overlap.
+		 *
+		 * @p leaves is called with (first, count, otherFirst, otherCount) for every pair of overlapping
+		 * leaves, and can return true to stop. Returns true if it was stopped.
+		 */
+		template <typename Leaves>
+		bool traverse(const MeshBVH& other, Leaves leaves) const
+		{
+			if(nodes.empty() || other.nodes.empty())
+				return false;
+
+			struct Entry {
+				std::uint32_t a, b;
+			};
+			Vector<Entry> stack;
+			stack.push_back({ 0, 0 });
+
+			while(!stack.empty()) {
+				Entry e = stack.back();
+				stack.pop_back();
+
+				const Node& a = nodes[e.a];
+				const Node& b = other.nodes[e.b];
+				if(!a.box.Overlaps(b.box))
+					continue;
+
+				if(a.isLeaf() && b.isLeaf()) {
+					if(leaves(a.first, a.count, b.first, b.count))
+						return true;
+				} else if(b.isLeaf() || (!a.isLeaf() && a.box.SurfaceArea() > b.box.SurfaceArea())) {
+					// Descend into the bigger side.
+					stack.push_back({ a.first, e.b });
+					stack.push_back({ e.a + 1, e.b });
+				} else {
+					stack.push_back({ e.a, b.first });
+					stack.push_back({ e.a, e.b + 1 });
+				}
+			}
+			return false;
+		}
+
+	  private:
+		/// Deepest the builder goes, which bounds the traversal stacks.
+		static constexpr int MaxDepth = 64;
+
+		Vector<Node> nodes;
+	};
+} // namespace SWAN
+
+#endif
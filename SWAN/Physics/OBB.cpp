@@ -0,0 +1,209 @@
+#include "OBB.hpp"
+
+#include <algorithm> // For std::min(), std::max()
+
+#include "Maths/SIMD.hpp" // For SWAN::detail::WideLanes
+
+namespace SWAN
+{
+	namespace detail
+	{
+		/// The 15 axes of the separating axis test, one float array per coordinate, padded to 16.
+		struct alignas(32) SATAxes {
+			static constexpr unsigned Count = 15, Padded = 16;
+
+			float x[Padded], y[Padded], z[Padded];
+			/// Overlap of the boxes along each axis, and the distance between their centers.
+			float overlap[Padded], distance[Padded];
+		};
+
+		/// Projects both boxes on every axis, L::Width axes at a time.
+		template <typename L>
+		void ProjectImpl(SATAxes& axes, const OBB& a, const OBB& b)
+		{
+			using T = typename L::Type;
+			vec3 d = b.center - a.center;
+			const T dx = L::Set(d.x), dy = L::Set(d.y), dz = L::Set(d.z);
+
+			// Radius of a box along an axis: sum of |axis . box axis| * half extent.
+			auto radius = [](T x, T y, T z, const OBB& box) {
+				const float e[3] = { (float) box.halfExtents.x, (float) box.halfExtents.y, (float) box.halfExtents.z };
+				T r = L::Set(0);
+				for(int i = 0; i < 3; i++) {
+					T p = L::Add(L::Add(L::Mul(x, L::Set(box.axes[i].x)), L::Mul(y, L::Set(box.axes[i].y))), L::Mul(z, L::Set(box.axes[i].z)));
+					r = L::Add(r, L::Mul(L::Abs(p), L::Set(e[i])));
+				}
+				return r;
+			};
+
+			for(unsigned j = 0; j < SATAxes::Padded; j += L::Width) {
+				T x = L::Load(axes.x + j), y = L::Load(axes.y + j), z = L::Load(axes.z + j);
+				T dist = L::Add(L::Add(L::Mul(x, dx), L::Mul(y, dy)), L::Mul(z, dz));
+				L::Store(axes.distance + j, dist);
+				L::Store(axes.overlap + j, L::Sub(L::Add(radius(x, y, z, a), radius(x, y, z, b)), L::Abs(dist)));
+			}
+		}
+	} // namespace detail
+
+	static inline double Component(const vec3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+	/// Collects up to ContactManifold::MaxPoints of the deepest corners of @p incident inside the face
+	/// of @p reference across its axis @p face, whose outward normal (towards @p incident) is @p n.
+	static void FaceContact(const OBB& reference, int face, const OBB& incident, vec3 n, std::uint32_t featureBase, ContactManifold& out)
+	{
+		double h = Component(reference.halfExtents, face);
+		int u = (face + 1) % 3, v = (face + 2) % 3;
+		double hu = Component(reference.halfExtents, u), hv = Component(reference.halfExtents, v);
+		const double tolerance = 1e-4;
+
+		out.count = 0;
+		for(unsigned i = 0; i < 8; i++) {
+			vec3 corner = incident.Corner(i);
+			vec3 local = corner - reference.center;
+
+			double depth = h - Dot(local, n);
+			if(depth < 0 || std::abs(Dot(local, reference.axes[u])) > hu + tolerance || std::abs(Dot(local, reference.axes[v])) > hv + tolerance)
+				continue;
+
+			// Keep the deepest ones, ties go to the lower index.
+			unsigned j = std::min(out.count, ContactManifold::MaxPoints - 1);
+			if(out.count == ContactManifold::MaxPoints && depth <= out.points[j].depth)
+				continue;
+			for(; j > 0 && out.points[j - 1].depth < depth; j--)
+				out.points[j] = out.points[j - 1];
+
+			ContactPoint& p = out.points[j];
+			p = ContactPoint();
+			p.position = corner + n * (depth / 2);
+			p.depth = depth;
+			p.feature = featureBase + i;
+			out.count = std::min(out.count + 1, ContactManifold::MaxPoints);
+		}
+	}
+
+	bool FindContact(const OBB& a, const OBB& b, ContactManifold& out)
+	{
+		detail::SATAxes axes;
+		bool valid[detail::SATAxes::Padded];
+
+		auto setAxis = [&](unsigned i, vec3 axis) {
+			axes.x[i] = axis.x;
+			axes.y[i] = axis.y;
+			axes.z[i] = axis.z;
+		};
+		for(unsigned i = 0; i < 3; i++) {
+			setAxis(i, a.axes[i]);
+			setAxis(i + 3, b.axes[i]);
+			valid[i] = valid[i + 3] = true;
+		}
+
+		// Edge crossings of (nearly) parallel edges don't give an axis, the face axes cover those.
+		for(unsigned i = 0; i < 3; i++) {
+			for(unsigned j = 0; j < 3; j++) {
+				unsigned k = 6 + i * 3 + j;
+				vec3 c = Cross(a.axes[i], b.axes[j]);
+				double length = Length(c);
+				valid[k] = length > 1e-5;
+				setAxis(k, valid[k] ? c / length : vec3(0));
+			}
+		}
+		setAxis(15, vec3(0));
+		valid[15] = false;
+
+		detail::ProjectImpl<detail::WideLanes>(axes, a, b);
+
+		// Faces are preferred over edges unless an edge axis is clearly better, so the
+		// normal doesn't flip between them on nearly flat contacts.
+		int best = -1;
+		double bestOverlap = 0;
+		for(unsigned i = 0; i < detail::SATAxes::Count; i++) {
+			if(!valid[i])
+				continue;
+			double overlap = axes.overlap[i];
+			if(overlap < 0)
+				return false;
+
+			double biased = i < 6 ? overlap : overlap * 1.05 + 1e-4;
+			if(best == -1 || biased < bestOverlap) {
+				best = i;
+				bestOverlap = biased;
+			}
+		}
+
+		double depth = axes.overlap[best];
+		vec3 n(axes.x[best], axes.y[best], axes.z[best]);
+		if(axes.distance[best] < 0)
+			n = -n;
+		out.normal = n;
+
+		if(best < 3)
+			FaceContact(a, best, b, n, best * 8, out);
+		else if(best < 6)
+			FaceContact(b, best - 3, a, -n, best * 8, out);
+		else
+			out.count = 0;
+
+		if(out.count == 0) {
+			// Edge-edge: the closest points of the edge of A furthest along the normal and the edge of B furthest against it.
+			int i = best < 6 ? 0 : (best - 6) / 3, j = best < 6 ? 0 : (best - 6) % 3;
+			vec3 pa = a.center, pb = b.center;
+			for(int k = 0; k < 3; k++) {
+				if(k != i)
+					pa += a.axes[k] * (Dot(n, a.axes[k]) >= 0 ? Component(a.halfExtents, k) : -Component(a.halfExtents, k));
+				if(k != j)
+					pb += b.axes[k] * (Dot(n, b.axes[k]) <= 0 ? Component(b.halfExtents, k) : -Component(b.halfExtents, k));
+			}
+
+			vec3 da = a.axes[i], db = b.axes[j], r = pa - pb;
+			double d = Dot(da, db), c = Dot(da, r), f = Dot(db, r), denom = 1 - d * d;
+			double s = denom > 1e-9 ? (d * f - c) / denom : 0;
+			double t = denom > 1e-9 ? (f - d * c) / denom : f;
+			s = std::max(-Component(a.halfExtents, i), std::min(Component(a.halfExtents, i), s));
+			t = std::max(-Component(b.halfExtents, j), std::min(Component(b.halfExtents, j), t));
+
+			ContactPoint& p = out.points[0];
+			p = ContactPoint();
+			p.position = (pa + da * s + pb + db * t) / 2;
+			p.depth = depth;
+			p.feature = best * 8;
+			out.count = 1;
+		}
+		return true;
+	}
+
+	bool FindContact(const OBB& a, const AABB& b, ContactManifold& out)
+	{
+		return FindContact(a, OBB(b), out);
+	}
+
+	bool FindContact(const AABB& a, const OBB& b, ContactManifold& out)
+	{
+		return FindContact(OBB(a), b, out);
+	}
+
+	bool FindContact(const OBB& a, const Plane& b, ContactManifold& out)
+	{
+		vec3 corners[8];
+		for(unsigned i = 0; i < 8; i++)
+			corners[i] = a.Corner(i);
+		return FindContact(corners, 8, b, out);
+	}
+
+	Intersection FindIntersection(const OBB& a, const OBB& b)
+	{
+		ContactManifold m;
+		if(!FindContact(a, b, m))
+			return Intersection();
+
+		Intersection res;
+		res.happened = true;
+		res.type = Intersection::Type::Point;
+		res.point = m.points[0].position;
+		return res;
+	}
+
+	Intersection FindIntersection(const OBB& a, const AABB& b)
+	{
+		return FindIntersection(a, OBB(b));
+	}
+} // namespace SWAN
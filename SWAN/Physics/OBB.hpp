@@ -0,0 +1,102 @@
+#ifndef SWAN_PHYS_OBB_HPP
+#define SWAN_PHYS_OBB_HPP
+
+#include <cmath> // For std::abs()
+
+#include "Basic.hpp"           // For SWAN::AABB, SWAN::Plane, SWAN::Intersection
+#include "ContactManifold.hpp" // For SWAN::ContactManifold
+#include "Maths/Affine.hpp"    // For SWAN::affine3x4
+#include "Maths/Vector.hpp"    // For SWAN::vec3
+
+namespace SWAN
+{
+	/// Oriented bounding box: a box rotated by three orthonormal axes.
+	struct OBB {
+		OBB() {}
+
+		/// Constructs a box that isn't rotated.
+		OBB(vec3 center, vec3 halfExtents) : center(center), halfExtents(halfExtents) {}
+
+		/// Constructs a box from its center, half extents and axes. The axes have to be orthonormal.
+		OBB(vec3 center, vec3 halfExtents, vec3 x, vec3 y, vec3 z) : center(center), halfExtents(halfExtents)
+		{
+			axes[0] = x;
+			axes[1] = y;
+			axes[2] = z;
+		}
+
+		/// Constructs the same box as an AABB.
+		explicit OBB(const AABB& aabb) : center(aabb.center()), halfExtents((aabb.max - aabb.min) / 2) {}
+
+		vec3 center;
+		vec3 halfExtents;
+		vec3 axes[3] = { vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+
+		/// Get the i-th corner: bit 0, 1 and 2 of @p i pick the positive side of axes 0, 1 and 2.
+		inline vec3 Corner(unsigned i) const
+		{
+			return center + axes[0] * (i & 1 ? halfExtents.x : -halfExtents.x)
+			       + axes[1] * (i & 2 ? halfExtents.y : -halfExtents.y)
+			       + axes[2] * (i & 4 ? halfExtents.z : -halfExtents.z);
+		}
+
+		/// Get the point of the box furthest along @p dir.
+		inline vec3 Support(vec3 dir) const
+		{
+			return center + axes[0] * (Dot(dir, axes[0]) >= 0 ? halfExtents.x : -halfExtents.x)
+			       + axes[1] * (Dot(dir, axes[1]) >= 0 ? halfExtents.y : -halfExtents.y)
+			       + axes[2] * (Dot(dir, axes[2]) >= 0 ? halfExtents.z : -halfExtents.z);
+		}
+
+		/// Get the smallest AABB that contains the box.
+		inline AABB GetAABB() const
+		{
+			vec3 ext(std::abs(axes[0].x) * halfExtents.x + std::abs(axes[1].x) * halfExtents.y + std::abs(axes[2].x) * halfExtents.z,
+			         std::abs(axes[0].y) * halfExtents.x + std::abs(axes[1].y) * halfExtents.y + std::abs(axes[2].y) * halfExtents.z,
+			         std::abs(axes[0].z) * halfExtents.x + std::abs(axes[1].z) * halfExtents.y + std::abs(axes[2].z) * halfExtents.z);
+			return AABB(center - ext, center + ext);
+		}
+
+		/// Get the box after it's transformed by the Transform's Model matrix.
+		/// Scale is applied along the box's own axes, so a skewing parent scale isn't supported.
+		OBB ApplyTransform(const Transform& t) const { return ApplyTransform(t.getModelAffine()); }
+
+		/// Same as ApplyTransform(const Transform&), with an already calculated matrix.
+		OBB ApplyTransform(const affine3x4& m) const
+		{
+			vec3 x = TransformDirection(m, axes[0] * halfExtents.x);
+			vec3 y = TransformDirection(m, axes[1] * halfExtents.y);
+			vec3 z = TransformDirection(m, axes[2] * halfExtents.z);
+			vec3 e(Length(x), Length(y), Length(z));
+			return OBB(TransformPoint(m, center), e, x / e.x, y / e.y, z / e.z);
+		}
+	};
+
+	/**
+	 * @brief Finds the contact between two boxes with the separating axis test.
+	 *
+	 * All 15 axes (3 faces of each box and the 9 edge-edge crossings) are tested at once,
+	 * 4 or 8 per instruction. The normal is the face axis with the least overlap, unless an
+	 * edge axis overlaps clearly less (by about 5%), so it doesn't flip between a face and an
+	 * edge on nearly flat contacts. It's not always the axis of least overlap, which matters
+	 * for deep penetrations.
+	 *
+	 * For a face, the points are the corners of the other box that are inside the face, each
+	 * with its own depth below the face rather than the overlap along the axis. For an edge
+	 * pair (or a face with no corners inside it), there's one point halfway between the closest
+	 * points of the two edges, with the overlap as its depth. Returns false if the boxes are apart.
+	 */
+	extern bool FindContact(const OBB& a, const OBB& b, ContactManifold& out);
+	extern bool FindContact(const OBB& a, const AABB& b, ContactManifold& out);
+	extern bool FindContact(const AABB& a, const OBB& b, ContactManifold& out);
+
+	/// Finds the contact between a box and the solid side behind a plane. See FindContact(const AABB&, const Plane&, ContactManifold&).
+	extern bool FindContact(const OBB& a, const Plane& b, ContactManifold& out);
+
+	/// Whether the boxes overlap, with the point halfway into the overlap where they touch.
+	extern Intersection FindIntersection(const OBB& a, const OBB& b);
+	extern Intersection FindIntersection(const OBB& a, const AABB& b);
+	inline Intersection FindIntersection(const AABB& a, const OBB& b) { return FindIntersection(b, a); }
+} // namespace SWAN
+
+#endif
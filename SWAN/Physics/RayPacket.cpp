@@ -0,0 +1,235 @@
+#include "RayPacket.hpp"
+
+#include "Maths/SIMD.hpp" // For SWAN::detail::WideLanes, SWAN::detail::ScalarLanes
+
+namespace SWAN
+{
+	constexpr std::uint32_t RayPacket::None;
+
+	RayPacket::RayPacket()
+	{
+		// Unused rays have a negative tMax, so they never hit anything.
+		for(int i = 0; i < Width; i++) {
+			originX[i] = originY[i] = originZ[i] = 0;
+			dirX[i] = 1;
+			dirY[i] = dirZ[i] = 0;
+			invDirX[i] = 1;
+			invDirY[i] = invDirZ[i] = 1e30f;
+			tMax[i] = -1;
+			hit[i] = None;
+		}
+	}
+
+	void RayPacket::set(int i, const Ray& ray, float maxDistance)
+	{
+		originX[i] = ray.start.x;
+		originY[i] = ray.start.y;
+		originZ[i] = ray.start.z;
+		dirX[i] = ray.dir.x;
+		dirY[i] = ray.dir.y;
+		dirZ[i] = ray.dir.z;
+		invDirX[i] = 1.0f / dirX[i];
+		invDirY[i] = 1.0f / dirY[i];
+		invDirZ[i] = 1.0f / dirZ[i];
+		tMax[i] = maxDistance;
+		hit[i] = None;
+
+		if(i >= count)
+			count = i + 1;
+	}
+
+	namespace detail
+	{
+		/// A box broadcast to every lane.
+		template <typename L>
+		struct BroadcastAABB {
+			explicit BroadcastAABB(const AABB& box)
+			    : minX(L::Set(box.min.x)), minY(L::Set(box.min.y)), minZ(L::Set(box.min.z)),
+			      maxX(L::Set(box.max.x)), maxY(L::Set(box.max.y)), maxZ(L::Set(box.max.z)) {}
+
+			typename L::Type minX, minY, minZ, maxX, maxY, maxZ;
+		};
+
+		/// Slab test of L::Width rays against L::Width boxes (any of the two may be broadcast).
+		/// @p tNear is set to the entry distances, the returned mask has the lanes that hit within [0, tFar].
+		template <typename L>
+		inline typename L::Mask SlabTest(typename L::Type ox, typename L::Type oy, typename L::Type oz,
+		                                 typename L::Type ix, typename L::Type iy, typename L::Type iz,
+		                                 typename L::Type minX, typename L::Type minY, typename L::Type minZ,
+		                                 typename L::Type maxX, typename L::Type maxY, typename L::Type maxZ,
+		                                 typename L::Type tFar, typename L::Type& tNear)
+		{
+			using V = typename L::Type;
+
+			V t1 = L::Mul(L::Sub(minX, ox), ix), t2 = L::Mul(L::Sub(maxX, ox), ix);
+			tNear = L::Max(L::Min(t1, t2), L::Set(0));
+			tFar = L::Min(L::Max(t1, t2), tFar);
+
+			t1 = L::Mul(L::Sub(minY, oy), iy);
+			t2 = L::Mul(L::Sub(maxY, oy), iy);
+			tNear = L::Max(L::Min(t1, t2), tNear);
+			tFar = L::Min(L::Max(t1, t2), tFar);
+
+			t1 = L::Mul(L::Sub(minZ, oz), iz);
+			t2 = L::Mul(L::Sub(maxZ, oz), iz);
+			tNear = L::Max(L::Min(t1, t2), tNear);
+			tFar = L::Min(L::Max(t1, t2), tFar);
+
+			return L::LessEqual(tNear, tFar);
+		}
+
+		/// Every ray of the packet against one box. Writes the entry distances to @p tNear.
+		template <typename L>
+		unsigned IntersectAABBImpl(const RayPacket& r, const AABB& aabb, float* tNear)
+		{
+			using V = typename L::Type;
+			BroadcastAABB<L> b(aabb);
+
+			unsigned mask = 0;
+			for(int i = 0; i < RayPacket::Width; i += L::Width) {
+				V t;
+				typename L::Mask hit = SlabTest<L>(L::Load(&r.originX[i]), L::Load(&r.originY[i]), L::Load(&r.originZ[i]),
+				                                   L::Load(&r.invDirX[i]), L::Load(&r.invDirY[i]), L::Load(&r.invDirZ[i]),
+				                                   b.minX, b.minY, b.minZ, b.maxX, b.maxY, b.maxZ,
+				                                   L::Load(&r.tMax[i]), t);
+				L::Store(&tNear[i], t);
+				mask |= unsigned(L::MoveMask(hit)) << i;
+			}
+			return mask;
+		}
+
+		/// Every ray of the packet against one triangle, updating the closest hits.
+		template <typename L>
+		void IntersectTriangleImpl(RayPacket& r, const Triangle& tri, std::uint32_t index)
+		{
+			using V = typename L::Type;
+
+			vec3 e1v = tri.points[1] - tri.points[0], e2v = tri.points[2] - tri.points[0];
+			const V v0x = L::Set(tri.points[0].x), v0y = L::Set(tri.points[0].y), v0z = L::Set(tri.points[0].z);
+			const V e1x = L::Set(e1v.x), e1y = L::Set(e1v.y), e1z = L::Set(e1v.z);
+			const V e2x = L::Set(e2v.x), e2y = L::Set(e2v.y), e2z = L::Set(e2v.z);
+			const V zero = L::Set(0), one = L::Set(1), epsilon = L::Set(1e-9f);
+
+			for(int i = 0; i < RayPacket::Width; i += L::Width) {
+				V dx = L::Load(&r.dirX[i]), dy = L::Load(&r.dirY[i]), dz = L::Load(&r.dirZ[i]);
+
+				// p = dir x e2, det = e1 . p
+				V px = L::Sub(L::Mul(dy, e2z), L::Mul(dz, e2y));
+				V py = L::Sub(L::Mul(dz, e2x), L::Mul(dx, e2z));
+				V pz = L::Sub(L::Mul(dx, e2y), L::Mul(dy, e2x));
+				V det = L::Add(L::Add(L::Mul(e1x, px), L::Mul(e1y, py)), L::Mul(e1z, pz));
+				V invDet = L::Div(one, det);
+
+				// s = origin - v0, u = (s . p) / det
+				V sx = L::Sub(L::Load(&r.originX[i]), v0x);
+				V sy = L::Sub(L::Load(&r.originY[i]), v0y);
+				V sz = L::Sub(L::Load(&r.originZ[i]), v0z);
+				V u = L::Mul(L::Add(L::Add(L::Mul(sx, px), L::Mul(sy, py)), L::Mul(sz, pz)), invDet);
+
+				// q = s x e1, v = (dir . q) / det, t = (e2 . q) / det
+				V qx = L::Sub(L::Mul(sy, e1z), L::Mul(sz, e1y));
+				V qy = L::Sub(L::Mul(sz, e1x), L::Mul(sx, e1z));
+				V qz = L::Sub(L::Mul(sx, e1y), L::Mul(sy, e1x));
+				V v = L::Mul(L::Add(L::Add(L::Mul(dx, qx), L::Mul(dy, qy)), L::Mul(dz, qz)), invDet);
+				V t = L::Mul(L::Add(L::Add(L::Mul(e2x, qx), L::Mul(e2y, qy)), L::Mul(e2z, qz)), invDet);
+
+				// Parallel rays end up with NaNs, which fail every comparison.
+				typename L::Mask hit = L::And(L::Less(epsilon, L::Abs(det)),
+				                              L::And(L::And(L::LessEqual(zero, u), L::LessEqual(zero, v)),
+				                                     L::And(L::LessEqual(L::Add(u, v), one),
+				                                            L::And(L::LessEqual(zero, t), L::Less(t, L::Load(&r.tMax[i]))))));
+
+				int bits = L::MoveMask(hit);
+				if(!bits)
+					continue;
+
+				// Hits are rare compared to tests, they're written out one lane at a time.
+				float ts[L::Width];
+				L::Store(ts, t);
+				for(int lane = 0; lane < L::Width; lane++) {
+					if(bits & (1 << lane)) {
+						r.tMax[i + lane] = ts[lane];
+						r.hit[i + lane] = index;
+					}
+				}
+			}
+		}
+
+		/// One ray against boxes [begin, end) in steps of L::Width. Returns the index of the first box it didn't test.
+		template <typename L>
+		std::size_t RaycastAABBsImpl(const RayPacket& r, const PointStream& mins, const PointStream& maxs,
+		                             std::size_t begin, std::size_t end, float& best, std::uint32_t& bestIndex)
+		{
+			using V = typename L::Type;
+			const V ox = L::Set(r.originX[0]), oy = L::Set(r.originY[0]), oz = L::Set(r.originZ[0]);
+			const V ix = L::Set(r.invDirX[0]), iy = L::Set(r.invDirY[0]), iz = L::Set(r.invDirZ[0]);
+
+			std::size_t i = begin;
+			for(; i + L::Width <= end; i += L::Width) {
+				V t;
+				typename L::Mask hit = SlabTest<L>(ox, oy, oz, ix, iy, iz,
+				                                   L::Load(&mins.x[i]), L::Load(&mins.y[i]), L::Load(&mins.z[i]),
+				                                   L::Load(&maxs.x[i]), L::Load(&maxs.y[i]), L::Load(&maxs.z[i]),
+				                                   L::Set(best), t);
+
+				int bits = L::MoveMask(hit);
+				if(!bits)
+					continue;
+
+				float ts[L::Width];
+				L::Store(ts, t);
+				for(int lane = 0; lane < L::Width; lane++) {
+					if((bits & (1 << lane)) && ts[lane] < best) {
+						best = ts[lane];
+						bestIndex = i + lane;
+					}
+				}
+			}
+			return i;
+		}
+	} // namespace detail
+
+	unsigned IntersectAABB(const RayPacket& rays, const AABB& box)
+	{
+		float tNear[RayPacket::Width];
+		return detail::IntersectAABBImpl<detail::WideLanes>(rays, box, tNear);
+	}
+
+	void IntersectAABBs(RayPacket& rays, const PointStream& mins, const PointStream& maxs)
+	{
+		float tNear[RayPacket::Width];
+		for(std::size_t i = 0; i < mins.size(); i++) {
+			unsigned mask = detail::IntersectAABBImpl<detail::WideLanes>(rays, AABB(mins.get(i), maxs.get(i)), tNear);
+
+			for(int lane = 0; mask; lane++, mask >>= 1) {
+				// tNear <= tMax for every hit, ties go to the first box.
+				if((mask & 1) && (tNear[lane] < rays.tMax[lane] || rays.hit[lane] == RayPacket::None)) {
+					rays.tMax[lane] = tNear[lane];
+					rays.hit[lane] = i;
+				}
+			}
+		}
+	}
+
+	void IntersectTriangles(RayPacket& rays, const Triangle* triangles, std::size_t count, std::uint32_t firstIndex)
+	{
+		for(std::size_t i = 0; i < count; i++)
+			detail::IntersectTriangleImpl<detail::WideLanes>(rays, triangles[i], firstIndex + i);
+	}
+
+	std::uint32_t RaycastAABBs(const Ray& ray, const PointStream& mins, const PointStream& maxs,
+	                           float maxDistance, float* t)
+	{
+		RayPacket r;
+		r.set(0, ray, maxDistance);
+
+		float best = maxDistance;
+		std::uint32_t bestIndex = RayPacket::None;
+		std::size_t i = detail::RaycastAABBsImpl<detail::WideLanes>(r, mins, maxs, 0, mins.size(), best, bestIndex);
+		detail::RaycastAABBsImpl<detail::ScalarLanes>(r, mins, maxs, i, mins.size(), best, bestIndex);
+
+		if(t && bestIndex != RayPacket::None)
+			*t = best;
+		return bestIndex;
+	}
+} // namespace SWAN
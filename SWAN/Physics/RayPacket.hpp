@@ -0,0 +1,72 @@
+#ifndef SWAN_RAY_PACKET_HPP
+#define SWAN_RAY_PACKET_HPP
+
+#include <cstddef> // For std::size_t
+#include <cstdint> // For std::uint32_t
+
+#include "Basic.hpp"             // For SWAN::AABB, SWAN::Ray, SWAN::Triangle
+#include "Maths/PointStream.hpp" // For SWAN::PointStream
+
+namespace SWAN
+{
+	/**
+	 * @brief Up to 8 rays in structure-of-arrays form, tested together with SSE or AVX.
+	 *
+	 * Every ray has a maximum distance, which the closest-hit functions shrink as they
+	 * find hits, along with the index of what was hit. Unused rays never hit anything.
+	 */
+	struct alignas(32) RayPacket {
+		static constexpr int Width = 8;
+
+		/// Index of a ray that hasn't hit anything.
+		static constexpr std::uint32_t None = ~std::uint32_t(0);
+
+		RayPacket();
+
+		/// Sets the i-th ray and resets its hit.
+		void set(int i, const Ray& ray, float maxDistance = 1e30f);
+
+		/// Number of rays that have been set.
+		int count = 0;
+
+		float originX[Width], originY[Width], originZ[Width];
+		float dirX[Width], dirY[Width], dirZ[Width];
+		/// 1 / direction, for the slab tests.
+		float invDirX[Width], invDirY[Width], invDirZ[Width];
+
+		/// Maximum distance of every ray, and then the distance to the closest hit.
+		float tMax[Width];
+		/// Index of the closest box or triangle hit, or None.
+		std::uint32_t hit[Width];
+	};
+
+	/// Tests every ray of the packet against one box. Returns a mask with bit i set if ray i hits it within its tMax.
+	extern unsigned IntersectAABB(const RayPacket& rays, const AABB& box);
+
+	/**
+	 * @brief Finds the closest box hit by every ray of the packet.
+	 *
+	 * The i-th box is (mins[i], maxs[i]). Rays that hit a box closer than their tMax
+	 * get their tMax set to the distance at which they enter it, and hit set to its index.
+	 */
+	extern void IntersectAABBs(RayPacket& rays, const PointStream& mins, const PointStream& maxs);
+
+	/**
+	 * @brief Finds the closest triangle hit by every ray of the packet (Moller-Trumbore).
+	 *
+	 * Both sides of the triangles are hit. Rays that hit a triangle closer than their tMax
+	 * get their tMax set to the hit distance, and hit set to its index plus @p firstIndex.
+	 */
+	extern void IntersectTriangles(RayPacket& rays, const Triangle* triangles, std::size_t count, std::uint32_t firstIndex = 0);
+
+	/**
+	 * @brief Finds the closest box hit by one ray, testing 4 or 8 boxes at a time.
+	 *
+	 * @param t Set to the distance at which the ray enters the box, if there's a hit.
+	 * @return Index of the box, or RayPacket::None.
+	 */
+	extern std::uint32_t RaycastAABBs(const Ray& ray, const PointStream& mins, const PointStream& maxs,
+	                                  float maxDistance, float* t = nullptr);
+} // namespace SWAN
+
+#endif
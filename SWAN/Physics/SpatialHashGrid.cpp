@@ -0,0 +1,195 @@
+#include "SpatialHashGrid.hpp"
+
+#include <algorithm> // For std::max()
+#include <cmath>     // For std::floor()
+
+namespace SWAN
+{
+	constexpr SpatialHashGrid::ProxyID SpatialHashGrid::None;
+
+	static inline std::uint32_t HashCoord(const ivec3& c)
+	{
+		return std::uint32_t(c.x) * 73856093u ^ std::uint32_t(c.y) * 19349663u ^ std::uint32_t(c.z) * 83492791u;
+	}
+
+	SpatialHashGrid::SpatialHashGrid(double cellSize)
+	    : cellSize(cellSize), invCellSize(1.0 / cellSize), table(64, None) {}
+
+	SpatialHashGrid::ProxyID SpatialHashGrid::insert(const AABB& box, std::uint32_t userData)
+	{
+		ProxyID id;
+		if(freeIDs.empty()) {
+			id = objects.size();
+			objects.push_back(Object());
+		} else {
+			id = freeIDs.back();
+			freeIDs.pop_back();
+		}
+
+		objects[id].box = box;
+		objects[id].userData = userData;
+		addToCell(id);
+
+		proxyCount++;
+		return id;
+	}
+
+	SpatialHashGrid::ProxyID SpatialHashGrid::insert(const Sphere& sphere, std::uint32_t userData)
+	{
+		return insert(SphereBox(sphere), userData);
+	}
+
+	void SpatialHashGrid::remove(ProxyID proxy)
+	{
+		removeFromCell(proxy);
+		freeIDs.push_back(proxy);
+		proxyCount--;
+	}
+
+	void SpatialHashGrid::move(ProxyID proxy, const AABB& box, vec3)
+	{
+		Object& o = objects[proxy];
+		o.box = box;
+
+		if(cellCoord(box.center()) == cells[o.cell].coord) {
+			vec3 half = (box.max - box.min) / 2;
+			maxHalfSize = vec3(std::max(maxHalfSize.x, half.x), std::max(maxHalfSize.y, half.y), std::max(maxHalfSize.z, half.z));
+			return;
+		}
+
+		removeFromCell(proxy);
+		addToCell(proxy);
+	}
+
+	void SpatialHashGrid::move(ProxyID proxy, const Sphere& sphere)
+	{
+		move(proxy, SphereBox(sphere));
+	}
+
+	void SpatialHashGrid::queryPairs(Vector<Pair>& out) const
+	{
+		out.clear();
+		for(const Cell& cell : cells) {
+			for(ProxyID a : cell.objects) {
+				query(objects[a].box, [&](ProxyID b) {
+					if(a < b)
+						out.push_back({ a, b });
+				});
+			}
+		}
+	}
+
+	ivec3 SpatialHashGrid::cellCoord(const vec3& p) const
+	{
+		return ivec3((int) std::floor(p.x * invCellSize),
+		             (int) std::floor(p.y * invCellSize),
+		             (int) std::floor(p.z * invCellSize));
+	}
+
+	std::uint32_t SpatialHashGrid::findCell(const ivec3& coord) const
+	{
+		std::uint32_t mask = table.size() - 1;
+		for(std::uint32_t i = HashCoord(coord) & mask;; i = (i + 1) & mask) {
+			std::uint32_t cell = table[i];
+			if(cell == None || cells[cell].coord == coord)
+				return cell;
+		}
+	}
+
+	std::uint32_t SpatialHashGrid::getOrAddCell(const ivec3& coord)
+	{
+		std::uint32_t mask = table.size() - 1;
+		std::uint32_t i = HashCoord(coord) & mask;
+		for(; table[i] != None; i = (i + 1) & mask)
+			if(cells[table[i]].coord == coord)
+				return table[i];
+
+		// Keep the table at most half full, probes stay short. Only a new cell can fill it up.
+		if(2 * (cellCount + 1) > table.size()) {
+			growTable();
+			mask = table.size() - 1;
+			i = HashCoord(coord) & mask;
+			while(table[i] != None)
+				i = (i + 1) & mask;
+		}
+
+		std::uint32_t cell;
+		if(freeCells.empty()) {
+			cell = cells.size();
+			cells.push_back(Cell());
+		} else {
+			cell = freeCells.back();
+			freeCells.pop_back();
+		}
+
+		cells[cell].coord = coord;
+		table[i] = cell;
+		cellCount++;
+		return cell;
+	}
+
+	void SpatialHashGrid::removeCell(std::uint32_t cell)
+	{
+		std::uint32_t mask = table.size() - 1;
+		std::uint32_t i = HashCoord(cells[cell].coord) & mask;
+		while(table[i] != cell)
+			i = (i + 1) & mask;
+
+		// Backward shift deletion: move later entries of the probe run into the hole,
+		// unless they're already at or past their ideal position.
+		for(std::uint32_t j = (i + 1) & mask; table[j] != None; j = (j + 1) & mask) {
+			std::uint32_t ideal = HashCoord(cells[table[j]].coord) & mask;
+			if(((j - ideal) & mask) >= ((j - i) & mask)) {
+				table[i] = table[j];
+				i = j;
+			}
+		}
+		table[i] = None;
+
+		// The cell's (empty) list keeps its memory for the next cell that reuses it.
+		freeCells.push_back(cell);
+		cellCount--;
+	}
+
+	void SpatialHashGrid::growTable()
+	{
+		Vector<std::uint32_t> old(table.size() * 2, None);
+		old.swap(table);
+
+		std::uint32_t mask = table.size() - 1;
+		for(std::uint32_t cell : old) {
+			if(cell == None)
+				continue;
+			std::uint32_t i = HashCoord(cells[cell].coord) & mask;
+			while(table[i] != None)
+				i = (i + 1) & mask;
+			table[i] = cell;
+		}
+	}
+
+	void SpatialHashGrid::addToCell(ProxyID proxy)
+	{
+		Object& o = objects[proxy];
+		vec3 half = (o.box.max - o.box.min) / 2;
+		maxHalfSize = vec3(std::max(maxHalfSize.x, half.x), std::max(maxHalfSize.y, half.y), std::max(maxHalfSize.z, half.z));
+
+		o.cell = getOrAddCell(cellCoord(o.box.center()));
+		o.slot = cells[o.cell].objects.size();
+		cells[o.cell].objects.push_back(proxy);
+	}
+
+	void SpatialHashGrid::removeFromCell(ProxyID proxy)
+	{
+		const Object& o = objects[proxy];
+		Vector<ProxyID>& list = cells[o.cell].objects;
+
+		// Swap with the last object of the cell.
+		ProxyID last = list.back();
+		list[o.slot] = last;
+		objects[last].slot = o.slot;
+		list.pop_back();
+
+		if(list.empty())
+			removeCell(o.cell);
+	}
+} // namespace SWAN
@@ -0,0 +1,187 @@
+#ifndef SWAN_SPATIAL_HASH_GRID_HPP
+#define SWAN_SPATIAL_HASH_GRID_HPP
+
+#include <cstdint> // For std::uint32_t
+
+#include "Basic.hpp"        // For SWAN::AABB, SWAN::Sphere
+#include "Core/Defs.hpp"    // For SWAN::Vector<T>
+#include "Maths/Vector.hpp" // For SWAN::vec3, SWAN::ivec3
+
+namespace SWAN
+{
+	/**
+	 * @brief Uniform grid of cubic cells, stored sparsely in a hash table.
+	 *
+	 * Meant for many objects of similar size (particles, pickups, voxels), where it's
+	 * cheaper than a tree. Each object lives in the one cell that contains its center,
+	 * so insert(), move() and remove() are O(1). Queries are grown by the largest
+	 * half-size seen so far to still find objects that reach into neighbouring cells,
+	 * so the cell size should be about the size of a typical object.
+	 *
+	 * Cells are looked up with open addressing (linear probing) on their integer
+	 * coordinates, and each cell keeps its objects in one contiguous array.
+	 *
+	 * Has the same interface as AABBTree, so it can be used as a PhysicsWorld broadphase.
+	 */
+	class SpatialHashGrid
+	{
+	  public:
+		using ProxyID = std::uint32_t;
+
+		/// ID of a proxy that doesn't exist.
+		static constexpr ProxyID None = ~ProxyID(0);
+
+		/// A pair of overlapping proxies, a < b.
+		struct Pair {
+			ProxyID a, b;
+		};
+
+		/// @param cellSize Length of the side of a cell.
+		explicit SpatialHashGrid(double cellSize = 1);
+
+		ProxyID insert(const AABB& box, std::uint32_t userData);
+		ProxyID insert(const Sphere& sphere, std::uint32_t userData);
+
+		void remove(ProxyID proxy);
+
+		/// Update the box of a proxy. The displacement is only there for compatibility with AABBTree.
+		void move(ProxyID proxy, const AABB& box, vec3 displacement = vec3(0));
+		void move(ProxyID proxy, const Sphere& sphere);
+
+		/// Get the user data that was passed to insert().
+		inline std::uint32_t getUserData(ProxyID proxy) const { return objects[proxy].userData; }
+
+		/// Get the box of a proxy.
+		inline const AABB& getAABB(ProxyID proxy) const { return objects[proxy].box; }
+
+		/// Call @p callback with the ID of every proxy whose box overlaps @p box.
+		template <typename Callback>
+		void query(const AABB& box, Callback callback) const
+		{
+			forEachCandidate(box, [&](ProxyID id) {
+				if(objects[id].box.Overlaps(box))
+					callback(id);
+			});
+		}
+
+		/// Call @p callback with the ID of every proxy whose box overlaps @p sphere.
+		template <typename Callback>
+		void query(const Sphere& sphere, Callback callback) const
+		{
+			double r2 = (double) sphere.radius * sphere.radius;
+			forEachCandidate(SphereBox(sphere), [&](ProxyID id) {
+				if(objects[id].box.DistanceSquared(sphere.center) <= r2)
+					callback(id);
+			});
+		}
+
+		/**
+		 * @brief Call @p callback with every other proxy in the 3x3x3 block of cells around @p proxy's cell.
+		 *
+		 * No overlap tests are done, this is the usual "nearby objects" query for
+		 * particles and flocking. Every proxy within one cell size of @p proxy's center is included.
+		 */
+		template <typename Callback>
+		void queryNeighbours(ProxyID proxy, Callback callback) const
+		{
+			ivec3 c = cells[objects[proxy].cell].coord;
+			for(int z = c.z - 1; z <= c.z + 1; z++)
+				for(int y = c.y - 1; y <= c.y + 1; y++)
+					for(int x = c.x - 1; x <= c.x + 1; x++) {
+						std::uint32_t cell = findCell(ivec3(x, y, z));
+						if(cell == None)
+							continue;
+						for(ProxyID id : cells[cell].objects)
+							if(id != proxy)
+								callback(id);
+					}
+		}
+
+		/// Fills @p out with every pair of proxies whose boxes overlap. Each pair is reported once.
+		void queryPairs(Vector<Pair>& out) const;
+
+		/// Number of proxies.
+		inline unsigned size() const { return proxyCount; }
+
+		/// Length of the side of a cell.
+		inline double getCellSize() const { return cellSize; }
+
+		/// Number of cells that contain at least one proxy.
+		inline unsigned getCellCount() const { return cellCount; }
+
+	  private:
+		struct Object {
+			AABB box;
+			/// Index of the cell the object is in, and its position in that cell's list.
+			std::uint32_t cell, slot;
+			std::uint32_t userData;
+		};
+
+		struct Cell {
+			ivec3 coord;
+			Vector<ProxyID> objects;
+		};
+
+		/// Calls @p callback with every proxy in the cells that can hold objects overlapping @p box.
+		template <typename Callback>
+		void forEachCandidate(const AABB& box, Callback callback) const
+		{
+			ivec3 lo = cellCoord(box.min - maxHalfSize), hi = cellCoord(box.max + maxHalfSize);
+			double range = (double) (hi.x - lo.x + 1) * (hi.y - lo.y + 1) * (hi.z - lo.z + 1);
+
+			// A big query is cheaper by going through the cells that exist.
+			if(range > cellCount) {
+				for(const Cell& cell : cells) {
+					const ivec3& c = cell.coord;
+					if(c.x >= lo.x && c.x <= hi.x && c.y >= lo.y && c.y <= hi.y && c.z >= lo.z && c.z <= hi.z)
+						for(ProxyID id : cell.objects)
+							callback(id);
+				}
+				return;
+			}
+
+			for(int z = lo.z; z <= hi.z; z++)
+				for(int y = lo.y; y <= hi.y; y++)
+					for(int x = lo.x; x <= hi.x; x++) {
+						std::uint32_t cell = findCell(ivec3(x, y, z));
+						if(cell == None)
+							continue;
+						for(ProxyID id : cells[cell].objects)
+							callback(id);
+					}
+		}
+
+		ivec3 cellCoord(const vec3& p) const;
+
+		/// Index of the cell at @p coord, or None.
+		std::uint32_t findCell(const ivec3& coord) const;
+		/// Index of the cell at @p coord, creating it if needed.
+		std::uint32_t getOrAddCell(const ivec3& coord);
+		/// Removes an empty cell from the table.
+		void removeCell(std::uint32_t cell);
+		void growTable();
+
+		void addToCell(ProxyID proxy);
+		void removeFromCell(ProxyID proxy);
+
+		static inline AABB SphereBox(const Sphere& s) { return AABB(s.center - vec3(s.radius), s.center + vec3(s.radius)); }
+
+		double cellSize, invCellSize;
+		/// Largest half-size of any object inserted so far.
+		vec3 maxHalfSize = vec3(0);
+
+		Vector<Object> objects;
+		Vector<ProxyID> freeIDs;
+		unsigned proxyCount = 0;
+
+		/// Cells, empty ones are kept for their allocated lists and recycled.
+		Vector<Cell> cells;
+		Vector<std::uint32_t> freeCells;
+		unsigned cellCount = 0;
+
+		/// Open addressing table of cell indices, its size is a power of two.
+		Vector<std::uint32_t> table;
+	};
+} // namespace SWAN
+
+#endif
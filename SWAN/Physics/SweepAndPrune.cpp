@@ -0,0 +1,207 @@
+#include "SweepAndPrune.hpp"
+
+#include <algorithm> // For std::sort()
+
+namespace SWAN
+{
+	constexpr SweepAndPrune::ProxyID SweepAndPrune::None;
+
+	static inline Real Axis(const vec3& v, int axis) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); }
+
+	SweepAndPrune::ProxyID SweepAndPrune::insert(const AABB& box, std::uint32_t userData)
+	{
+		ProxyID id;
+		if(freeIDs.empty()) {
+			id = proxies.size();
+			proxies.push_back(Proxy());
+		} else {
+			id = freeIDs.back();
+			freeIDs.pop_back();
+		}
+
+		Proxy& p = proxies[id];
+		p.box = box;
+		p.userData = userData;
+		p.removed = false;
+
+		// Appended at the end, update() sorts them into place and finds the overlaps on the way.
+		for(int axis = 0; axis < 3; axis++) {
+			p.minIndex[axis] = endpoints[axis].size();
+			endpoints[axis].push_back({ Axis(box.min, axis), id << 1 });
+			p.maxIndex[axis] = endpoints[axis].size();
+			endpoints[axis].push_back({ Axis(box.max, axis), (id << 1) | 1 });
+		}
+
+		pendingInserts++;
+		proxyCount++;
+		return id;
+	}
+
+	void SweepAndPrune::remove(ProxyID proxy)
+	{
+		proxies[proxy].removed = true;
+		pendingRemoval.push_back(proxy);
+		proxyCount--;
+	}
+
+	void SweepAndPrune::move(ProxyID proxy, const AABB& box, vec3)
+	{
+		Proxy& p = proxies[proxy];
+		p.box = box;
+		for(int axis = 0; axis < 3; axis++) {
+			endpoints[axis][p.minIndex[axis]].value = Axis(box.min, axis);
+			endpoints[axis][p.maxIndex[axis]].value = Axis(box.max, axis);
+		}
+	}
+
+	void SweepAndPrune::update()
+	{
+		addedPairs.clear();
+		removedPairs.clear();
+
+		if(!pendingRemoval.empty())
+			purgeRemoved();
+
+		// Every new endpoint starts at the end, sorting in lots of them at once is faster from scratch.
+		if(pendingInserts > 64 && pendingInserts > proxyCount / 16) {
+			rebuild();
+		} else {
+			for(int axis = 0; axis < 3; axis++)
+				sortAxis(axis);
+		}
+		pendingInserts = 0;
+	}
+
+	void SweepAndPrune::queryPairs(Vector<Pair>& out)
+	{
+		update();
+
+		out.clear();
+		out.reserve(pairs.size());
+		for(std::uint64_t key : pairs)
+			out.push_back({ ProxyID(key >> 32), ProxyID(key & 0xFFFFFFFF) });
+	}
+
+	void SweepAndPrune::sortAxis(int axis)
+	{
+		Vector<Endpoint>& ep = endpoints[axis];
+
+		for(std::uint32_t i = 1; i < ep.size(); i++) {
+			Endpoint e = ep[i];
+			std::uint32_t j = i;
+
+			// e moves down past every endpoint that's greater than it.
+			while(j > 0 && ep[j - 1] > e) {
+				const Endpoint& other = ep[j - 1];
+				if(e.isMax() != other.isMax() && e.proxy() != other.proxy()) {
+					if(!e.isMax()) {
+						// A minimum passed a maximum: they overlap on this axis now.
+						if(proxies[e.proxy()].box.Overlaps(proxies[other.proxy()].box))
+							addPair(e.proxy(), other.proxy());
+					} else {
+						// A maximum passed a minimum: they don't overlap on this axis anymore.
+						removePair(e.proxy(), other.proxy());
+					}
+				}
+
+				ep[j] = other;
+				j--;
+			}
+			ep[j] = e;
+		}
+
+		// Endpoints have moved around, refresh every proxy's indices.
+		updateIndices(axis);
+	}
+
+	void SweepAndPrune::rebuild()
+	{
+		for(int axis = 0; axis < 3; axis++) {
+			std::sort(endpoints[axis].begin(), endpoints[axis].end());
+			updateIndices(axis);
+		}
+
+		// Sweep along X, keeping a list of the boxes that are open at the current position.
+		std::unordered_set<std::uint64_t> found;
+		Vector<ProxyID> open;
+		Vector<std::uint32_t> openIndex(proxies.size());
+		for(const Endpoint& e : endpoints[0]) {
+			ProxyID id = e.proxy();
+			if(e.isMax()) {
+				// Swap-remove it from the open list.
+				ProxyID last = open.back();
+				open[openIndex[id]] = last;
+				openIndex[last] = openIndex[id];
+				open.pop_back();
+				continue;
+			}
+
+			const AABB& box = proxies[id].box;
+			for(ProxyID other : open)
+				if(box.Overlaps(proxies[other].box))
+					found.insert(PairKey(id, other));
+
+			openIndex[id] = open.size();
+			open.push_back(id);
+		}
+
+		for(std::uint64_t key : pairs)
+			if(!found.count(key))
+				removedPairs.push_back({ ProxyID(key >> 32), ProxyID(key & 0xFFFFFFFF) });
+		for(std::uint64_t key : found)
+			if(!pairs.count(key))
+				addedPairs.push_back({ ProxyID(key >> 32), ProxyID(key & 0xFFFFFFFF) });
+
+		pairs.swap(found);
+	}
+
+	void SweepAndPrune::updateIndices(int axis)
+	{
+		const Vector<Endpoint>& ep = endpoints[axis];
+		for(std::uint32_t i = 0; i < ep.size(); i++) {
+			Proxy& p = proxies[ep[i].proxy()];
+			(ep[i].isMax() ? p.maxIndex : p.minIndex)[axis] = i;
+		}
+	}
+
+	void SweepAndPrune::purgeRemoved()
+	{
+		for(int axis = 0; axis < 3; axis++) {
+			Vector<Endpoint>& ep = endpoints[axis];
+			std::uint32_t out = 0;
+			for(std::uint32_t i = 0; i < ep.size(); i++)
+				if(!proxies[ep[i].proxy()].removed)
+					ep[out++] = ep[i];
+			ep.resize(out);
+		}
+
+		for(auto it = pairs.begin(); it != pairs.end();) {
+			ProxyID a = *it >> 32, b = *it & 0xFFFFFFFF;
+			if(proxies[a].removed || proxies[b].removed) {
+				removedPairs.push_back({ a, b });
+				it = pairs.erase(it);
+			} else {
+				it++;
+			}
+		}
+
+		// Only now can the IDs be handed out again, the pairs above still referred to them.
+		for(ProxyID id : pendingRemoval) {
+			proxies[id].removed = false;
+			freeIDs.push_back(id);
+		}
+		pendingRemoval.clear();
+	}
+
+	void SweepAndPrune::addPair(ProxyID a, ProxyID b)
+	{
+		if(pairs.insert(PairKey(a, b)).second)
+			addedPairs.push_back(a < b ? Pair{ a, b } : Pair{ b, a });
+	}
+
+	void SweepAndPrune::removePair(ProxyID a, ProxyID b)
+	{
+		if(pairs.erase(PairKey(a, b)))
+			removedPairs.push_back(a < b ? Pair{ a, b } : Pair{ b, a });
+	}
+} // namespace SWAN
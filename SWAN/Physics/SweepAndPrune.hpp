@@ -0,0 +1,128 @@
+#ifndef SWAN_SWEEP_AND_PRUNE_HPP
+#define SWAN_SWEEP_AND_PRUNE_HPP
+
+#include <cstdint>       // For std::uint32_t, std::uint64_t
+#include <unordered_set> // For std::unordered_set<T>
+
+#include "Basic.hpp"        // For SWAN::AABB
+#include "Core/Defs.hpp"    // For SWAN::Vector<T>
+#include "Maths/Vector.hpp" // For SWAN::Real
+
+namespace SWAN
+{
+	/**
+	 * @brief Incremental sweep-and-prune broadphase.
+	 *
+	 * Keeps the box endpoints sorted along each axis. update() re-sorts them with an
+	 * insertion sort, which is close to linear when boxes move only a little per step,
+	 * and every swap of a minimum with a maximum starts or ends an overlap.
+	 * The set of overlapping pairs is kept between steps, so changes are reported as
+	 * added and removed pairs instead of rediscovering every pair.
+	 *
+	 * Has the same interface as AABBTree, so the two can be swapped.
+	 */
+	class SweepAndPrune
+	{
+	  public:
+		using ProxyID = std::uint32_t;
+
+		/// ID of a proxy that doesn't exist.
+		static constexpr ProxyID None = ~ProxyID(0);
+
+		/// A pair of overlapping proxies, a < b.
+		struct Pair {
+			ProxyID a, b;
+		};
+
+		/// Add a proxy for a box. It's sorted in and paired up on the next update().
+		ProxyID insert(const AABB& box, std::uint32_t userData);
+
+		/// Remove a proxy. Its pairs are removed on the next update().
+		void remove(ProxyID proxy);
+
+		/// Update the box of a proxy. The displacement is only there for compatibility with AABBTree.
+		void move(ProxyID proxy, const AABB& box, vec3 displacement = vec3(0));
+
+		/// Re-sorts the endpoints and updates the pairs, filling getAddedPairs() and getRemovedPairs().
+		void update();
+
+		/// Calls update() and fills @p out with every overlapping pair.
+		void queryPairs(Vector<Pair>& out);
+
+		/// Pairs that started overlapping during the last update().
+		inline const Vector<Pair>& getAddedPairs() const { return addedPairs; }
+
+		/// Pairs that stopped overlapping (or lost a proxy) during the last update().
+		inline const Vector<Pair>& getRemovedPairs() const { return removedPairs; }
+
+		/// Get the user data that was passed to insert().
+		inline std::uint32_t getUserData(ProxyID proxy) const { return proxies[proxy].userData; }
+
+		/// Get the box of a proxy.
+		inline const AABB& getAABB(ProxyID proxy) const { return proxies[proxy].box; }
+
+		/// Number of overlapping pairs as of the last update().
+		inline unsigned getPairCount() const { return pairs.size(); }
+
+		/// Number of proxies.
+		inline unsigned size() const { return proxyCount; }
+
+	  private:
+		struct Endpoint {
+			Real value;
+			/// Proxy ID << 1, the lowest bit is set for maximums.
+			std::uint32_t data;
+
+			inline ProxyID proxy() const { return data >> 1; }
+			inline bool isMax() const { return data & 1; }
+
+			/// Minimums come before maximums with the same value, so touching boxes overlap.
+			inline bool operator>(const Endpoint& o) const
+			{
+				return value > o.value || (value == o.value && isMax() && !o.isMax());
+			}
+			inline bool operator<(const Endpoint& o) const { return o > *this; }
+		};
+
+		struct Proxy {
+			AABB box;
+			/// Position of the minimum and maximum endpoint on each axis.
+			std::uint32_t minIndex[3], maxIndex[3];
+			std::uint32_t userData;
+			bool removed;
+		};
+
+		/// Insertion sorts one axis, starting and ending overlaps as endpoints swap.
+		void sortAxis(int axis);
+
+		/// Sorts every axis from scratch and finds the pairs with one sweep. Used after many inserts,
+		/// where the insertion sort would be quadratic.
+		void rebuild();
+
+		/// Refreshes every proxy's indices into one axis.
+		void updateIndices(int axis);
+
+		/// Drops the endpoints and pairs of removed proxies.
+		void purgeRemoved();
+
+		void addPair(ProxyID a, ProxyID b);
+		void removePair(ProxyID a, ProxyID b);
+
+		static inline std::uint64_t PairKey(ProxyID a, ProxyID b)
+		{
+			return a < b ? (std::uint64_t(a) << 32) | b : (std::uint64_t(b) << 32) | a;
+		}
+
+		Vector<Endpoint> endpoints[3];
+		Vector<Proxy> proxies;
+		Vector<ProxyID> freeIDs;
+		Vector<ProxyID> pendingRemoval;
+		unsigned pendingInserts = 0;
+		unsigned proxyCount = 0;
+
+		std::unordered_set<std::uint64_t> pairs;
+		Vector<Pair> addedPairs, removedPairs;
+	};
+} // namespace SWAN
+
+#endif
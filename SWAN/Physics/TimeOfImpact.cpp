@@ -0,0 +1,251 @@
+#include "TimeOfImpact.hpp"
+
+#include <algorithm> // For std::min(), std::max()
+#include <cmath>     // For std::abs()
+#include <limits>    // For std::numeric_limits<T>
+
+namespace SWAN
+{
+	/// Most steps conservative advancement takes before it gives up and reports a hit where it got to.
+	static constexpr int MaxAdvancementSteps = 32;
+
+	/**
+	 * @brief Moves a shape forward by its distance to the target until it's within @p tolerance.
+	 *
+	 * @p separation(offset, normal) returns a lower bound of the distance between the shapes when the
+	 * moving one is moved by @p offset, and sets @p normal to the direction it closes in along. The bound
+	 * has to be convex along the motion (true for the distance between convex shapes), so stepping to
+	 * where its tangent reaches zero can't overshoot, and once it stops shrinking it never will.
+	 */
+	template <typename Separation>
+	static TimeOfImpact ConservativeAdvancement(vec3 motion, double tolerance, double maxTime, Separation separation)
+	{
+		TimeOfImpact res;
+		// A shape that isn't moving can't close in on anything, and the sphere separations normalize the motion.
+		if(motion == vec3(0))
+			return res;
+
+		double t = 0;
+		vec3 normal;
+		for(int step = 0; step < MaxAdvancementSteps; step++) {
+			double distance = separation(motion * t, normal);
+			double closing = Dot(motion, normal);
+			if(closing <= 0)
+				return res;
+
+			if(distance <= tolerance) {
+				res.happened = true;
+				res.time = t;
+				res.normal = normal;
+				return res;
+			}
+
+			// Aim for half the tolerance, so the step after lands inside it.
+			t += (distance - tolerance / 2) / closing;
+			if(t > maxTime)
+				return res;
+		}
+
+		// t is still before the impact, so stopping there is safe.
+		res.happened = true;
+		res.time = t;
+		res.normal = normal;
+		return res;
+	}
+
+	/// Distance from a sphere to the closest point of a shape, and the direction towards it.
+	static double SphereSeparation(const Sphere& sphere, vec3 offset, vec3 closest, vec3& normal)
+	{
+		vec3 d = closest - (sphere.center + offset);
+		double length = Length(d);
+		normal = length > 0 ? d / length : vec3(0);
+		return length - sphere.radius;
+	}
+
+	/// The corner of the box furthest along @p dir.
+	static vec3 Support(const AABB& box, vec3 dir)
+	{
+		return vec3(dir.x >= 0 ? box.max.x : box.min.x, dir.y >= 0 ? box.max.y : box.min.y, dir.z >= 0 ? box.max.z : box.min.z);
+	}
+
+	static TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Triangle& triangle, double tolerance, double maxTime)
+	{
+		return ConservativeAdvancement(motion, tolerance, maxTime, [&](vec3 offset, vec3& normal) {
+			return SphereSeparation(sphere, offset, ClosestPoint(triangle, sphere.center + offset), normal);
+		});
+	}
+
+	static TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Triangle& triangle, double tolerance, double maxTime)
+	{
+		// The largest gap between the box and the triangle along the axes of the separating axis test
+		// is a lower bound of their distance, and a maximum of linear functions of the offset.
+		vec3 c = box.center(), e = (box.max - box.min) / 2;
+		const vec3 edges[3] = { triangle.points[1] - triangle.points[0], triangle.points[2] - triangle.points[1], triangle.points[0] - triangle.points[2] };
+		const vec3 boxAxes[3] = { vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+
+		vec3 axes[13];
+		int count = 0;
+		for(const vec3& axis : boxAxes)
+			axes[count++] = axis;
+		axes[count++] = Normalized(Cross(edges[0], edges[1]));
+		for(const vec3& axis : boxAxes) {
+			for(const vec3& edge : edges) {
+				vec3 cross = Cross(axis, edge);
+				double length = Length(cross);
+				if(length > 1e-9)
+					axes[count++] = cross / length;
+			}
+		}
+
+		return ConservativeAdvancement(motion, tolerance, maxTime, [&](vec3 offset, vec3& normal) {
+			double best = -std::numeric_limits<double>::infinity();
+			for(int i = 0; i < count; i++) {
+				const vec3& axis = axes[i];
+				double center = Dot(c + offset, axis);
+				double r = e.x * std::abs(axis.x) + e.y * std::abs(axis.y) + e.z * std::abs(axis.z);
+				double p0 = Dot(triangle.points[0], axis), p1 = Dot(triangle.points[1], axis), p2 = Dot(triangle.points[2], axis);
+				double ahead = std::min(p0, std::min(p1, p2)) - (center + r);
+				double behind = (center - r) - std::max(p0, std::max(p1, p2));
+				if(ahead > best) {
+					best = ahead;
+					normal = axis;
+				}
+				if(behind > best) {
+					best = behind;
+					normal = -axis;
+				}
+			}
+			return best;
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Plane& plane, double tolerance)
+	{
+		return ConservativeAdvancement(motion, tolerance, 1, [&](vec3 offset, vec3& normal) {
+			normal = -plane.normal;
+			return Dot(sphere.center + offset, plane.normal) - plane.offset - sphere.radius;
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const AABB& aabb, double tolerance)
+	{
+		return ConservativeAdvancement(motion, tolerance, 1, [&](vec3 offset, vec3& normal) {
+			vec3 c = sphere.center + offset;
+			vec3 closest(std::max(aabb.min.x, std::min(c.x, aabb.max.x)),
+			             std::max(aabb.min.y, std::min(c.y, aabb.max.y)),
+			             std::max(aabb.min.z, std::min(c.z, aabb.max.z)));
+			double distance = SphereSeparation(sphere, offset, closest, normal);
+
+			// The center is inside the box, it's already hit along the way it came in.
+			if(normal == vec3(0))
+				normal = Normalized(motion);
+			return distance;
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Triangle& triangle, double tolerance)
+	{
+		return FindTimeOfImpact(sphere, motion, triangle, tolerance, 1);
+	}
+
+	TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Sphere& target, double tolerance)
+	{
+		return ConservativeAdvancement(motion, tolerance, 1, [&](vec3 offset, vec3& normal) {
+			double distance = SphereSeparation(sphere, offset, target.center, normal) - target.radius;
+			if(normal == vec3(0))
+				normal = Normalized(motion);
+			return distance;
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Plane& plane, double tolerance)
+	{
+		return ConservativeAdvancement(motion, tolerance, 1, [&](vec3 offset, vec3& normal) {
+			normal = -plane.normal;
+			return Dot(Support(box, -plane.normal) + offset, plane.normal) - plane.offset;
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const AABB& aabb, double tolerance)
+	{
+		return ConservativeAdvancement(motion, tolerance, 1, [&](vec3 offset, vec3& normal) {
+			// The gap along every axis the boxes don't overlap on, signed towards the target. If they
+			// overlap on every axis, the axis they overlap the least on instead.
+			const double aMin[3] = { box.min.x + offset.x, box.min.y + offset.y, box.min.z + offset.z };
+			const double aMax[3] = { box.max.x + offset.x, box.max.y + offset.y, box.max.z + offset.z };
+			const double bMin[3] = { aabb.min.x, aabb.min.y, aabb.min.z }, bMax[3] = { aabb.max.x, aabb.max.y, aabb.max.z };
+			double gap[3], least[3] = { 0, 0, 0 };
+			double deepest = -std::numeric_limits<double>::infinity();
+			for(int i = 0; i < 3; i++) {
+				double ahead = bMin[i] - aMax[i], behind = aMin[i] - bMax[i];
+				gap[i] = ahead > 0 ? ahead : (behind > 0 ? -behind : 0);
+				if(std::max(ahead, behind) > deepest) {
+					deepest = std::max(ahead, behind);
+					least[0] = least[1] = least[2] = 0;
+					least[i] = ahead > behind ? 1 : -1;
+				}
+			}
+
+			vec3 g(gap[0], gap[1], gap[2]);
+			double length = Length(g);
+			if(length == 0) {
+				normal = vec3(least[0], least[1], least[2]);
+				return deepest;
+			}
+			normal = g / length;
+			return length;
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Triangle& triangle, double tolerance)
+	{
+		return FindTimeOfImpact(box, motion, triangle, tolerance, 1);
+	}
+
+	TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Sphere& target, double tolerance)
+	{
+		// Same as the sphere moving the other way, seen from the sphere.
+		TimeOfImpact res = FindTimeOfImpact(target, -motion, box, tolerance);
+		res.normal = -res.normal;
+		return res;
+	}
+
+	/// Runs @p test on every triangle of the mesh in @p box's sweep, keeping the earliest hit. The sweep
+	/// is cut short at the earliest hit so far, which prunes the triangles that are further away.
+	template <typename Test>
+	static TimeOfImpact FindEarliestTriangle(const TriangleMesh& mesh, const AABB& box, vec3 motion, double tolerance, Test test)
+	{
+		TimeOfImpact best;
+		const vec3 margin(tolerance);
+		mesh.GetBVH().traverse(
+		    [&](const AABB& node) {
+			    AABB swept = SweptAABB(box, motion * best.time);
+			    return node.Overlaps(AABB(swept.min - margin, swept.max + margin));
+		    },
+		    [&](std::uint32_t first, std::uint32_t count) {
+			    for(std::uint32_t i = first; i < first + count; i++) {
+				    TimeOfImpact hit = test(mesh.Triangles[i], best.time);
+				    if(hit && (!best || hit.time < best.time)) {
+					    best = hit;
+					    best.triangle = i;
+				    }
+			    }
+		    });
+		return best;
+	}
+
+	TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const TriangleMesh& mesh, double tolerance)
+	{
+		AABB box(sphere.center - vec3(sphere.radius), sphere.center + vec3(sphere.radius));
+		return FindEarliestTriangle(mesh, box, motion, tolerance, [&](const Triangle& triangle, double maxTime) {
+			return FindTimeOfImpact(sphere, motion, triangle, tolerance, maxTime);
+		});
+	}
+
+	TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const TriangleMesh& mesh, double tolerance)
+	{
+		return FindEarliestTriangle(mesh, box, motion, tolerance, [&](const Triangle& triangle, double maxTime) {
+			return FindTimeOfImpact(box, motion, triangle, tolerance, maxTime);
+		});
+	}
+} // namespace SWAN
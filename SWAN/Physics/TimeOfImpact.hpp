@@ -0,0 +1,67 @@
+#ifndef SWAN_PHYS_TIME_OF_IMPACT_HPP
+#define SWAN_PHYS_TIME_OF_IMPACT_HPP
+
+#include <cstdint> // For std::uint32_t
+
+#include "Basic.hpp"        // For SWAN::AABB, SWAN::Plane, SWAN::Sphere, SWAN::Triangle
+#include "Maths/Vector.hpp" // For SWAN::vec3
+#include "TriangleMesh.hpp" // For SWAN::TriangleMesh
+
+namespace SWAN
+{
+	/// When a moving shape first touches a static one, as a fraction of its motion.
+	struct TimeOfImpact {
+		/// Whether the shapes touch at all during the motion.
+		bool happened = false;
+		operator bool() const { return happened; }
+
+		/// Fraction of the motion, from 0 to 1, covered before the shapes touch.
+		double time = 1;
+
+		/// Points from the moving shape to the static one, at the time of impact.
+		vec3 normal;
+
+		/// Triangle that was hit, for meshes.
+		std::uint32_t triangle = 0;
+	};
+
+	/// How close the shapes are left at the time of impact. Stopping short of touching
+	/// keeps the next step's contact from starting out overlapped.
+	constexpr double DefaultTOITolerance = 1e-3;
+
+	/// The box a box covers while moving by @p motion.
+	inline AABB SweptAABB(const AABB& box, vec3 motion)
+	{
+		return box.Merged(AABB(box.min + motion, box.max + motion));
+	}
+
+	/// The box a sphere covers while moving by @p motion.
+	inline AABB SweptAABB(const Sphere& sphere, vec3 motion)
+	{
+		return SweptAABB(AABB(sphere.center - vec3(sphere.radius), sphere.center + vec3(sphere.radius)), motion);
+	}
+
+	/**
+	 * @brief Finds when a shape moving by @p motion first comes within @p tolerance of a static one.
+	 *
+	 * Uses conservative advancement: the shape is repeatedly moved forward by its distance to the
+	 * target divided by how fast it closes in, which never passes the first contact. Shapes that
+	 * already touch count as a hit at time 0, unless they aren't closing in (moving apart, sliding
+	 * along each other, or not moving at all). The solid side of a plane is behind it, and
+	 * triangles are two-sided.
+	 */
+	extern TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Plane& plane, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const AABB& aabb, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Triangle& triangle, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const Sphere& target, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Plane& plane, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const AABB& aabb, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Triangle& triangle, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const Sphere& target, double tolerance = DefaultTOITolerance);
+
+	/// Finds the first triangle of the mesh the shape hits, only testing the triangles in its swept box.
+	extern TimeOfImpact FindTimeOfImpact(const Sphere& sphere, vec3 motion, const TriangleMesh& mesh, double tolerance = DefaultTOITolerance);
+	extern TimeOfImpact FindTimeOfImpact(const AABB& box, vec3 motion, const TriangleMesh& mesh, double tolerance = DefaultTOITolerance);
+} // namespace SWAN
+
+#endif
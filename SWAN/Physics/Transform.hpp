@@ -1,7 +1,9 @@
 #ifndef SWAN_TRANSFORM_HPP
 #define SWAN_TRANSFORM_HPP
 
+#include "Maths/Affine.hpp"
 #include "Maths/Matrix.hpp"
+#include "Maths/Quaternion.hpp"
 #include "Maths/Vector.hpp"
 
 namespace SWAN
@@ -30,41 +32,71 @@ namespace SWAN
 		}
 
 		/// Calculate a Model matrix.
-		mat4 getModel() const
-		{
-			mat4 posMat = getPosMat();
-			mat4 scaleMat = getScaleMat();
-			mat4 rotMat = getRotMat();
-			mat4 parentMat = (parent == NULL ? mat4() : parent->getModel());
+		inline mat4 getModel() const { return ToMat4(getModelAffine()); }
 
-			return parentMat * posMat * rotMat * scaleMat;
+		/// Calculate a Model matrix, without the implicit (0, 0, 0, 1) last row.
+		affine3x4 getModelAffine() const
+		{
+			affine3x4 local = getLocalAffine();
+			return parent == NULL ? local : parent->getModelAffine() * local;
 		}
 
+		/// Calculate the Model matrix relative to the parent, i.e. position * rotation * scale.
+		inline affine3x4 getLocalAffine() const { return ComposeAffine(pos, getRotMat(), scale); }
+
 		/// Get an inverse of the Model matrix.
-		inline mat4 getModel_inv() const { return Inverse(getModel()); }
+		inline mat4 getModel_inv() const { return ToMat4(Inverse(getModelAffine())); }
 
 		/// Calculate a position matrix.
 		inline mat4 getPosMat() const { return Translate(pos); }
 
-		/// Calculate a rotation matrix. @note The rotation is in the order Z * X * Y.
+		/**
+		 * @brief Calculate a rotation matrix.
+		 *
+		 * @note Euler angles are applied in the order Y * X * Z.
+		 *       The result is cached until the rotation changes.
+		 */
 		inline mat4 getRotMat() const
 		{
-			mat4 rX = Rotate(rot.x, vec3(1, 0, 0));
-			mat4 rY = Rotate(rot.y, vec3(0, 1, 0));
-			mat4 rZ = Rotate(rot.z, vec3(0, 0, 1));
+			quat q = getRotQuat();
+			if(q.x != cachedRotQuat.x || q.y != cachedRotQuat.y || q.z != cachedRotQuat.z || q.w != cachedRotQuat.w) {
+				cachedRotQuat = q;
+				cachedRotMat = ToMat4(q);
+			}
+			return cachedRotMat;
+		}
+
+		/// Get the rotation as a quaternion, converting from the Euler angles if needed.
+		inline quat getRotQuat() const
+		{
+			if(useRotQuat)
+				return rotQuat;
+
+			if(rot != cachedEuler) {
+				cachedEuler = rot;
+				cachedEulerQuat = quat::FromEuler(rot);
+			}
+			return cachedEulerQuat;
+		}
 
-			//return rZ * rX * rY;
-			return rY * rX * rZ;
+		/// Store the rotation as a quaternion from now on. The Euler angles in rot are ignored afterwards.
+		inline void setRotQuat(quat q)
+		{
+			rotQuat = Normalized(q);
+			useRotQuat = true;
 		}
 
+		/// Apply an additional rotation on top of the current one.
+		inline void rotate(quat q) { setRotQuat(q * getRotQuat()); }
+
 		/// Calculate a scale matrix.
 		inline mat4 getScaleMat() const { return Scale(scale); }
 
 		/// Get the forward direction for this transform.
-		vec3 getForw() const { return vec4(0, 0, 1, 0) * Transpose(getModel()); }
+		vec3 getForw() const { return getModelColumn(2); }
 
 		/// Get the upward direction for this transform.
-		vec3 getUp() const { return vec4(0, 1, 0, 0) * Transpose(getModel()); }
+		vec3 getUp() const { return getModelColumn(1); }
 
 		/// Get the right direction for this transform.
 		vec3 getRight() const { return Cross(getUp(), getForw()); }
@@ -76,11 +108,25 @@ namespace SWAN
 		/// Scale.
 		vec3 scale;
 
+		/// Rotation, used instead of rot when useRotQuat is set.
+		quat rotQuat;
+		/// Whether the rotation is stored in rotQuat instead of rot.
+		bool useRotQuat = false;
+
 		bool lookingAt = false;
 		vec3 lookAtV;
 
 		/// Parent transform.
 		Transform* parent;
+
+	  private:
+		/// Get the i-th column of the Model matrix, i.e. where the i-th axis points to.
+		inline vec3 getModelColumn(int i) const { return getModelAffine().column(i); }
+
+		mutable vec3 cachedEuler;
+		mutable quat cachedEulerQuat;
+		mutable quat cachedRotQuat;
+		mutable mat4 cachedRotMat;
 	};
 } // namespace SWAN
 
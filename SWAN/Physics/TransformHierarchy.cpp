@@ -0,0 +1,236 @@
+#include "TransformHierarchy.hpp"
+
+#include <algorithm> // For std::fill()
+
+namespace SWAN
+{
+	constexpr TransformHierarchy::NodeID TransformHierarchy::None;
+
+	/// Translate(pos) * ToMat4(rot) * Scale(scale), without the two matrix products.
+	static mat4 ComposeLocal(vec3 pos, quat rot, vec3 scale)
+	{
+		mat4 m = ToMat4(rot);
+		for(int y = 0; y < 3; y++) {
+			m(0, y) *= scale.x;
+			m(1, y) *= scale.y;
+			m(2, y) *= scale.z;
+		}
+		m(3, 0) = pos.x;
+		m(3, 1) = pos.y;
+		m(3, 2) = pos.z;
+		return m;
+	}
+
+	TransformHierarchy::NodeID TransformHierarchy::add(vec3 p, quat r, vec3 s, NodeID parent)
+	{
+		NodeID id;
+		if(freeIDs.empty()) {
+			id = slot.size();
+			slot.push_back(None);
+			parentID.push_back(None);
+		} else {
+			id = freeIDs.back();
+			freeIDs.pop_back();
+		}
+
+		if(parent != None && !exists(parent))
+			parent = None;
+
+		// Appending keeps the order valid, since the parent is already somewhere before the end.
+		slot[id] = order.size();
+		parentID[id] = parent;
+
+		order.push_back(id);
+		parentSlot.push_back(parent == None ? None : slot[parent]);
+		pos.push_back(p);
+		rot.push_back(r);
+		scale.push_back(s);
+		local.push_back(mat4());
+		world.push_back(mat4());
+		dirty.push_back(1);
+
+		return id;
+	}
+
+	void TransformHierarchy::remove(NodeID node)
+	{
+		if(!exists(node))
+			return;
+
+		if(orderDirty)
+			rebuildOrder();
+
+		// Descendants come after the node, so one pass over the rest of the array finds all of them.
+		std::uint32_t first = slot[node];
+		Vector<std::uint8_t> removed(order.size() - first, 0);
+		removed[0] = 1;
+		for(std::uint32_t i = first + 1; i < order.size(); i++) {
+			std::uint32_t p = parentSlot[i];
+			if(p != None && p >= first && removed[p - first])
+				removed[i - first] = 1;
+		}
+
+		// Compact the arrays. Relative order is kept, so parents still come first.
+		std::uint32_t out = first;
+		for(std::uint32_t i = first; i < order.size(); i++) {
+			NodeID id = order[i];
+			if(removed[i - first]) {
+				slot[id] = None;
+				parentID[id] = None;
+				freeIDs.push_back(id);
+				continue;
+			}
+
+			order[out] = id;
+			pos[out] = pos[i];
+			rot[out] = rot[i];
+			scale[out] = scale[i];
+			local[out] = local[i];
+			world[out] = world[i];
+			dirty[out] = dirty[i];
+			slot[id] = out;
+			out++;
+		}
+
+		order.resize(out);
+		parentSlot.resize(out);
+		pos.resize(out);
+		rot.resize(out);
+		scale.resize(out);
+		local.resize(out);
+		world.resize(out);
+		dirty.resize(out);
+
+		for(std::uint32_t i = first; i < out; i++) {
+			NodeID p = parentID[order[i]];
+			parentSlot[i] = p == None ? None : slot[p];
+		}
+	}
+
+	void TransformHierarchy::setParent(NodeID node, NodeID parent)
+	{
+		if(!exists(node) || (parent != None && !exists(parent)))
+			return;
+
+		// Refuse to create a cycle.
+		for(NodeID p = parent; p != None; p = parentID[p])
+			if(p == node)
+				return;
+
+		parentID[node] = parent;
+		dirty[slot[node]] = 1;
+
+		// If the parent already comes first, the order stays valid.
+		if(parent == None || slot[parent] < slot[node])
+			parentSlot[slot[node]] = parent == None ? None : slot[parent];
+		else
+			orderDirty = true;
+	}
+
+	TransformHierarchy::NodeID TransformHierarchy::getParent(NodeID node) const
+	{
+		return exists(node) ? parentID[node] : None;
+	}
+
+	bool TransformHierarchy::exists(NodeID node) const
+	{
+		return node < slot.size() && slot[node] != None;
+	}
+
+	void TransformHierarchy::setPos(NodeID node, vec3 p)
+	{
+		pos[slot[node]] = p;
+		markDirty(node);
+	}
+	void TransformHierarchy::setRot(NodeID node, quat r)
+	{
+		rot[slot[node]] = r;
+		markDirty(node);
+	}
+	void TransformHierarchy::setScale(NodeID node, vec3 s)
+	{
+		scale[slot[node]] = s;
+		markDirty(node);
+	}
+
+	vec3 TransformHierarchy::getPos(NodeID node) const { return pos[slot[node]]; }
+	quat TransformHierarchy::getRot(NodeID node) const { return rot[slot[node]]; }
+	vec3 TransformHierarchy::getScale(NodeID node) const { return scale[slot[node]]; }
+
+	const mat4& TransformHierarchy::getWorld(NodeID node) const { return world[slot[node]]; }
+	const mat4& TransformHierarchy::getLocal(NodeID node) const { return local[slot[node]]; }
+
+	void TransformHierarchy::update()
+	{
+		if(orderDirty)
+			rebuildOrder();
+
+		unsigned count = 0;
+		for(std::uint32_t i = 0; i < order.size(); i++) {
+			std::uint32_t p = parentSlot[i];
+
+			// A node whose parent changed in this sweep has to be updated too.
+			if(p != None)
+				dirty[i] |= dirty[p] & 2;
+
+			if(!dirty[i])
+				continue;
+
+			if(dirty[i] & 1)
+				local[i] = ComposeLocal(pos[i], rot[i], scale[i]);
+
+			world[i] = p == None ? local[i] : world[p] * local[i];
+
+			// Bit 2 means "the world matrix changed", children look at it.
+			dirty[i] = 2;
+			count++;
+		}
+
+		std::fill(dirty.begin(), dirty.end(), 0);
+		lastUpdateCount = count;
+	}
+
+	void TransformHierarchy::rebuildOrder()
+	{
+		std::uint32_t n = order.size();
+
+		// Breadth-first walk from the roots gives a parent-before-child order.
+		Vector<Vector<std::uint32_t>> children(n);
+		Vector<std::uint32_t> newOrder;
+		newOrder.reserve(n);
+		for(std::uint32_t i = 0; i < n; i++) {
+			NodeID p = parentID[order[i]];
+			if(p == None)
+				newOrder.push_back(i);
+			else
+				children[slot[p]].push_back(i);
+		}
+		for(std::uint32_t head = 0; head < newOrder.size(); head++)
+			for(std::uint32_t c : children[newOrder[head]])
+				newOrder.push_back(c);
+
+		Vector<NodeID> oldOrder(order);
+		Vector<vec3> oldPos(pos), oldScale(scale);
+		Vector<quat> oldRot(rot);
+		Vector<mat4> oldLocal(local), oldWorld(world);
+		Vector<std::uint8_t> oldDirty(dirty);
+
+		for(std::uint32_t i = 0; i < n; i++) {
+			std::uint32_t from = newOrder[i];
+			order[i] = oldOrder[from];
+			pos[i] = oldPos[from];
+			rot[i] = oldRot[from];
+			scale[i] = oldScale[from];
+			local[i] = oldLocal[from];
+			world[i] = oldWorld[from];
+			dirty[i] = oldDirty[from];
+			slot[order[i]] = i;
+		}
+		for(std::uint32_t i = 0; i < n; i++) {
+			NodeID p = parentID[order[i]];
+			parentSlot[i] = p == None ? None : slot[p];
+		}
+
+		orderDirty = false;
+	}
+} // namespace SWAN
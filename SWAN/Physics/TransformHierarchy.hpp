@@ -0,0 +1,96 @@
+#ifndef SWAN_TRANSFORM_HIERARCHY_HPP
+#define SWAN_TRANSFORM_HIERARCHY_HPP
+
+#include <cstdint> // For std::uint8_t, std::uint32_t
+
+#include "Core/Defs.hpp"        // For SWAN::Vector<T>
+#include "Maths/Matrix.hpp"     // For SWAN::mat4
+#include "Maths/Quaternion.hpp" // For SWAN::quat
+#include "Maths/Vector.hpp"     // For SWAN::vec3
+
+namespace SWAN
+{
+	/**
+	 * @brief A flattened hierarchy of transforms with cached local and world matrices.
+	 *
+	 * Nodes are kept in an array where every parent comes before its children,
+	 * so update() recalculates all world matrices in a single forward sweep.
+	 * Only nodes that were changed (and their descendants) are recalculated.
+	 *
+	 * Nodes are referred to with stable IDs, their position in the array may
+	 * change whenever the structure of the hierarchy changes.
+	 */
+	class TransformHierarchy
+	{
+	  public:
+		using NodeID = std::uint32_t;
+
+		/// ID of a node that doesn't exist. Used as the parent of root nodes.
+		static constexpr NodeID None = ~NodeID(0);
+
+		/// Add a node. The parent must already exist (or be None).
+		NodeID add(vec3 pos = vec3(0), quat rot = quat(), vec3 scale = vec3(1), NodeID parent = None);
+
+		/// Remove a node together with all of its descendants.
+		void remove(NodeID node);
+
+		/// Change the parent of a node. Does nothing if that would create a cycle.
+		void setParent(NodeID node, NodeID parent);
+
+		/// Get the parent of a node (None for root nodes).
+		NodeID getParent(NodeID node) const;
+
+		/// Whether a node with that ID exists.
+		bool exists(NodeID node) const;
+
+		/// Number of live nodes.
+		inline unsigned size() const { return order.size(); }
+
+		void setPos(NodeID node, vec3 pos);
+		void setRot(NodeID node, quat rot);
+		void setScale(NodeID node, vec3 scale);
+
+		vec3 getPos(NodeID node) const;
+		quat getRot(NodeID node) const;
+		vec3 getScale(NodeID node) const;
+
+		/// Recalculate the local and world matrices of every changed node and its descendants.
+		void update();
+
+		/// Get the world matrix of a node as of the last update().
+		const mat4& getWorld(NodeID node) const;
+
+		/// Get the local matrix of a node as of the last update().
+		const mat4& getLocal(NodeID node) const;
+
+		/// Number of world matrices recalculated by the last update().
+		inline unsigned getLastUpdateCount() const { return lastUpdateCount; }
+
+	  private:
+		/// Sorts the arrays so that parents come before children again.
+		void rebuildOrder();
+		inline void markDirty(NodeID node) { dirty[slot[node]] = 1; }
+
+		// ----- Per-node data, in sweep order ----- //
+		/// ID of the node at each position.
+		Vector<NodeID> order;
+		/// Position of each node's parent, or None.
+		Vector<std::uint32_t> parentSlot;
+		Vector<vec3> pos, scale;
+		Vector<quat> rot;
+		Vector<mat4> local, world;
+		Vector<std::uint8_t> dirty;
+
+		// ----- Per-ID data ----- //
+		/// Position of each ID in the arrays above, or None if the ID is free.
+		Vector<std::uint32_t> slot;
+		/// Parent of each ID.
+		Vector<NodeID> parentID;
+		Vector<NodeID> freeIDs;
+
+		bool orderDirty = false;
+		unsigned lastUpdateCount = 0;
+	};
+} // namespace SWAN
+
+#endif
@@ -2,32 +2,112 @@
 
 namespace SWAN
 {
-	AABB TriangleMesh::GetAABB() const
+	void TriangleMesh::Build()
 	{
-		SWAN::vec3 min(0, 0, 0), max(0, 0, 0);
+		BVH.build(Triangles);
+	}
 
-		for(const auto& t : Triangles) {
-			for(const auto& v : t.points) {
-				min.x = std::min<double>(v.x, min.x);
-				min.y = std::min<double>(v.y, min.y);
-				min.z = std::min<double>(v.z, min.z);
+	bool TriangleMesh::Raycast(const Ray& ray, double maxDistance, double* t, std::uint32_t* triangle) const
+	{
+		std::uint32_t best = RayPacket::None;
+		double closest = maxDistance;
+		BVH.traverse(ray, closest, [&](std::uint32_t first, std::uint32_t count, double& tMax) {
+			for(std::uint32_t i = first; i < first + count; i++) {
+				Intersection hit = FindIntersection(Triangles[i], ray);
+				if(!hit)
+					continue;
 
-				max.x = std::max<double>(v.x, max.x);
-				max.y = std::max<double>(v.y, max.y);
-				max.z = std::max<double>(v.z, max.z);
+				// The direction is normalized, so this is the distance along the ray.
+				double d = Dot(hit.point - ray.start, ray.dir);
+				if(d < tMax) {
+					tMax = d;
+					best = i;
+				}
 			}
-		}
+		});
 
-		AABB res;
-		res.min = min;
-		res.max = max;
-		return res;
+		if(best == RayPacket::None)
+			return false;
+		if(t)
+			*t = closest;
+		if(triangle)
+			*triangle = best;
+		return true;
 	}
 
-	Intersection FindIntersection(TriangleMesh a, TriangleMesh b)
+	void TriangleMesh::Raycast(RayPacket& rays) const
 	{
-		if(!FindIntersection(a.GetAABB(), b.GetAABB())) {
+		// Nodes are culled against every ray's current closest hit.
+		BVH.traverse([&](const AABB& node) { return IntersectAABB(rays, node) != 0; },
+		             [&](std::uint32_t first, std::uint32_t count) {
+			             IntersectTriangles(rays, &Triangles[first], count, first);
+		             });
+	}
+
+	Intersection FindIntersection(const TriangleMesh& mesh, Ray ray)
+	{
+		double t;
+		if(!mesh.Raycast(ray, std::numeric_limits<double>::infinity(), &t))
 			return Intersection();
-		}
+
+		Intersection res;
+		res.happened = true;
+		res.point = ray.start + ray.dir * t;
+		res.type = Intersection::Type::Point;
+		return res;
+	}
+
+	Intersection FindIntersection(const TriangleMesh& mesh, AABB aabb)
+	{
+		Intersection res;
+		mesh.GetBVH().traverse([&](const AABB& node) { return !res.happened && node.Overlaps(aabb); },
+		                       [&](std::uint32_t first, std::uint32_t count) {
+			                       for(std::uint32_t i = first; i < first + count && !res.happened; i++)
+				                       res = FindIntersection(mesh.Triangles[i], aabb);
+		                       });
+		return res;
+	}
+
+	Intersection FindIntersection(const TriangleMesh& mesh, Sphere sphere)
+	{
+		double r2 = (double) sphere.radius * sphere.radius;
+
+		Intersection res;
+		mesh.GetBVH().traverse([&](const AABB& node) { return !res.happened && node.DistanceSquared(sphere.center) <= r2; },
+		                       [&](std::uint32_t first, std::uint32_t count) {
+			                       for(std::uint32_t i = first; i < first + count && !res.happened; i++)
+				                       res = FindIntersection(mesh.Triangles[i], sphere);
+		                       });
+		return res;
+	}
+
+	Intersection FindIntersection(const TriangleMesh& a, const TriangleMesh& b)
+	{
+		Intersection res;
+		a.GetBVH().traverse(b.GetBVH(), [&](std::uint32_t firstA, std::uint32_t countA, std::uint32_t firstB, std::uint32_t countB) {
+			for(std::uint32_t i = firstA; i < firstA + countA; i++) {
+				// Cheap box test first, most pairs of triangles in overlapping leaves are apart.
+				const Triangle& ta = a.Triangles[i];
+				AABB boxA(ta.points[0], ta.points[0]);
+				for(const vec3& p : ta.points)
+					boxA = boxA.Merged(AABB(p, p));
+
+				for(std::uint32_t j = firstB; j < firstB + countB; j++) {
+					const Triangle& tb = b.Triangles[j];
+					AABB boxB(tb.points[0], tb.points[0]);
+					for(const vec3& p : tb.points)
+						boxB = boxB.Merged(AABB(p, p));
+
+					if(!boxA.Overlaps(boxB))
+						continue;
+
+					res = FindIntersection(ta, tb);
+					if(res)
+						return true;
+				}
+			}
+			return false;
+		});
+		return res;
 	}
 } // namespace SWAN
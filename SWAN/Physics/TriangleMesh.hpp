@@ -1,19 +1,86 @@
 #ifndef SWAN_PHYS_TRIANGLE_MESH_HPP
 #define SWAN_PHYS_TRIANGLE_MESH_HPP
 
+#include <cstdint> // For std::uint32_t
+#include <utility> // For std::move()
+
 #include "Basic.hpp"
+#include "MeshBVH.hpp"
+#include "RayPacket.hpp"
 
 #include "Core/Defs.hpp"
 #include "Maths/Vector.hpp"
 
 namespace SWAN
 {
+	/**
+	 * @brief Static collision mesh with a bounding volume hierarchy.
+	 *
+	 * Build() has to be called after changing Triangles, it recalculates the box and the
+	 * hierarchy, and reorders Triangles so that nearby triangles are next to each other.
+	 */
 	struct TriangleMesh {
+		TriangleMesh() {}
+		explicit TriangleMesh(Vector<Triangle> triangles) : Triangles(std::move(triangles)) { Build(); }
+
 		Vector<Triangle> Triangles;
-		AABB GetAABB() const;
+
+		/// Rebuilds the hierarchy. Reorders Triangles.
+		void Build();
+
+		/// Box around every triangle, as of the last Build().
+		inline AABB GetAABB() const { return BVH.getBounds(); }
+
+		inline const MeshBVH& GetBVH() const { return BVH; }
+
+		/**
+		 * @brief Finds the closest triangle hit by a ray.
+		 *
+		 * @param t Set to the distance to the hit, if there is one.
+		 * @param triangle Set to the index of the triangle that was hit, if there is one.
+		 */
+		bool Raycast(const Ray& ray, double maxDistance, double* t = nullptr, std::uint32_t* triangle = nullptr) const;
+
+		/// Finds the closest triangle hit by every ray of a packet. See IntersectTriangles().
+		void Raycast(RayPacket& rays) const;
+
+		/// Call @p callback with the index of every triangle that overlaps @p box.
+		template <typename Callback>
+		void Query(const AABB& box, Callback callback) const
+		{
+			BVH.traverse([&](const AABB& node) { return node.Overlaps(box); },
+			             [&](std::uint32_t first, std::uint32_t count) {
+				             for(std::uint32_t i = first; i < first + count; i++)
+					             if(FindIntersection(Triangles[i], box))
+						             callback(i);
+			             });
+		}
+
+		/// Call @p callback with the index of every triangle that overlaps @p sphere.
+		template <typename Callback>
+		void Query(const Sphere& sphere, Callback callback) const
+		{
+			double r2 = (double) sphere.radius * sphere.radius;
+			BVH.traverse([&](const AABB& node) { return node.DistanceSquared(sphere.center) <= r2; },
+			             [&](std::uint32_t first, std::uint32_t count) {
+				             for(std::uint32_t i = first; i < first + count; i++)
+					             if(FindIntersection(Triangles[i], sphere))
+						             callback(i);
+			             });
+		}
+
+	  private:
+		MeshBVH BVH;
 	};
 
-	extern Intersection FindIntersection(TriangleMesh a, TriangleMesh b);
+	/// Finds the closest point where a ray hits the mesh.
+	extern Intersection FindIntersection(const TriangleMesh& mesh, Ray ray);
+	/// Finds a point where a triangle of the mesh overlaps the box.
+	extern Intersection FindIntersection(const TriangleMesh& mesh, AABB aabb);
+	/// Finds a point where a triangle of the mesh overlaps the sphere.
+	extern Intersection FindIntersection(const TriangleMesh& mesh, Sphere sphere);
+	/// Finds a point where the two meshes cross, walking both hierarchies together.
+	extern Intersection FindIntersection(const TriangleMesh& a, const TriangleMesh& b);
 } // namespace SWAN
 
 #endif
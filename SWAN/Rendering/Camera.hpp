@@ -2,6 +2,7 @@
 #define SWAN_CAMERA_HPP
 
 #include "Core/Display.hpp"       // For Display::GetWidth(), Display::GetHeight()
+#include "Maths/Affine.hpp"       // For affine3x4
 #include "Maths/Vector.hpp"       // For vec2
 #include "Physics/Transform.hpp"  // For Transform
 #include "Utility/AngleUnits.hpp" // For SWAN::Util::Radians
@@ -40,11 +41,15 @@ namespace SWAN
 		inline vec3 right() const { return transform.getRight(); }
 
 		/// Calculate the view matrix for the camera.
-		inline mat4 getView() const
+		inline mat4 getView() const { return ToMat4(getViewAffine()); }
+
+		/// Calculate the view matrix for the camera, without the implicit (0, 0, 0, 1) last row.
+		inline affine3x4 getViewAffine() const
 		{
-			vec3 realPos = vec4(pos(), 1) //* Transpose(transform.getModel());
-			    ;
-			return LookAt(realPos, realPos + forw(), up());
+			// One Model matrix for both directions, instead of one for forw() and one for up().
+			affine3x4 model = transform.getModelAffine();
+			vec3 realPos = pos();
+			return LookAtAffine(realPos, realPos + model.column(2), model.column(1));
 		}
 
 		/// Get the perspective matrix for the camera.
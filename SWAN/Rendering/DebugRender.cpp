@@ -1,9 +1,14 @@
 #include "DebugRender.hpp"
 #include "../OpenGL/OnGLInit.hpp"
+#include "../OpenGL/StreamBuffer.hpp"
 #include "../Utility/CxArray.hpp"
+#include "FrameUniforms.hpp"
+
+#include <cmath>  // For std::sin(), std::cos()
+#include <math.h> // For M_PI
 
 static const char* const unlitFrag = R"glsl(
-#version 130
+#version 140
 
 out vec4 fCol;
 
@@ -15,43 +20,119 @@ void main() {
 )glsl";
 
 static const char* const unlitVert = R"glsl(
-#version 130
-
+#version 140
+)glsl" SWAN_FRAME_BLOCK_GLSL R"glsl(
 in vec3 pos;
 
-uniform mat4 perspective;
-uniform mat4 view;
 uniform mat4 transform;
 
 void main() {
-    gl_Position = perspective * view * transform * vec4(pos, 1);
+    gl_Position = projection * view * transform * vec4(pos, 1);
     gl_PointSize = 20;
 }
 )glsl";
 
+// Cubes and spheres drawn in batches: the model matrix (as the 3 rows of an affine3x4)
+// and color of every instance come from attributes that advance once per instance.
+static const char* const instancedVert = R"glsl(
+#version 140
+)glsl" SWAN_FRAME_BLOCK_GLSL R"glsl(
+in vec3 pos;
+in vec4 row0;
+in vec4 row1;
+in vec4 row2;
+in vec4 instanceColor;
+
+out vec4 vCol;
+
+void main() {
+    vec4 p = vec4(pos, 1);
+    gl_Position = projection * view * vec4(dot(row0, p), dot(row1, p), dot(row2, p), 1);
+    vCol = instanceColor;
+}
+)glsl";
+
+// Lines and triangles drawn in batches, already in world space, with a color per vertex.
+static const char* const vertexColorVert = R"glsl(
+#version 140
+)glsl" SWAN_FRAME_BLOCK_GLSL R"glsl(
+in vec3 pos;
+in vec4 vertexColor;
+
+out vec4 vCol;
+
+void main() {
+    gl_Position = projection * view * vec4(pos, 1);
+    vCol = vertexColor;
+}
+)glsl";
+
+static const char* const varyingColorFrag = R"glsl(
+#version 140
+
+in vec4 vCol;
+
+out vec4 fCol;
+
+void main() {
+	fCol = vCol;
+}
+)glsl";
+
 namespace SWAN
 {
 	static Shader basicShad;
+	static Shader instancedShad;
+	static Shader vertexColorShad;
+
+	/// Uniforms of the shaders, found once at startup.
+	static Shader::Uniform basicColor, basicTransform;
 	static GL::VAO cubeVAO;
 	static GL::VAO lineVAO;
 	static GL::VAO linesVAO;
 	static GL::VAO triVAO;
 	static GL::VAO trisVAO;
+	static GL::VAO sphereVAO;
+
+	/// Slices and stacks of the sphere mesh.
+	static constexpr unsigned sphereDetail = 16;
+	static constexpr unsigned sphereIndexCount = sphereDetail * sphereDetail * 6;
+
+	/// Per-instance records for the batched draws, reused between calls so they don't allocate every frame.
+	static std::vector<float> instanceData;
+	static std::vector<fvec3> batchPositions;
+	static std::vector<fvec4> batchColors;
 
 	static OnGLInit _ = {
 		[] {
 		    basicShad.compileShadersFromSrc(unlitVert, unlitFrag);
 		    basicShad.addAttrib("pos");
 		    basicShad.linkShaders();
+		    basicShad.bindUniformBlock("Frame", UniformBlockBinding::Frame);
 
 		    basicShad.use();
-		    basicShad.addUniform("color");
-		    basicShad.addUniform("perspective");
-		    basicShad.addUniform("view");
-		    basicShad.addUniform("transform");
+		    basicColor = basicShad.addUniform("color");
+		    basicTransform = basicShad.addUniform("transform");
 		    // basicShad.unuse();
 		},
 
+		[] {
+		    instancedShad.compileShadersFromSrc(instancedVert, varyingColorFrag);
+		    instancedShad.addAttrib("pos");
+		    instancedShad.addAttrib("row0");
+		    instancedShad.addAttrib("row1");
+		    instancedShad.addAttrib("row2");
+		    instancedShad.addAttrib("instanceColor");
+		    instancedShad.linkShaders();
+		    instancedShad.bindUniformBlock("Frame", UniformBlockBinding::Frame);
+
+		    vertexColorShad.compileShadersFromSrc(vertexColorVert, varyingColorFrag);
+		    vertexColorShad.addAttrib("pos");
+		    vertexColorShad.addAttrib("vertexColor");
+		    vertexColorShad.linkShaders();
+		    vertexColorShad.bindUniformBlock("Frame", UniformBlockBinding::Frame);
+		},
+
 		[] {
 		    const Util::CxArray<fvec3, 8> pos({
 		        /* 4 */ fvec3(-1, -1, -1),
@@ -98,33 +179,127 @@ namespace SWAN
 		          0, 4, 6 });
 
 		    cubeVAO.bind();
-		    cubeVAO.storeAttribData(0, 3, (float*) pos.data(), pos.size() * sizeof(vec3), GL_STATIC_DRAW);
+		    cubeVAO.storeAttribData(0, 3, (float*) pos.data(), pos.size() * sizeof(fvec3), GL_STATIC_DRAW);
 		    cubeVAO.storeIndices(inds.data(), inds.size() * sizeof(unsigned), GL_STATIC_DRAW);
 		    cubeVAO.unbind();
 		},
+
+		[] {
+		    // Unit sphere, wound the same way as the cube.
+		    std::vector<fvec3> pos;
+		    for(unsigned i = 0; i <= sphereDetail; i++) {
+			    float theta = M_PI * i / sphereDetail;
+			    for(unsigned j = 0; j <= sphereDetail; j++) {
+				    float phi = 2 * M_PI * j / sphereDetail;
+				    pos.push_back(fvec3(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)));
+			    }
+		    }
+
+		    std::vector<unsigned> inds;
+		    for(unsigned i = 0; i < sphereDetail; i++) {
+			    for(unsigned j = 0; j < sphereDetail; j++) {
+				    unsigned a = i * (sphereDetail + 1) + j, b = a + sphereDetail + 1;
+				    inds.insert(inds.end(), { a, b, b + 1, a, b + 1, a + 1 });
+			    }
+		    }
+
+		    sphereVAO.bind();
+		    sphereVAO.storeAttribData(0, 3, (float*) pos.data(), pos.size() * sizeof(fvec3), GL_STATIC_DRAW);
+		    sphereVAO.storeIndices(inds.data(), inds.size() * sizeof(unsigned), GL_STATIC_DRAW);
+		    sphereVAO.unbind();
+		},
 	};
 
+	/// Appends the model matrix and color of an instance to instanceData.
+	static void AddInstance(const affine3x4& model, const vec4& color)
+	{
+		instanceData.insert(instanceData.end(), model.data.data(), model.data.data() + 12);
+		instanceData.insert(instanceData.end(), { (float) color.x, (float) color.y, (float) color.z, (float) color.w });
+	}
+
+	/// Draws the instances in instanceData with one call, then clears it.
+	static void DrawInstances(const Camera& cam, GL::VAO& vao, int count, GLenum renderType)
+	{
+		// 4 vec4s per instance: 3 rows of the model matrix and the color.
+		const int instances = instanceData.size() / 16;
+		vao.streamInstanceData(1, 4, instanceData.data(), instanceData.size() * sizeof(float));
+
+		instancedShad.use();
+		detail::UseFrameCamera(cam);
+		vao.drawInstanced(count, instances, renderType);
+		instanceData.clear();
+	}
+
+	/// Draws the vertices in batchPositions and batchColors with one call, then clears them.
+	static void DrawVertexColored(const Camera& cam, GL::VAO& vao, GLenum renderType)
+	{
+		std::size_t positionBytes = batchPositions.size() * sizeof(fvec3), colorBytes = batchColors.size() * sizeof(fvec4);
+		GL::GetVertexStream().reserve({ positionBytes, colorBytes });
+		vao.streamAttribData(0, 3, (float*) batchPositions.data(), positionBytes);
+		vao.streamAttribData(1, 4, (float*) batchColors.data(), colorBytes);
+
+		vertexColorShad.use();
+		detail::UseFrameCamera(cam);
+		vao.draw(batchPositions.size(), renderType);
+		batchPositions.clear();
+		batchColors.clear();
+	}
+
+	/// The model matrix of a sphere: the unit sphere scaled by its radius and moved to its center.
+	static affine3x4 SphereModel(const DrawnSphere& s)
+	{
+		return affine3x4(s.radius, 0, 0, s.center.x,
+		                 0, s.radius, 0, s.center.y,
+		                 0, 0, s.radius, s.center.z);
+	}
+
 	void Render(const Camera& cam, Cube c, RenderTarget rt, bool wireframe)
 	{
 		basicShad.use();
-		basicShad.SetVec4("color", c.color);
-		basicShad.SetMat4("transform", c.transform.getModel());
-		basicShad.SetMat4("perspective", cam.getPerspective());
-		basicShad.SetMat4("view", cam.getView());
+		detail::UseFrameCamera(cam);
+		basicShad.SetVec4(basicColor, c.color);
+		basicShad.SetMat4(basicTransform, c.transform.getModel());
 		cubeVAO.draw(36, wireframe ? GL_LINE_LOOP : GL_TRIANGLES);
 		//basicShad.unuse();
 	}
-	void Render(const Camera& cam, DrawnSphere s, RenderTarget rt, bool wireframe) {}
+
+	void Render(const Camera& cam, const std::vector<Cube>& cubes, RenderTarget rt, bool wireframe)
+	{
+		if(cubes.empty())
+			return;
+
+		for(const Cube& c : cubes)
+			AddInstance(c.transform.getModelAffine(), c.color);
+		DrawInstances(cam, cubeVAO, 36, wireframe ? GL_LINE_LOOP : GL_TRIANGLES);
+	}
+
+	void Render(const Camera& cam, DrawnSphere s, RenderTarget rt, bool wireframe)
+	{
+		basicShad.use();
+		detail::UseFrameCamera(cam);
+		basicShad.SetVec4(basicColor, s.color);
+		basicShad.SetMat4(basicTransform, ToMat4(SphereModel(s)));
+		sphereVAO.draw(sphereIndexCount, wireframe ? GL_LINE_LOOP : GL_TRIANGLES);
+	}
+
+	void Render(const Camera& cam, const std::vector<DrawnSphere>& spheres, RenderTarget rt, bool wireframe)
+	{
+		if(spheres.empty())
+			return;
+
+		for(const DrawnSphere& s : spheres)
+			AddInstance(SphereModel(s), s.color);
+		DrawInstances(cam, sphereVAO, sphereIndexCount, wireframe ? GL_LINE_LOOP : GL_TRIANGLES);
+	}
 
 	void Render(const Camera& cam, DrawnLine l, RenderTarget rt, bool wireframe)
 	{
 		basicShad.use();
-		basicShad.SetVec4("color", l.color);
-		basicShad.SetMat4("transform", Transform().getModel());
-		basicShad.SetMat4("perspective", cam.getPerspective());
-		basicShad.SetMat4("view", cam.getView());
+		detail::UseFrameCamera(cam);
+		basicShad.SetVec4(basicColor, l.color);
+		basicShad.SetMat4(basicTransform, Transform().getModel());
 		fvec3 p[2] = { l.start, l.end };
-		lineVAO.storeAttribData(0, 3, (float*) p, 2 * sizeof(vec3), GL_DYNAMIC_DRAW);
+		lineVAO.streamAttribData(0, 3, (float*) p, 2 * sizeof(fvec3));
 		lineVAO.draw(2, GL_LINES);
 		// basicShad.unuse();
 	}
@@ -134,32 +309,23 @@ namespace SWAN
 		if(lines.empty())
 			return;
 
-		std::vector<fvec3> p;
-
-		for(auto l : lines) {
-			p.push_back(l.start);
-			p.push_back(l.end);
+		for(const DrawnLine& l : lines) {
+			fvec4 color = l.color;
+			batchPositions.insert(batchPositions.end(), { l.start, l.end });
+			batchColors.insert(batchColors.end(), { color, color });
 		}
-
-		basicShad.use();
-		basicShad.SetVec4("color", lines[0].color);
-		basicShad.SetMat4("transform", Transform().getModel());
-		basicShad.SetMat4("perspective", cam.getPerspective());
-		basicShad.SetMat4("view", cam.getView());
-		linesVAO.storeAttribData(0, 3, (float*) p.data(), p.size() * sizeof(vec3), GL_DYNAMIC_DRAW);
-		linesVAO.draw(p.size(), GL_LINES);
+		DrawVertexColored(cam, linesVAO, GL_LINES);
 	}
 
 	void Render(const Camera& cam, Arrow a, RenderTarget rt, bool wireframe)
 	{
 		basicShad.use();
-		basicShad.SetVec4("color", a.color);
-		basicShad.SetMat4("transform", Transform().getModel());
-		basicShad.SetMat4("perspective", cam.getPerspective());
-		basicShad.SetMat4("view", cam.getView());
+		detail::UseFrameCamera(cam);
+		basicShad.SetVec4(basicColor, a.color);
+		basicShad.SetMat4(basicTransform, Transform().getModel());
 
 		fvec3 p[2] = { a.start, a.end };
-		lineVAO.storeAttribData(0, 3, (float*) p, 2 * sizeof(vec3), GL_DYNAMIC_DRAW);
+		lineVAO.streamAttribData(0, 3, (float*) p, 2 * sizeof(fvec3));
 		lineVAO.draw(2, GL_LINE_LOOP);
 		basicShad.unuse();
 	}
@@ -170,15 +336,14 @@ namespace SWAN
 		if(t.twoSided) {
 			std::array<fvec3, 6> v = { t.points[0], t.points[1], t.points[2],
 				                       t.points[2], t.points[1], t.points[0] };
-			triVAO.storeAttribData(0, 3, (float*) v.data(), 6 * sizeof(vec3), GL_DYNAMIC_DRAW);
+			triVAO.streamAttribData(0, 3, (float*) v.data(), 6 * sizeof(fvec3));
 		} else
-			triVAO.storeAttribData(0, 3, (float*) t.points, 3 * sizeof(vec3), GL_DYNAMIC_DRAW);
+			triVAO.streamAttribData(0, 3, (float*) t.points, 3 * sizeof(fvec3));
 
 		basicShad.use();
-		basicShad.SetVec4("color", t.color);
-		basicShad.SetMat4("transform", Transform().getModel());
-		basicShad.SetMat4("perspective", cam.getPerspective());
-		basicShad.SetMat4("view", cam.getView());
+		detail::UseFrameCamera(cam);
+		basicShad.SetVec4(basicColor, t.color);
+		basicShad.SetMat4(basicTransform, Transform().getModel());
 		triVAO.draw(t.twoSided ? 6 : 3, wireframe ? GL_LINE_STRIP : GL_TRIANGLES);
 		basicShad.unuse();
 	}
@@ -188,25 +353,16 @@ namespace SWAN
 		if(triangles.empty())
 			return;
 
-		std::vector<fvec3> v;
-		for(auto t : triangles) {
-			v.push_back(t.points[0]);
-			v.push_back(t.points[1]);
-			v.push_back(t.points[2]);
+		for(const DrawnTriangle& t : triangles) {
+			fvec4 color = t.color;
+			batchPositions.insert(batchPositions.end(), { t.points[0], t.points[1], t.points[2] });
+			batchColors.insert(batchColors.end(), { color, color, color });
 
 			if(t.twoSided) {
-				v.push_back(t.points[2]);
-				v.push_back(t.points[1]);
-				v.push_back(t.points[0]);
+				batchPositions.insert(batchPositions.end(), { t.points[2], t.points[1], t.points[0] });
+				batchColors.insert(batchColors.end(), { color, color, color });
 			}
 		}
-		trisVAO.storeAttribData(0, 3, (float*) v.data(), v.size() * sizeof(vec3), GL_DYNAMIC_DRAW);
-
-		basicShad.use();
-		basicShad.SetVec4("color", triangles[0].color);
-		basicShad.SetMat4("transform", Transform().getModel());
-		basicShad.SetMat4("perspective", cam.getPerspective());
-		basicShad.SetMat4("view", cam.getView());
-		trisVAO.draw(v.size(), wireframe ? GL_LINE_STRIP : GL_TRIANGLES);
+		DrawVertexColored(cam, trisVAO, wireframe ? GL_LINE_STRIP : GL_TRIANGLES);
 	}
 } // namespace SWAN
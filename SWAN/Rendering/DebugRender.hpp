@@ -43,6 +43,7 @@ namespace SWAN
 		vec4 color = { 1.0, 1.0, 1.0, 1.0 };
 		vec3 center;
 		double radius = 1.0;
+		/// @warning This currently does nothing, spheres are always drawn with 16 slices and stacks.
 		unsigned int detail = 16;
 	};
 	struct DrawnLine {
@@ -118,10 +119,27 @@ namespace SWAN
 	    RenderTarget rt = DefaultFramebuffer,
 	    bool wireframe = false);
 
+	/**
+	 * @brief Renders all the cubes with one instanced draw call.
+	 *
+	 * Each cube keeps its own transform and color. Prefer this to rendering cubes one by one,
+	 * which sets four uniforms and makes a draw call for each of them.
+	 */
+	extern void Render(const Camera& cam,
+	                   const std::vector<Cube>& cubes,
+	                   RenderTarget rt = DefaultFramebuffer,
+	                   bool wireframe = false);
+	/// Renders all the spheres with one instanced draw call, each with its own color.
+	extern void Render(const Camera& cam,
+	                   const std::vector<DrawnSphere>& spheres,
+	                   RenderTarget rt = DefaultFramebuffer,
+	                   bool wireframe = false);
+	/// Renders all the lines with one draw call, each with its own color.
 	extern void Render(const Camera& cam,
 	                   const std::vector<DrawnLine>& lines,
 	                   RenderTarget rt = DefaultFramebuffer,
 	                   bool wireframe = false);
+	/// Renders all the triangles with one draw call, each with its own color.
 	extern void Render(const Camera& cam,
 	                   const std::vector<DrawnTriangle>& triangles,
 	                   RenderTarget rt = DefaultFramebuffer,
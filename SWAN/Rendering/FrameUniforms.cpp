@@ -0,0 +1,50 @@
+#include "FrameUniforms.hpp"
+
+#include "OpenGL/UniformBuffer.hpp" // For SWAN::GL::UniformBuffer
+
+namespace SWAN
+{
+	static_assert(sizeof(FrameUniforms) == 3 * 64 + 16, "FrameUniforms doesn't match the std140 layout of the Frame block");
+
+	static GL::UniformBuffer frameBuffer;
+	static FrameUniforms frameUniforms;
+
+	static void UploadFrameUniforms()
+	{
+		frameBuffer.store(&frameUniforms, sizeof(frameUniforms));
+		frameBuffer.bindTo(UniformBlockBinding::Frame);
+	}
+
+	static mat4 ScreenProjection()
+	{
+		Camera screen = Camera(OrthographicT());
+		return screen.getPerspective() * screen.getView();
+	}
+
+	void SetFrameUniforms(const Camera& cam, double time)
+	{
+		frameUniforms.view = cam.getView();
+		frameUniforms.projection = cam.getPerspective();
+		frameUniforms.screen = ScreenProjection();
+		frameUniforms.time = time;
+		UploadFrameUniforms();
+	}
+
+	const FrameUniforms& GetFrameUniforms() { return frameUniforms; }
+
+	namespace detail
+	{
+		void UseFrameCamera(const Camera& cam)
+		{
+			frameUniforms.view = cam.getView();
+			frameUniforms.projection = cam.getPerspective();
+			UploadFrameUniforms();
+		}
+
+		void UseFrameScreen()
+		{
+			frameUniforms.screen = ScreenProjection();
+			UploadFrameUniforms();
+		}
+	} // namespace detail
+} // namespace SWAN
@@ -0,0 +1,68 @@
+#ifndef SWAN_FRAME_UNIFORMS_HPP
+#define SWAN_FRAME_UNIFORMS_HPP
+
+#include <glad/glad.h> // For GLuint
+
+#include "Camera.hpp"       // For SWAN::Camera
+#include "Maths/Matrix.hpp" // For SWAN::mat4
+
+namespace SWAN
+{
+	/// Binding points of the uniform blocks used by the built-in shaders.
+	namespace UniformBlockBinding
+	{
+		/// The per-frame block, see FrameUniforms.
+		constexpr GLuint Frame = 0;
+
+		/// Per-material blocks. Each material binds its own buffer here before drawing.
+		constexpr GLuint Material = 1;
+	} // namespace UniformBlockBinding
+
+	/**
+	 * @brief The per-frame uniform block, shared by every shader that declares SWAN_FRAME_BLOCK_GLSL.
+	 *
+	 * Laid out as std140, with matrices in the same (row-major) order as mat4.
+	 */
+	struct FrameUniforms {
+		mat4 view;
+		mat4 projection;
+
+		/// Orthographic projection in pixels, with (0, 0) at the top left of the display. For text and GUI.
+		mat4 screen;
+
+		/// Seconds, as passed to SetFrameUniforms().
+		float time = 0;
+		float padding[3] = { 0, 0, 0 };
+	};
+
+/// GLSL declaration of the per-frame block, to put after the #version (140 or newer) of a shader.
+#define SWAN_FRAME_BLOCK_GLSL                       \
+	"layout(std140, row_major) uniform Frame {\n" \
+	"    mat4 view;\n"                              \
+	"    mat4 projection;\n"                        \
+	"    mat4 screen;\n"                            \
+	"    float time;\n"                             \
+	"};\n"
+
+	/**
+	 * @brief Upload the per-frame block for a frame rendered with @p cam.
+	 *
+	 * Call it once per frame before rendering. The built-in renderers also keep the block
+	 * up to date with the camera they're given, but only upload it when that changes it.
+	 */
+	extern void SetFrameUniforms(const Camera& cam, double time);
+
+	/// Get the values last uploaded to the per-frame block.
+	extern const FrameUniforms& GetFrameUniforms();
+
+	namespace detail
+	{
+		/// Makes the per-frame block hold the matrices of @p cam, uploading it only if they changed.
+		extern void UseFrameCamera(const Camera& cam);
+
+		/// Makes the per-frame block hold the screen projection for the current display size, uploading it only if it changed.
+		extern void UseFrameScreen();
+	} // namespace detail
+} // namespace SWAN
+
+#endif
@@ -98,9 +98,9 @@ namespace SWAN
 			indices.push_back(inds[i]);
 
 		vao.bind();
-		vao.storeAttribData(0, 3, (float*) posV.data(), posV.size() * sizeof(vec3));
-		vao.storeAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(vec2));
-		vao.storeAttribData(2, 3, (float*) normV.data(), normV.size() * sizeof(vec3));
+		vao.storeAttribData(0, 3, (float*) posV.data(), posV.size() * sizeof(fvec3));
+		vao.storeAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2));
+		vao.storeAttribData(2, 3, (float*) normV.data(), normV.size() * sizeof(fvec3));
 		vao.storeIndices(inds, indCount * sizeof(unsigned));
 		vao.unbind();
 	}
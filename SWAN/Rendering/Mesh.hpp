@@ -49,8 +49,8 @@ namespace SWAN
 		void renderWireframe() const;
 		void renderVerts() const;
 
-		auto GetPoints() const { return points; }
-		auto GetIndices() const { return indices; }
+		const std::vector<fvec3>& GetPoints() const { return points; }
+		const std::vector<uint>& GetIndices() const { return indices; }
 
 	  private:
 		void init(Vertex* verts, uint* inds);
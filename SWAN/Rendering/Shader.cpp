@@ -6,6 +6,7 @@
 #include "Utility/Debug.hpp"
 #include "Utility/Group.hpp"
 
+#include <cstring> // For std::memcmp(), std::memcpy()
 #include <fstream>
 #include <iostream>
 #include <vector>
@@ -17,6 +18,21 @@ namespace SWAN
 
 	static Shader* ActiveShader = nullptr;
 
+	namespace GL
+	{
+		namespace detail
+		{
+			UniformStats uniformStats;
+			UniformStats lastFrameUniformStats;
+
+			void EndUniformFrame()
+			{
+				lastFrameUniformStats = uniformStats;
+				uniformStats = UniformStats();
+			}
+		} // namespace detail
+	}     // namespace GL
+
 	void Shader::compileShaders(const std::string& vertexShaderFilepath,
 	                            const std::string& fragmentShaderFilepath)
 	{
@@ -45,11 +61,22 @@ namespace SWAN
 	{
 		programID = glCreateProgram();
 
+		// The program doesn't exist before this, so the attributes can only be bound now.
+		for(int i = 0; i < numAttributes; i++)
+			glBindAttribLocation(programID, i, attributes[i].c_str());
+
 		glAttachShader(programID, vertexShaderID);
 		glAttachShader(programID, fragmentShaderID);
 
 		glLinkProgram(programID);
 
+		// A new program has its own uniform locations, with the uniforms at their defaults.
+		for(const auto& uniform : uniforms) {
+			UniformSlot& slot = slots[uniform.second];
+			slot.location = glGetUniformLocation(programID, uniform.first.c_str());
+			slot.size = 0;
+		}
+
 		GLint isLinked = 0;
 		glGetProgramiv(programID, GL_LINK_STATUS, (int*) &isLinked);
 		if(isLinked == GL_FALSE) {
@@ -80,7 +107,10 @@ namespace SWAN
 
 	void Shader::addAttrib(const std::string& attributeName)
 	{
-		glBindAttribLocation(programID, numAttributes++, attributeName.c_str());
+		attributes.push_back(attributeName);
+		if(programID)
+			glBindAttribLocation(programID, numAttributes, attributeName.c_str());
+		numAttributes++;
 	}
 
 	void Shader::use()
@@ -174,65 +204,137 @@ namespace SWAN
 #endif
 	}
 
-	void Shader::addUniform(const std::string& name)
+	Shader::Uniform Shader::addUniform(const std::string& name)
 	{
+		auto iter = uniforms.find(name);
+		if(iter != uniforms.end())
+			return Uniform{ iter->second };
+
 		auto res = glGetUniformLocation(programID, name.c_str());
 		if(res >= 0) {
-			uniforms.insert({ name, res });
+			UniformSlot slot;
+			slot.location = res;
+			slots.push_back(slot);
+			uniforms.insert({ name, (int) slots.size() - 1 });
+			return Uniform{ (int) slots.size() - 1 };
 		} else {
 			Log("Shader",
 			    Format("Attempted to add uniform \"{}\", but the uniform doesn't exist.", name),
 			    LogLevel::Error);
+			return Uniform();
 		}
 	}
 
-	GLint Shader::getUniformID(const std::string& name) { return uniforms[name]; }
+	Shader::Uniform Shader::getUniform(const std::string& name) const
+	{
+		auto iter = uniforms.find(name);
+		return iter == uniforms.end() ? Uniform() : Uniform{ iter->second };
+	}
+
+	Shader::Uniform Shader::findUniform(const std::string& name)
+	{
+#ifdef SWAN_DEBUG_SHADER
+		if(!hasUniform(name))
+			return Uniform();
+#endif
+		return getUniform(name);
+	}
+
+	GLint Shader::getUniformID(const std::string& name)
+	{
+		Uniform u = getUniform(name);
+		return u ? slots[u.slot].location : -1;
+	}
+
+	bool Shader::bindUniformBlock(const std::string& name, GLuint binding)
+	{
+		GLuint index = glGetUniformBlockIndex(programID, name.c_str());
+		if(index == GL_INVALID_INDEX) {
+			Log("Shader",
+			    Format("Attempted to bind uniform block \"{}\", but the block doesn't exist.", name),
+			    LogLevel::Error);
+			return false;
+		}
+
+		glUniformBlockBinding(programID, index, binding);
+		return true;
+	}
+
+	bool Shader::needsUpload(Uniform u, const void* data, unsigned size, GLboolean transposed)
+	{
+		UniformSlot& slot = slots[u.slot];
+		if(slot.size == size && slot.transposed == transposed && std::memcmp(slot.value, data, size) == 0) {
+			GL::detail::uniformStats.skipped++;
+			return false;
+		}
+
+		std::memcpy(slot.value, data, size);
+		slot.size = size;
+		slot.transposed = transposed;
+		GL::detail::uniformStats.uploads++;
+		return true;
+	}
+
+	void Shader::SetInt(const String& name, int data) { SetInt(findUniform(name), data); }
+	void Shader::SetReal(const String& name, double data) { SetReal(findUniform(name), data); }
+
+	void Shader::SetVec2(const String& name, vec2 data) { SetVec2(findUniform(name), data); }
+	void Shader::SetVec3(const String& name, vec3 data) { SetVec3(findUniform(name), data); }
+	void Shader::SetVec4(const String& name, vec4 data) { SetVec4(findUniform(name), data); }
+
+	void Shader::SetMat2(const String& name, mat2 data, GLboolean transposed) { SetMat2(findUniform(name), data, transposed); }
+	void Shader::SetMat3(const String& name, mat3 data, GLboolean transposed) { SetMat3(findUniform(name), data, transposed); }
+	void Shader::SetMat4(const String& name, mat4 data, GLboolean transposed) { SetMat4(findUniform(name), data, transposed); }
 
-	void Shader::SetInt(const String& name, int data)
+	void Shader::SetInt(Uniform u, int data)
 	{
-		if(hasUniform(name))
-			glUniform1i(uniforms[name], data);
+		if(u && needsUpload(u, &data, sizeof(data)))
+			glUniform1i(slots[u.slot].location, data);
 	}
 
-	void Shader::SetReal(const String& name, double data)
+	void Shader::SetReal(Uniform u, double data)
 	{
-		if(hasUniform(name))
-			glUniform1f(uniforms[name], data);
+		const GLfloat v = data;
+		if(u && needsUpload(u, &v, sizeof(v)))
+			glUniform1f(slots[u.slot].location, v);
 	}
 
-	void Shader::SetVec2(const std::string& name, vec2 data)
+	void Shader::SetVec2(Uniform u, vec2 data)
 	{
-		if(hasUniform(name))
-			glUniform2f(uniforms[name], data.x, data.y);
+		const GLfloat v[2] = { (GLfloat) data.x, (GLfloat) data.y };
+		if(u && needsUpload(u, v, sizeof(v)))
+			glUniform2fv(slots[u.slot].location, 1, v);
 	}
 
-	void Shader::SetVec3(const std::string& name, vec3 data)
+	void Shader::SetVec3(Uniform u, vec3 data)
 	{
-		if(hasUniform(name))
-			glUniform3f(uniforms[name], data.x, data.y, data.z);
+		const GLfloat v[3] = { (GLfloat) data.x, (GLfloat) data.y, (GLfloat) data.z };
+		if(u && needsUpload(u, v, sizeof(v)))
+			glUniform3fv(slots[u.slot].location, 1, v);
 	}
 
-	void Shader::SetVec4(const std::string& name, vec4 data)
+	void Shader::SetVec4(Uniform u, vec4 data)
 	{
-		if(hasUniform(name))
-			glUniform4f(uniforms[name], data.x, data.y, data.z, data.w);
+		const GLfloat v[4] = { (GLfloat) data.x, (GLfloat) data.y, (GLfloat) data.z, (GLfloat) data.w };
+		if(u && needsUpload(u, v, sizeof(v)))
+			glUniform4fv(slots[u.slot].location, 1, v);
 	}
 
-	void Shader::SetMat2(const std::string& name, mat2 data, GLboolean transposed)
+	void Shader::SetMat2(Uniform u, mat2 data, GLboolean transposed)
 	{
-		if(hasUniform(name))
-			glUniformMatrix2fv(uniforms[name], 1, transposed, (const GLfloat*) data.data.data());
+		if(u && needsUpload(u, data.data.data(), sizeof(GLfloat) * 4, transposed))
+			glUniformMatrix2fv(slots[u.slot].location, 1, transposed, (const GLfloat*) data.data.data());
 	}
 
-	void Shader::SetMat3(const std::string& name, mat3 data, GLboolean transposed)
+	void Shader::SetMat3(Uniform u, mat3 data, GLboolean transposed)
 	{
-		if(hasUniform(name))
-			glUniformMatrix3fv(uniforms[name], 1, transposed, (const GLfloat*) data.data.data());
+		if(u && needsUpload(u, data.data.data(), sizeof(GLfloat) * 9, transposed))
+			glUniformMatrix3fv(slots[u.slot].location, 1, transposed, (const GLfloat*) data.data.data());
 	}
 
-	void Shader::SetMat4(const std::string& name, mat4 data, GLboolean transposed)
+	void Shader::SetMat4(Uniform u, mat4 data, GLboolean transposed)
 	{
-		if(hasUniform(name))
-			glUniformMatrix4fv(uniforms[name], 1, transposed, (const GLfloat*) data.data.data());
+		if(u && needsUpload(u, data.data.data(), sizeof(GLfloat) * 16, transposed))
+			glUniformMatrix4fv(slots[u.slot].location, 1, transposed, (const GLfloat*) data.data.data());
 	}
 } // namespace SWAN
@@ -16,6 +16,26 @@
 
 namespace SWAN
 {
+	namespace GL
+	{
+		/// How many uniform values were uploaded, and how many weren't because the program already had them.
+		struct UniformStats {
+			unsigned long uploads = 0;
+			unsigned long skipped = 0;
+		};
+
+		namespace detail
+		{
+			/// Counts for the frame being rendered.
+			extern UniformStats uniformStats;
+			/// Counts for the last whole frame, a frame ends with Display::Clear().
+			extern UniformStats lastFrameUniformStats;
+
+			/// Makes the current counts the last frame's, and starts counting the next frame.
+			extern void EndUniformFrame();
+		} // namespace detail
+	}     // namespace GL
+
 	/// A representation of an OpenGL shader uniform.
 	struct ShaderUniform {
 		String Name;
@@ -294,16 +314,32 @@ namespace SWAN
 	// Reference: http://www.opengl.org/wiki/Shader_Compilation
 	//-----------------------------------------------------------------------------------------
 
-	/// Representation of an OpenGL shader.
+	/**
+	 * @brief Representation of an OpenGL shader.
+	 *
+	 * Uniforms can be set by name, or through a Uniform handle from addUniform() or getUniform(),
+	 * which skips looking the name up. Either way, the shader remembers the last value uploaded
+	 * to each uniform and doesn't upload it again if it hasn't changed. Uniforms must be set while
+	 * the shader is in use.
+	 */
 	class Shader
 	{
 	  public:
+		/// A uniform found once, to set it without looking its name up.
+		struct Uniform {
+			/// Index in the shader's uniforms, or -1 if the shader doesn't have it.
+			int slot = -1;
+
+			explicit operator bool() const { return slot >= 0; }
+		};
+
 		/// Read the contents of the vertex and fragment shader files,
 		void compileShaders(const std::string& vertexShaderFilepath,
 		                    const std::string& fragmentShaderFilepath);
 
 		void compileShadersFromSrc(const char* vertSrc, const char* fragSrc);
 
+		/// Link the compiled shaders into a new program. Uniforms that were added are looked up again in it.
 		void linkShaders();
 		void addAttrib(const std::string& attributeName);
 
@@ -321,10 +357,17 @@ namespace SWAN
 	 *  @return Whether the uniform is in the shader.
 	 */
 		bool hasUniform(const std::string& name);
-		void addUniform(const std::string& name);
+		Uniform addUniform(const std::string& name);
+
+		/// Get the handle of a uniform added with addUniform(), which is false if it wasn't.
+		Uniform getUniform(const std::string& name) const;
 
 		GLint getUniformID(const std::string& name);
 
+		/// Have the uniform block @p name read from the buffer bound to @p binding (see GL::UniformBuffer::bindTo()).
+		/// Returns false if the shader has no such block.
+		bool bindUniformBlock(const std::string& name, GLuint binding);
+
 		void SetInt(const String& name, int value);
 		void SetReal(const String& name, double value);
 
@@ -336,8 +379,38 @@ namespace SWAN
 		void SetMat3(const String& name, mat3 mat, GLboolean transposed = GL_TRUE);
 		void SetMat4(const String& name, mat4 mat, GLboolean transposed = GL_TRUE);
 
+		void SetInt(Uniform u, int value);
+		void SetReal(Uniform u, double value);
+
+		void SetVec2(Uniform u, vec2 vec);
+		void SetVec3(Uniform u, vec3 vec);
+		void SetVec4(Uniform u, vec4 vec);
+
+		void SetMat2(Uniform u, mat2 mat, GLboolean transposed = GL_TRUE);
+		void SetMat3(Uniform u, mat3 mat, GLboolean transposed = GL_TRUE);
+		void SetMat4(Uniform u, mat4 mat, GLboolean transposed = GL_TRUE);
+
 	  private:
+		/// A uniform's location, and the value last uploaded to it.
+		struct UniformSlot {
+			GLint location = -1;
+
+			/// Bytes of the value as passed to glUniform*(), 0 before the first upload.
+			unsigned size = 0;
+			GLboolean transposed = GL_FALSE;
+			unsigned char value[16 * sizeof(GLfloat)];
+		};
+
+		/// Looks up a uniform by name, warning about missing ones if SWAN_DEBUG_SHADER is defined.
+		Uniform findUniform(const std::string& name);
+
+		/// Whether @p data differs from the last value uploaded to the uniform, in which case it's
+		/// remembered as the new value. Counts the upload or the skip in GL::detail::uniformStats.
+		bool needsUpload(Uniform u, const void* data, unsigned size, GLboolean transposed = GL_FALSE);
+
 		int numAttributes = 0;
+		/// Names of the attributes added with addAttrib(), bound to their locations when the program is linked.
+		std::vector<std::string> attributes;
 
 		void compileShader(const std::string& filePath, GLuint id);
 		void comp(const char* src, GLuint id);
@@ -346,6 +419,8 @@ namespace SWAN
 		GLuint vertexShaderID = 0;
 		GLuint fragmentShaderID = 0;
 
-		std::map<std::string, GLint> uniforms;
+		/// Maps the names of uniforms to their index in slots.
+		std::map<std::string, int> uniforms;
+		std::vector<UniformSlot> slots;
 	};
 } // namespace SWAN
@@ -1,10 +1,13 @@
 #include "SpriteSheet.hpp"
 
+#include "FrameUniforms.hpp" // For SWAN::UniformBlockBinding
 #include "Shader.hpp"
 
 #include "Core/Display.hpp"
 
 #include "OpenGL/OnGLInit.hpp"
+#include "OpenGL/StreamBuffer.hpp"
+#include "OpenGL/UniformBuffer.hpp"
 #include "OpenGL/VAO.hpp"
 
 #include "Utility/CxArray.hpp"
@@ -13,7 +16,7 @@
 static SWAN::Shader spriteShader;
 
 static const char* spriteVert = R"glsl(
-#version 130
+#version 140
 
 in vec2 pos;
 in vec2 UV;
@@ -26,20 +29,22 @@ void main() {
 )glsl";
 
 static const char* spriteFrag = R"glsl(
-#version 130
+#version 140
 
 in vec2 _UV;
 out vec4 fCol;
 
 uniform sampler2D tex;
 
-uniform float overrideColorInfluence = 0;
-uniform vec3 overrideColor;
-uniform float overrideAlphaInfluence = 0;
-uniform float overrideAlpha;
+layout(std140) uniform SpriteMaterial {
+    vec3 overrideColor;
+    float overrideColorInfluence;
+    float overrideAlpha;
+    float overrideAlphaInfluence;
+};
 
 void main() {
-    vec4 c = texture2D(tex, _UV);
+    vec4 c = texture(tex, _UV);
     fCol.rgb = mix(c.rgb, overrideColor, overrideColorInfluence);
     fCol.a = mix(c.a, overrideAlpha, overrideAlphaInfluence);
 }
@@ -51,18 +56,24 @@ static SWAN::OnGLInit _ = {
 	    spriteShader.addAttrib("pos");
 	    spriteShader.addAttrib("UV");
 	    spriteShader.linkShaders();
-
-	    spriteShader.use();
-
-	    spriteShader.addUniform("overrideColorInfluence");
-	    spriteShader.addUniform("overrideColor");
-	    spriteShader.addUniform("overrideAlphaInfluence");
-	    spriteShader.addUniform("overrideAlpha");
-
-	    spriteShader.unuse();
+	    spriteShader.bindUniformBlock("SpriteMaterial", SWAN::UniformBlockBinding::Material);
 	}
 };
 
+/// The SpriteMaterial block, laid out as std140.
+struct SpriteMaterial {
+	float overrideColor[3] = { 0, 0, 0 };
+	float overrideColorInfluence = 0;
+	float overrideAlpha = 0;
+	float overrideAlphaInfluence = 0;
+	float padding[2] = { 0, 0 };
+};
+static_assert(sizeof(SpriteMaterial) == 32, "SpriteMaterial doesn't match the std140 layout of its block");
+
+/// Sprites drawn as they are, and sprites with their color or alpha overridden.
+/// Plain sprites never change their material, so their buffer is only uploaded once.
+static SWAN::GL::UniformBuffer plainMaterial, overrideMaterial;
+
 namespace SWAN
 {
 
@@ -122,9 +133,14 @@ namespace SWAN
 			fvec2(uvMax.x, uvMin.y)
 		};
 
+		GL::GetVertexStream().reserve({ sizeof(fvec2) * 4, sizeof(fvec2) * 4 });
 		spriteVAO.bind();
-		spriteVAO.storeAttribData(0, 2, (float*) pos.data(), sizeof(fvec2) * 4);
-		spriteVAO.storeAttribData(1, 2, (float*) UV.data(), sizeof(fvec2) * 4);
+		spriteVAO.streamAttribData(0, 2, (float*) pos.data(), sizeof(fvec2) * 4);
+		spriteVAO.streamAttribData(1, 2, (float*) UV.data(), sizeof(fvec2) * 4);
+
+		SpriteMaterial material;
+		plainMaterial.store(&material, sizeof(material));
+		plainMaterial.bindTo(UniformBlockBinding::Material);
 
 		spriteShader.use();
 		source->bind();
@@ -187,15 +203,22 @@ namespace SWAN
 			fvec2(uvMax.x, uvMin.y)
 		};
 
+		GL::GetVertexStream().reserve({ sizeof(fvec2) * 4, sizeof(fvec2) * 4 });
 		spriteVAO.bind();
-		spriteVAO.storeAttribData(0, 2, (float*) pos.data(), sizeof(fvec2) * 4);
-		spriteVAO.storeAttribData(1, 2, (float*) UV.data(), sizeof(fvec2) * 4);
+		spriteVAO.streamAttribData(0, 2, (float*) pos.data(), sizeof(fvec2) * 4);
+		spriteVAO.streamAttribData(1, 2, (float*) UV.data(), sizeof(fvec2) * 4);
+
+		SpriteMaterial material;
+		material.overrideColor[0] = color.x;
+		material.overrideColor[1] = color.y;
+		material.overrideColor[2] = color.z;
+		material.overrideColorInfluence = 1;
+		material.overrideAlpha = alpha;
+		material.overrideAlphaInfluence = alpha < 0 ? 0 : 1;
+		overrideMaterial.store(&material, sizeof(material));
+		overrideMaterial.bindTo(UniformBlockBinding::Material);
 
 		spriteShader.use();
-		spriteShader.SetReal("overrideColorInfluence", 1.0);
-		spriteShader.SetVec3("overrideColor", color);
-		spriteShader.SetReal("overrideAlphaInfluence", alpha < 0 ? 0 : 1);
-		spriteShader.SetReal("overrideAlpha", alpha);
 		source->bind();
 		spriteVAO.draw(4, GL_TRIANGLE_FAN);
 		spriteShader.unuse();
@@ -5,7 +5,9 @@
 #include "Core/Logging.hpp"
 
 #include "Camera.hpp"
-#include "OpenGL/OnGLInit.hpp" // For SWAN::OnGLInit()
+#include "FrameUniforms.hpp"       // For SWAN_FRAME_BLOCK_GLSL, SWAN::detail::UseFrameScreen()
+#include "OpenGL/OnGLInit.hpp"     // For SWAN::OnGLInit()
+#include "OpenGL/StreamBuffer.hpp" // For SWAN::GL::GetVertexStream()
 
 #include "Maths/Vector.hpp" // For SWAN::vec2, SWAN::vec3
 
@@ -21,24 +23,23 @@
 using namespace SWAN::Util;
 
 static const char* textVert = R"ddd(
-#version 130
-
+#version 140
+)ddd" SWAN_FRAME_BLOCK_GLSL R"ddd(
 in vec2 pos;
 in vec2 UV;
 
 out vec2 fUV;
 
 uniform vec2 offset;
-uniform mat4 viewProj;
 
 void main() {
-    gl_Position = viewProj * vec4(pos + offset, 0, 1);
+    gl_Position = screen * vec4(pos + offset, 0, 1);
     fUV = UV;
 }
 )ddd";
 
 static const char* textFrag = R"ddd(
-#version 130
+#version 140
 
 in vec2 fUV;
 
@@ -48,7 +49,7 @@ uniform vec4 color = vec4(0, 0, 0, 1);
 uniform sampler2D tex;
 
 void main(){
-    fCol = vec4(color.rgb, texture2D(tex, vec2(fUV.x, fUV.y)).a);
+    fCol = vec4(color.rgb, texture(tex, vec2(fUV.x, fUV.y)).a);
 }
 )ddd";
 
@@ -60,10 +61,10 @@ SWAN::OnGLInit _(
 	    textShader.addAttrib("pos");
 	    textShader.addAttrib("UV");
 	    textShader.linkShaders();
+	    textShader.bindUniformBlock("Frame", SWAN::UniformBlockBinding::Frame);
 
 	    textShader.use();
 	    textShader.addUniform("offset");
-	    textShader.addUniform("viewProj");
 	    textShader.addUniform("color");
 	    textShader.unuse();
     });
@@ -126,8 +127,14 @@ namespace SWAN
 		}
 
 		vao.bind();
-		vao.storeAttribData(0, 2, (float*) pos.data(), pos.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
-		vao.storeAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
+		if(streamed) {
+			GL::GetVertexStream().reserve({ pos.size() * sizeof(fvec2), UVs.size() * sizeof(fvec2) });
+			vao.streamAttribData(0, 2, (float*) pos.data(), pos.size() * sizeof(fvec2));
+			vao.streamAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2));
+		} else {
+			vao.storeAttribData(0, 2, (float*) pos.data(), pos.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
+			vao.storeAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
+		}
 
 		numVerts = verts;
 	}
@@ -247,8 +254,14 @@ namespace SWAN
 		}
 
 		vao.bind();
-		vao.storeAttribData(0, 2, (float*) pos.data(), pos.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
-		vao.storeAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
+		if(streamed) {
+			GL::GetVertexStream().reserve({ pos.size() * sizeof(fvec2), UVs.size() * sizeof(fvec2) });
+			vao.streamAttribData(0, 2, (float*) pos.data(), pos.size() * sizeof(fvec2));
+			vao.streamAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2));
+		} else {
+			vao.storeAttribData(0, 2, (float*) pos.data(), pos.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
+			vao.storeAttribData(1, 2, (float*) UVs.data(), UVs.size() * sizeof(fvec2), GL_DYNAMIC_DRAW);
+		}
 
 		numVerts = verts;
 	}
@@ -259,11 +272,12 @@ namespace SWAN
 		if(Util::Trim(text).length() < 1)
 			return;
 
-		Camera c = Camera(OrthographicT());
-
 		s->use();
+		detail::UseFrameScreen();
+		// Custom shaders might not use the frame block.
+		if(s != &textShader)
+			s->SetMat4("viewProj", GetFrameUniforms().screen);
 		s->SetVec2("offset", vec2(x, y));
-		s->SetMat4("viewProj", c.getPerspective() * c.getView());
 		s->SetVec4("color", color);
 		font->getTexture()->bind();
 		vao.draw(numVerts);
@@ -278,16 +292,14 @@ namespace SWAN
 			return;
 		}
 
-		Camera c = Camera(OrthographicT());
-
 		clip.Position -= ivec2(x, y);
 
 		// "No, really, I'm not const!"
 		((Text*) this)->updateVAOClipped(clip);
 
 		textShader.use();
+		detail::UseFrameScreen();
 		textShader.SetVec2("offset", vec2(x, y));
-		textShader.SetMat4("viewProj", c.getPerspective() * c.getView());
 		textShader.SetVec4("color", color);
 		font->getTexture()->bind();
 		vao.draw(numVerts);
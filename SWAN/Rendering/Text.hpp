@@ -52,6 +52,11 @@ namespace SWAN
 		std::string text;
 		const BitmapFont* font;
 		int numVerts = 0;
+
+		/// Whether the glyphs are put in the vertex stream (see GL::VAO::streamAttribData()) instead of
+		/// buffers of their own. For text that's changed about as often as it's rendered, like GUIManager's.
+		/// @warning Streamed text must be updated every frame it's rendered.
+		bool streamed = false;
 	};
 } // namespace SWAN
 
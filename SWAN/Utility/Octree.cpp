@@ -1,147 +1,161 @@
 #include "Octree.hpp"
 
-#include <stack> // For std::stack<T>
+#include <algorithm> // For std::min(), std::max()
 
 namespace SWAN
 {
-	template <typename T, unsigned Threshold>
-	Octree<T, Threshold>::Node::~Node()
+	constexpr Octree::ObjectID Octree::None;
+
+	Octree::Octree(vec3 center, double halfSize, unsigned maxDepth, double looseness)
+	    : maxDepth(maxDepth), looseness(std::max(looseness, 1.0))
 	{
-		std::stack<Node*> s;
-		s.push(this);
-
-		while(this->children) {
-			for(int i = 0; i < 8; i++) {
-				if(s.top()->children[i]->children) {
-					s.push(&s.top()->children[i]);
-					break;
-				}
-			}
-			delete[] s.top()->children;
-			s.top()->children = nullptr;
-			s.pop();
-		}
+		Node root;
+		root.center = center;
+		root.halfSize = halfSize;
+		root.parent = root.firstChild = None;
+		root.depth = 0;
+		root.count = 0;
+		nodes.push_back(root);
 	}
 
-	template <typename T, unsigned Threshold>
-	typename Octree<T, Threshold>::ObjectSector
-	Octree<T, Threshold>::Node::getObjectSector(double x, double y, double z)
+	Octree::ObjectID Octree::insert(const AABB& box, std::uint32_t userData)
 	{
-		if(!children)
-			return Octree::S_Main;
-
-		double
-		    centerX
-		    = box.min.x + (box.max.x - box.min.x) / 2,
-		    centerY = box.min.y + (box.max.y - box.min.y) / 2,
-		    centerZ = box.min.z + (box.max.z - box.min.z) / 2;
-
-		if(y <= centerY) {
-			if(x <= centerX) {
-				if(z <= centerZ)
-					return Octree::S_BottomLeftFront;
-				else
-					return Octree::S_BottomLeftBack;
-			} else {
-				if(z <= centerZ)
-					return Octree::S_BottomRightFront;
-				else
-					return Octree::S_BottomRightBack;
-			}
+		ObjectID id;
+		if(freeIDs.empty()) {
+			id = objects.size();
+			objects.push_back(Object());
 		} else {
-			if(x <= centerX) {
-				if(z <= centerZ)
-					return Octree::S_TopLeftFront;
-				else
-					return Octree::S_TopLeftBack;
-			} else {
-				if(z <= centerZ)
-					return Octree::S_TopRightFront;
-				else
-					return Octree::S_TopRightBack;
+			id = freeIDs.back();
+			freeIDs.pop_back();
+		}
+
+		objects[id].box = box;
+		objects[id].userData = userData;
+		addToNode(id, findNode(0, box));
+
+		objectCount++;
+		return id;
+	}
+
+	void Octree::remove(ObjectID object)
+	{
+		removeFromNode(object, objects[object].node, objects[object].slot);
+		freeIDs.push_back(object);
+		objectCount--;
+	}
+
+	bool Octree::move(ObjectID object, const AABB& box)
+	{
+		objects[object].box = box;
+
+		std::uint32_t node = findNode(objects[object].node, box);
+		if(node == objects[object].node)
+			return false;
+
+		// Added before removing, so the children just created for it aren't freed when the old node empties.
+		std::uint32_t oldNode = objects[object].node, oldSlot = objects[object].slot;
+		addToNode(object, node);
+		removeFromNode(object, oldNode, oldSlot);
+		return true;
+	}
+
+	void Octree::queryPairs(Vector<Pair>& out) const
+	{
+		out.clear();
+		// Loose bounds of neighbouring nodes overlap, so every object has to look at the whole tree.
+		for(const Node& node : nodes) {
+			for(ObjectID a : node.objects) {
+				query(objects[a].box, [&](ObjectID b) {
+					if(a < b)
+						out.push_back({ a, b });
+				});
 			}
 		}
 	}
 
-	template <typename T, unsigned Threshold>
-	void Octree<T, Threshold>::Node::split()
+	std::uint32_t Octree::findNode(std::uint32_t start, const AABB& box)
+	{
+		// Go up until the box fits, the root takes everything.
+		std::uint32_t index = start;
+		while(index != 0 && !looseBounds(nodes[index]).Contains(box))
+			index = nodes[index].parent;
+
+		// Go down into the child whose cell holds the box's center, while its bounds hold the whole box.
+		vec3 c = box.center();
+		while(nodes[index].depth < maxDepth) {
+			const Node& node = nodes[index];
+			std::uint32_t octant = (c.x >= node.center.x ? 1 : 0) | (c.y >= node.center.y ? 2 : 0) | (c.z >= node.center.z ? 4 : 0);
+
+			Real half = node.halfSize / 2;
+			vec3 childCenter = node.center + vec3(octant & 1 ? half : -half, octant & 2 ? half : -half, octant & 4 ? half : -half);
+			vec3 childLoose(half * looseness);
+			if(!AABB(childCenter - childLoose, childCenter + childLoose).Contains(box))
+				break;
+
+			if(node.firstChild == None)
+				split(index);
+			index = nodes[index].firstChild + octant;
+		}
+		return index;
+	}
+
+	void Octree::split(std::uint32_t index)
 	{
-		children = new Node[8];
-
-		double minX = box.min.x,
-		       minY = box.min.y,
-		       minZ = box.min.z;
-
-		double maxX = box.max.x,
-		       maxY = box.max.y,
-		       maxZ = box.max.z;
-
-		double centerX = minX + (maxX - minX) / 2,
-		       centerY = minY + (maxY - minY) / 2,
-		       centerZ = minZ + (maxZ - minZ) / 2;
-
-		// --------- Top Front ----------------------------
-		children[Octree::S_TopLeftFront - 1].box = {
-			vec3(minX, centerY, minZ),
-			vec3(centerX, maxY, centerZ)
-		};
-
-		children[Octree::S_TopRightFront - 1].box = {
-			vec3(centerX, centerY, minZ),
-			vec3(maxX, maxY, centerZ)
-		};
-
-		// --------- Top Back ----------------------------
-		children[Octree::S_TopLeftBack - 1].box = {
-			vec3(minX, centerY, centerZ),
-			vec3(centerX, maxY, maxZ)
-		};
-
-		children[Octree::S_TopRightBack - 1].box = {
-			vec3(centerX, centerY, centerZ),
-			vec3(maxX, maxY, maxZ)
-		};
-
-		// --------- Bottom Front ----------------------------
-		children[Octree::S_BottomLeftFront - 1].box = {
-			vec3(minX, minY, minZ),
-			vec3(centerX, centerY, centerZ)
-		};
-
-		children[Octree::S_BottomRightFront - 1].box = {
-			vec3(centerX, minY, minZ),
-			vec3(maxX, centerY, centerZ)
-		};
-
-		// --------- Bottom Back ----------------------------
-		children[Octree::S_BottomLeftBack - 1].box = {
-			vec3(minX, minY, centerZ),
-			vec3(centerX, centerY, maxZ)
-		};
-
-		children[Octree::S_BottomRightBack - 1].box = {
-			vec3(centerX, minY, centerZ),
-			vec3(maxX, centerY, maxZ)
-		};
-
-		for(Object o : objects) {
-			children[getObjectSector(o.x, o.y, o.z) - 1].objects.push_back(o);
+		std::uint32_t first;
+		if(freeBlocks.empty()) {
+			first = nodes.size();
+			nodes.resize(first + 8);
+		} else {
+			first = freeBlocks.back();
+			freeBlocks.pop_back();
+		}
+
+		// Resizing may have moved the parent.
+		const Node& parent = nodes[index];
+		Real half = parent.halfSize / 2;
+		for(std::uint32_t i = 0; i < 8; i++) {
+			Node& child = nodes[first + i];
+			child.center = parent.center + vec3(i & 1 ? half : -half, i & 2 ? half : -half, i & 4 ? half : -half);
+			child.halfSize = half;
+			child.parent = index;
+			child.firstChild = None;
+			child.depth = parent.depth + 1;
+			child.count = 0;
+			// Recycled blocks keep their lists' memory.
+			child.objects.clear();
 		}
-		objects.clear();
-		objects.size_to_fit();
+		nodes[index].firstChild = first;
 	}
 
-	template <typename T, unsigned Threshold>
-	void Octree<T, Threshold>::Node::add(Object o)
+	void Octree::addToNode(ObjectID object, std::uint32_t index)
 	{
-		if(objects.size() + 1 > Threshold)
-			split();
+		Object& o = objects[object];
+		o.node = index;
+		o.slot = nodes[index].objects.size();
+		nodes[index].objects.push_back(object);
 
-		ObjectSector s = GetObjectSector(o.x, o.y, o.z);
+		for(; index != None; index = nodes[index].parent)
+			nodes[index].count++;
+	}
 
-		if(!s)
-			objects.push_back(o);
-		else
-			children[s - 1].add(o);
+	void Octree::removeFromNode(ObjectID object, std::uint32_t node, std::uint32_t slot)
+	{
+		Vector<ObjectID>& list = nodes[node].objects;
+
+		// Swap with the last object of the node.
+		ObjectID last = list.back();
+		list[slot] = last;
+		if(last != object)
+			objects[last].slot = slot;
+		list.pop_back();
+
+		// A node whose subtree is empty has no children, so freeing one block never leaves others behind.
+		for(std::uint32_t index = node; index != None; index = nodes[index].parent) {
+			Node& n = nodes[index];
+			if(--n.count == 0 && n.firstChild != None) {
+				freeBlocks.push_back(n.firstChild);
+				n.firstChild = None;
+			}
+		}
 	}
 } // namespace SWAN
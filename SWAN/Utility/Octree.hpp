@@ -1,58 +1,241 @@
 #ifndef SWAN_OCTREE_HPP
 #define SWAN_OCTREE_HPP
 
-#include <memory> // For std::unique_ptr<T>
-#include <vector> // For std::vector<T>
+#include <cstdint> // For std::uint32_t
 
-#include "Physics/Basic.hpp" // For SWAN::AABB
+#include "Core/Defs.hpp"      // For SWAN::Vector<T>
+#include "Maths/Vector.hpp"   // For SWAN::vec3, SWAN::Real
+#include "Physics/Basic.hpp"  // For SWAN::AABB, SWAN::Sphere, SWAN::Ray, SWAN::Frustum
 
 namespace SWAN
 {
-	template <typename T, unsigned Threshold>
-	struct Octree {
-		enum ObjectSector {
-			/// Inside the main sector
-			S_Main = 0,
-
-			S_TopLeftFront,
-			S_TopLeftBack,
-			S_TopRightFront,
-			S_TopRightBack,
-
-			S_BottomLeftFront,
-			S_BottomLeftBack,
-			S_BottomRightFront,
-			S_BottomRightBack,
+	/**
+	 * @brief Loose octree of AABBs, for culling and spatial queries.
+	 *
+	 * Every node's bounds are its cell grown by the looseness factor (2 doubles the
+	 * side length), and an object is stored in the deepest node whose loose bounds
+	 * contain its whole box. So objects never straddle nodes, insert() is one walk
+	 * down the tree, and an object that moves a little stays in its node.
+	 *
+	 * Nodes are allocated in blocks of 8 siblings from one array and recycled once
+	 * their subtree is empty. Objects outside the root's bounds are kept in the root.
+	 */
+	class Octree
+	{
+	  public:
+		using ObjectID = std::uint32_t;
+
+		/// ID of an object that doesn't exist.
+		static constexpr ObjectID None = ~ObjectID(0);
+
+		/// A pair of overlapping objects, a < b.
+		struct Pair {
+			ObjectID a, b;
 		};
 
-		struct Node {
-			Node* parent = nullptr;
-			Node* children = nullptr;
-			AABB box;
+		/**
+		 * @param center Center of the root cell.
+		 * @param halfSize Half of the side length of the root cell.
+		 * @param maxDepth How many levels the tree can have below the root.
+		 * @param looseness How much the cells are scaled to get the node bounds, at least 1.
+		 */
+		Octree(vec3 center, double halfSize, unsigned maxDepth = 6, double looseness = 2);
+
+		/// Add an object. @p userData is handed back by getUserData().
+		ObjectID insert(const AABB& box, std::uint32_t userData);
+
+		void remove(ObjectID object);
+
+		/// Update the box of an object. Only relocates it when it leaves its node's bounds or
+		/// fits a deeper node, and then only searches up from its node. Returns true if it was relocated.
+		bool move(ObjectID object, const AABB& box);
+
+		/// Get the user data that was passed to insert().
+		inline std::uint32_t getUserData(ObjectID object) const { return objects[object].userData; }
+
+		/// Get the box of an object.
+		inline const AABB& getAABB(ObjectID object) const { return objects[object].box; }
+
+		/// Call @p callback with the ID of every object whose box overlaps @p box.
+		template <typename Callback>
+		void query(const AABB& box, Callback callback) const
+		{
+			traverse(0, [&](const AABB& bounds) { return bounds.Overlaps(box); },
+			         [&](ObjectID id) {
+				         if(objects[id].box.Overlaps(box))
+					         callback(id);
+			         });
+		}
 
-			struct Object {
-				const T* data;
-				double x, y, z;
+		/// Call @p callback with the ID of every object whose box overlaps @p sphere.
+		template <typename Callback>
+		void query(const Sphere& sphere, Callback callback) const
+		{
+			double r2 = (double) sphere.radius * sphere.radius;
+			traverse(0, [&](const AABB& bounds) { return bounds.DistanceSquared(sphere.center) <= r2; },
+			         [&](ObjectID id) {
+				         if(objects[id].box.DistanceSquared(sphere.center) <= r2)
+					         callback(id);
+			         });
+		}
+
+		/**
+		 * @brief Call @p callback with every object whose box is hit by @p ray within @p maxDistance.
+		 *
+		 * The callback gets the ID and the distance at which the ray enters the box (0 if it starts inside).
+		 * Objects are reported in no particular order.
+		 */
+		template <typename Callback>
+		void query(const Ray& ray, double maxDistance, Callback callback) const
+		{
+			vec3 invDir(1.0 / ray.dir.x, 1.0 / ray.dir.y, 1.0 / ray.dir.z);
+			double t;
+			traverse(0, [&](const AABB& bounds) { return RayHitsAABB(ray.start, invDir, bounds, maxDistance, t); },
+			         [&](ObjectID id) {
+				         if(RayHitsAABB(ray.start, invDir, objects[id].box, maxDistance, t))
+					         callback(id, t);
+			         });
+		}
+
+		/**
+		 * @brief Call @p callback with every object whose box is (at least partly) inside @p frustum.
+		 *
+		 * Nodes completely inside the frustum report all of their objects without testing them,
+		 * and planes a node is completely in front of aren't tested again below it.
+		 */
+		template <typename Callback>
+		void query(const Frustum& frustum, Callback callback) const
+		{
+			struct Entry {
+				std::uint32_t node;
+				unsigned mask;
 			};
-			std::vector<Object> objects;
+			Vector<Entry> stack;
+			stack.push_back({ 0, Frustum::AllPlanes });
+
+			while(!stack.empty()) {
+				Entry e = stack.back();
+				stack.pop_back();
+
+				const Node& node = nodes[e.node];
+				if(node.count == 0)
+					continue;
+				// The root also holds the objects outside of its bounds.
+				if(e.node != 0 && !frustum.Overlaps(looseBounds(node), e.mask))
+					continue;
 
-			~Node();
+				if(e.mask == 0) {
+					forEachInSubtree(e.node, callback);
+					continue;
+				}
 
-			bool isRoot() { return !parent; }
-			bool hasChildren() { return children; }
+				for(ObjectID id : node.objects) {
+					unsigned mask = e.mask;
+					if(frustum.Overlaps(objects[id].box, mask))
+						callback(id);
+				}
+
+				if(node.firstChild != None)
+					for(std::uint32_t i = 0; i < 8; i++)
+						stack.push_back({ node.firstChild + i, e.mask });
+			}
+		}
 
-			ObjectSector getObjectSector(double x, double y, double z);
-			void split();
-			void add(Object o);
+		/// Fills @p out with every pair of objects whose boxes overlap. Each pair is reported once.
+		void queryPairs(Vector<Pair>& out) const;
+
+		/// Number of objects.
+		inline unsigned size() const { return objectCount; }
+
+		/// Number of nodes in use, including the root.
+		inline unsigned getNodeCount() const { return nodes.size() - 8 * freeBlocks.size(); }
+
+	  private:
+		struct Node {
+			/// Center and half side length of the cell, the node's bounds are the cell scaled by the looseness.
+			vec3 center;
+			Real halfSize;
+			std::uint32_t parent;
+			/// Index of the first of the 8 children, which are next to each other. None for leaves.
+			std::uint32_t firstChild;
+			unsigned depth;
+			/// Number of objects in this node and all of its descendants.
+			unsigned count;
+			Vector<ObjectID> objects;
 		};
 
-		void add(const T* data, double x, double y, double z)
+		struct Object {
+			AABB box;
+			/// Index of the node the object is in, and its position in that node's list.
+			std::uint32_t node, slot;
+			std::uint32_t userData;
+		};
+
+		/// Walks the subtree of @p start, skipping nodes whose bounds don't pass @p nodeTest,
+		/// and calls @p callback with the objects of every other node.
+		template <typename NodeTest, typename Callback>
+		void traverse(std::uint32_t start, NodeTest nodeTest, Callback callback) const
+		{
+			Vector<std::uint32_t> stack;
+			stack.push_back(start);
+
+			while(!stack.empty()) {
+				std::uint32_t index = stack.back();
+				stack.pop_back();
+
+				const Node& node = nodes[index];
+				if(node.count == 0)
+					continue;
+				// The root also holds the objects outside of its bounds.
+				if(index != 0 && !nodeTest(looseBounds(node)))
+					continue;
+
+				for(ObjectID id : node.objects)
+					callback(id);
+
+				if(node.firstChild != None)
+					for(std::uint32_t i = 0; i < 8; i++)
+						stack.push_back(node.firstChild + i);
+			}
+		}
+
+		/// Calls @p callback with every object in the subtree of @p index.
+		template <typename Callback>
+		void forEachInSubtree(std::uint32_t index, Callback callback) const
+		{
+			traverse(index, [](const AABB&) { return true; }, callback);
+		}
+
+		inline AABB looseBounds(const Node& node) const
 		{
-			root->add({ data, x, y, z });
+			vec3 half(node.halfSize * looseness);
+			return AABB(node.center - half, node.center + half);
 		}
 
-		std::unique_ptr<Node> root;
+		/// Finds the deepest node that can hold @p box, searching up and then down from @p start.
+		/// Creates the children it needs on the way down.
+		std::uint32_t findNode(std::uint32_t start, const AABB& box);
+
+		/// Creates the 8 children of a leaf.
+		void split(std::uint32_t index);
+
+		void addToNode(ObjectID object, std::uint32_t index);
+		/// Removes the object from @p node's list, and frees the children of nodes left with empty subtrees.
+		/// The node and slot are passed in, since move() has already added the object to its new node.
+		void removeFromNode(ObjectID object, std::uint32_t node, std::uint32_t slot);
+
+		unsigned maxDepth;
+		double looseness;
+
+		/// Nodes, the root is at index 0 and every other node is part of a block of 8 siblings.
+		Vector<Node> nodes;
+		/// First indices of the blocks that aren't in use.
+		Vector<std::uint32_t> freeBlocks;
+
+		Vector<Object> objects;
+		Vector<ObjectID> freeIDs;
+		unsigned objectCount = 0;
 	};
 } // namespace SWAN
 
-#endif // SWAN_OCTREE_HPP
+#endif
@@ -0,0 +1,88 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm> // For std::min(), std::max()
+
+namespace SWAN
+{
+	ThreadPool::ThreadPool(unsigned threadCount) : next(0)
+	{
+		if(threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		workers.reserve(threadCount - 1);
+		for(unsigned i = 1; i < threadCount; i++)
+			workers.emplace_back([this] { workerLoop(); });
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		wake.notify_all();
+
+		for(std::thread& t : workers)
+			t.join();
+	}
+
+	void ThreadPool::run(std::size_t count, std::size_t grainSize, Invoke invoke, void* func)
+	{
+		grainSize = std::max<std::size_t>(grainSize, 1);
+
+		// Not worth waking anyone up for a single chunk.
+		if(workers.empty() || count <= grainSize) {
+			if(count > 0)
+				invoke(func, 0, count);
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			this->invoke = invoke;
+			this->func = func;
+			this->count = count;
+			this->grainSize = grainSize;
+			next = 0;
+			busy = workers.size();
+			generation++;
+		}
+		wake.notify_all();
+
+		work();
+
+		// Every worker has to check in, so none of them still looks at this loop after returning.
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this] { return busy == 0; });
+	}
+
+	void ThreadPool::workerLoop()
+	{
+		std::uint64_t seen = 0;
+		for(;;) {
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				wake.wait(lock, [&] { return quit || generation != seen; });
+				if(quit)
+					return;
+				seen = generation;
+			}
+
+			work();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if(--busy == 0)
+				done.notify_one();
+		}
+	}
+
+	void ThreadPool::work()
+	{
+		for(;;) {
+			std::size_t begin = next.fetch_add(grainSize);
+			if(begin >= count)
+				return;
+			invoke(func, begin, std::min(begin + grainSize, count));
+		}
+	}
+} // namespace SWAN
@@ -0,0 +1,70 @@
+#ifndef SWAN_THREAD_POOL_HPP
+#define SWAN_THREAD_POOL_HPP
+
+#include <atomic>             // For std::atomic<T>
+#include <condition_variable> // For std::condition_variable
+#include <cstddef>            // For std::size_t
+#include <cstdint>            // For std::uint64_t
+#include <mutex>              // For std::mutex
+#include <thread>             // For std::thread
+
+#include "Core/Defs.hpp" // For SWAN::Vector<T>
+
+namespace SWAN
+{
+	/**
+	 * @brief A fixed set of worker threads that split loops between them.
+	 *
+	 * parallelFor() cuts the index range into chunks of grainSize and hands them out
+	 * to the workers and the calling thread until none are left, then returns.
+	 * Which thread runs which chunk isn't fixed, so for deterministic results every
+	 * chunk should only write to its own indices.
+	 */
+	class ThreadPool
+	{
+	  public:
+		/// @param threadCount Threads working on a loop, including the one that calls parallelFor().
+		///                    0 uses one per hardware thread.
+		explicit ThreadPool(unsigned threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/// Threads working on a loop, including the one that calls parallelFor().
+		inline unsigned getThreadCount() const { return workers.size() + 1; }
+
+		/// Calls func(begin, end) for consecutive ranges of at most @p grainSize indices
+		/// until [0, count) is covered, and waits for all of them to finish.
+		template <typename Func>
+		void parallelFor(std::size_t count, std::size_t grainSize, Func func)
+		{
+			run(count, grainSize, [](void* f, std::size_t begin, std::size_t end) { (*static_cast<Func*>(f))(begin, end); }, &func);
+		}
+
+	  private:
+		using Invoke = void (*)(void* func, std::size_t begin, std::size_t end);
+
+		void run(std::size_t count, std::size_t grainSize, Invoke invoke, void* func);
+		void workerLoop();
+
+		/// Runs chunks of the current loop until there are none left.
+		void work();
+
+		Vector<std::thread> workers;
+
+		std::mutex mutex;
+		std::condition_variable wake, done;
+		std::uint64_t generation = 0;
+		unsigned busy = 0;
+		bool quit = false;
+
+		// The current loop.
+		Invoke invoke = nullptr;
+		void* func = nullptr;
+		std::size_t count = 0, grainSize = 1;
+		std::atomic<std::size_t> next;
+	};
+} // namespace SWAN
+
+#endif
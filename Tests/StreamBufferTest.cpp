@@ -0,0 +1,69 @@
+// Checks that a StreamBuffer keeps all the data of one draw in the same storage, by pushing
+// into a small buffer under the recording GL backend (OpenGL/Recorder.hpp), so no window
+// or driver is needed. Returns non-zero if a check fails.
+//
+// Usage: SWAN-StreamBuffer-Test
+
+#include "OpenGL/Recorder.hpp"
+#include "OpenGL/StreamBuffer.hpp"
+
+#include <cstdio> // For std::printf()
+
+using namespace SWAN;
+
+namespace
+{
+	int failures = 0;
+
+	void Check(bool ok, const char* what)
+	{
+		if(!ok) {
+			std::printf("FAILED: %s\n", what);
+			failures++;
+		}
+	}
+} // namespace
+
+int main()
+{
+	GL::CommandLog log;
+	GL::UseRecordingBackend(&log);
+
+	const unsigned char data[128] = {};
+	{
+		GL::StreamBuffer stream(64);
+		stream.push(data, 40);
+		unsigned long allocations = log.count(GL::Command::BufferData);
+
+		// 16 + 32 bytes don't fit after the first 40, so the draw wraps: the buffer must be
+		// orphaned once before its first push, not between its pushes.
+		stream.reserve({ 16, 32 });
+		Check(log.count(GL::Command::BufferData) == allocations + 1, "reserve() orphans a full buffer");
+		GLintptr positions = stream.push(data, 16);
+		GLintptr colors = stream.push(data, 32);
+		Check(log.count(GL::Command::BufferData) == allocations + 1, "pushes after reserve() don't orphan");
+		Check(positions == 0 && colors == 16, "reserved pushes are packed from the start of the new storage");
+
+		// Room is left for this one, so nothing changes.
+		stream.reserve({ 8 });
+		Check(log.count(GL::Command::BufferData) == allocations + 1, "reserve() doesn't orphan when there's room");
+		Check(stream.push(data, 8) == 48, "pushes continue after the last one");
+	}
+	{
+		// 48 + 48 bytes are more than the buffer has, so it grows, once.
+		GL::StreamBuffer stream(64);
+		unsigned long allocations = log.count(GL::Command::BufferData);
+		stream.reserve({ 48, 48 });
+		GLintptr first = stream.push(data, 48);
+		GLintptr second = stream.push(data, 48);
+		Check(log.count(GL::Command::BufferData) == allocations + 1, "a draw bigger than the buffer grows it once");
+		Check(stream.capacity >= 96, "the buffer grows to fit the draw");
+		Check(first == 0 && second == 48, "the draw's pushes share the grown storage");
+	}
+
+	GL::UseRecordingBackend(nullptr);
+
+	if(failures == 0)
+		std::printf("All checks passed\n");
+	return failures == 0 ? 0 : 1;
+}